@@ -0,0 +1,294 @@
+#include <anton/algorithm.hpp>
+
+#include <simd/algorithm.hpp>
+#include <simd/sse2.hpp>
+
+namespace anton::detail {
+#if ANTON_SIMD_X86
+  template<typename T>
+  static i64 find_dispatch(T const* const data, i64 const length,
+                           T const value)
+  {
+    if(simd::cpu_supports_avx2()) {
+      return simd::find_avx2(data, length, value);
+    } else {
+      return simd::find<simd::SSE2>(data, length, value);
+    }
+  }
+
+  template<typename T>
+  static i64 count_dispatch(T const* const data, i64 const length,
+                            T const value)
+  {
+    if(simd::cpu_supports_avx2()) {
+      return simd::count_avx2(data, length, value);
+    } else {
+      return simd::count<simd::SSE2>(data, length, value);
+    }
+  }
+
+  template<typename T>
+  static i64 min_element_dispatch(T const* const data, i64 const length)
+  {
+    if(simd::cpu_supports_avx2()) {
+      return simd::min_element_avx2(data, length);
+    } else {
+      return simd::extreme_element<simd::SSE2, false>(data, length);
+    }
+  }
+
+  template<typename T>
+  static i64 max_element_dispatch(T const* const data, i64 const length)
+  {
+    if(simd::cpu_supports_avx2()) {
+      return simd::max_element_avx2(data, length);
+    } else {
+      return simd::extreme_element<simd::SSE2, true>(data, length);
+    }
+  }
+
+  template<typename T>
+  static i64 set_intersection_dispatch(T const* const first1, i64 const length1,
+                                       T const* const first2, i64 const length2,
+                                       T* const out)
+  {
+    if(simd::cpu_supports_avx2()) {
+      return simd::set_intersection_avx2(first1, length1, first2, length2,
+                                         out);
+    } else {
+      return simd::set_intersection<simd::SSE2>(first1, length1, first2,
+                                                length2, out);
+    }
+  }
+
+  i64 simd_mismatch(void const* const lhs, void const* const rhs,
+                    i64 const size)
+  {
+    u8 const* const l = static_cast<u8 const*>(lhs);
+    u8 const* const r = static_cast<u8 const*>(rhs);
+    if(simd::cpu_supports_avx2()) {
+      return simd::mismatch_avx2(l, r, size);
+    } else {
+      return simd::mismatch<simd::SSE2>(l, r, size);
+    }
+  }
+#else
+  // No vector instruction sets are supported on this architecture. Fall back
+  // to the scalar loops.
+
+  template<typename T>
+  static i64 find_dispatch(T const* const data, i64 const length,
+                           T const value)
+  {
+    return simd::find_scalar(data, 0, length, value);
+  }
+
+  template<typename T>
+  static i64 count_dispatch(T const* const data, i64 const length,
+                            T const value)
+  {
+    i64 result = 0;
+    for(i64 i = 0; i < length; ++i) {
+      result += data[i] == value;
+    }
+    return result;
+  }
+
+  template<typename T>
+  static i64 min_element_dispatch(T const* const data, i64 const length)
+  {
+    i64 result = 0;
+    for(i64 i = 1; i < length; ++i) {
+      if(data[i] < data[result]) {
+        result = i;
+      }
+    }
+    return result;
+  }
+
+  template<typename T>
+  static i64 max_element_dispatch(T const* const data, i64 const length)
+  {
+    i64 result = 0;
+    for(i64 i = 1; i < length; ++i) {
+      if(data[result] < data[i]) {
+        result = i;
+      }
+    }
+    return result;
+  }
+
+  template<typename T>
+  static i64 set_intersection_dispatch(T const* const first1, i64 const length1,
+                                       T const* const first2, i64 const length2,
+                                       T* const out)
+  {
+    i64 i = 0;
+    i64 j = 0;
+    i64 count = 0;
+    simd::set_intersection_scalar(first1, i, length1, first2, j, length2, out,
+                                  count);
+    return count;
+  }
+
+  i64 simd_mismatch(void const* const lhs, void const* const rhs,
+                    i64 const size)
+  {
+    u8 const* const l = static_cast<u8 const*>(lhs);
+    u8 const* const r = static_cast<u8 const*>(rhs);
+    i64 i = 0;
+    while(i < size && l[i] == r[i]) {
+      ++i;
+    }
+    return i;
+  }
+#endif
+
+  i64 simd_find(u8 const* const data, i64 const length, u8 const value)
+  {
+    return find_dispatch(data, length, value);
+  }
+
+  i64 simd_find(u16 const* const data, i64 const length, u16 const value)
+  {
+    return find_dispatch(data, length, value);
+  }
+
+  i64 simd_find(u32 const* const data, i64 const length, u32 const value)
+  {
+    return find_dispatch(data, length, value);
+  }
+
+  i64 simd_find(u64 const* const data, i64 const length, u64 const value)
+  {
+    return find_dispatch(data, length, value);
+  }
+
+  i64 simd_count(u8 const* const data, i64 const length, u8 const value)
+  {
+    return count_dispatch(data, length, value);
+  }
+
+  i64 simd_count(u16 const* const data, i64 const length, u16 const value)
+  {
+    return count_dispatch(data, length, value);
+  }
+
+  i64 simd_count(u32 const* const data, i64 const length, u32 const value)
+  {
+    return count_dispatch(data, length, value);
+  }
+
+  i64 simd_count(u64 const* const data, i64 const length, u64 const value)
+  {
+    return count_dispatch(data, length, value);
+  }
+
+  i64 simd_min_element(i8 const* const data, i64 const length)
+  {
+    return min_element_dispatch(data, length);
+  }
+
+  i64 simd_min_element(i16 const* const data, i64 const length)
+  {
+    return min_element_dispatch(data, length);
+  }
+
+  i64 simd_min_element(i32 const* const data, i64 const length)
+  {
+    return min_element_dispatch(data, length);
+  }
+
+  i64 simd_min_element(i64 const* const data, i64 const length)
+  {
+    return min_element_dispatch(data, length);
+  }
+
+  i64 simd_min_element(u8 const* const data, i64 const length)
+  {
+    return min_element_dispatch(data, length);
+  }
+
+  i64 simd_min_element(u16 const* const data, i64 const length)
+  {
+    return min_element_dispatch(data, length);
+  }
+
+  i64 simd_min_element(u32 const* const data, i64 const length)
+  {
+    return min_element_dispatch(data, length);
+  }
+
+  i64 simd_min_element(u64 const* const data, i64 const length)
+  {
+    return min_element_dispatch(data, length);
+  }
+
+  i64 simd_max_element(i8 const* const data, i64 const length)
+  {
+    return max_element_dispatch(data, length);
+  }
+
+  i64 simd_max_element(i16 const* const data, i64 const length)
+  {
+    return max_element_dispatch(data, length);
+  }
+
+  i64 simd_max_element(i32 const* const data, i64 const length)
+  {
+    return max_element_dispatch(data, length);
+  }
+
+  i64 simd_max_element(i64 const* const data, i64 const length)
+  {
+    return max_element_dispatch(data, length);
+  }
+
+  i64 simd_max_element(u8 const* const data, i64 const length)
+  {
+    return max_element_dispatch(data, length);
+  }
+
+  i64 simd_max_element(u16 const* const data, i64 const length)
+  {
+    return max_element_dispatch(data, length);
+  }
+
+  i64 simd_max_element(u32 const* const data, i64 const length)
+  {
+    return max_element_dispatch(data, length);
+  }
+
+  i64 simd_max_element(u64 const* const data, i64 const length)
+  {
+    return max_element_dispatch(data, length);
+  }
+
+  i64 simd_set_intersection(i32 const* const first1, i64 const length1,
+                            i32 const* const first2, i64 const length2,
+                            i32* const out)
+  {
+    return set_intersection_dispatch(first1, length1, first2, length2, out);
+  }
+
+  i64 simd_set_intersection(i64 const* const first1, i64 const length1,
+                            i64 const* const first2, i64 const length2,
+                            i64* const out)
+  {
+    return set_intersection_dispatch(first1, length1, first2, length2, out);
+  }
+
+  i64 simd_set_intersection(u32 const* const first1, i64 const length1,
+                            u32 const* const first2, i64 const length2,
+                            u32* const out)
+  {
+    return set_intersection_dispatch(first1, length1, first2, length2, out);
+  }
+
+  i64 simd_set_intersection(u64 const* const first1, i64 const length1,
+                            u64 const* const first2, i64 const length2,
+                            u64* const out)
+  {
+    return set_intersection_dispatch(first1, length1, first2, length2, out);
+  }
+} // namespace anton::detail
@@ -23,19 +23,32 @@ namespace anton {
 
   Arena_Allocator::Arena_Allocator(i64 const default_block_size,
                                    i64 const default_block_alignment)
-    : default_block_size(default_block_size),
+    : Arena_Allocator(get_default_allocator(), default_block_size,
+                      default_block_alignment)
+  {
+  }
+
+  Arena_Allocator::Arena_Allocator(Memory_Allocator* const upstream,
+                                   i64 const default_block_size,
+                                   i64 const default_block_alignment)
+    : upstream(upstream), default_block_size(default_block_size),
       default_block_alignment(
         anton::math::max(default_block_alignment, (i64)alignof(Block)))
   {
   }
 
   Arena_Allocator::Arena_Allocator(Arena_Allocator&& allocator)
-    : first(allocator.first), last(allocator.last),
+    : upstream(allocator.upstream), first(allocator.first),
+      last(allocator.last),
       default_block_size(allocator.default_block_size),
-      default_block_alignment(allocator.default_block_alignment)
+      default_block_alignment(allocator.default_block_alignment),
+      owned_memory_amount(allocator.owned_memory_amount)
   {
-    // Move in default-constructed allocator to ensure allocator is usable.
-    allocator = Arena_Allocator();
+    // The blocks now belong to this allocator. Leave allocator empty, but
+    // usable.
+    allocator.first = nullptr;
+    allocator.last = nullptr;
+    allocator.owned_memory_amount = 0;
   }
 
   Arena_Allocator::~Arena_Allocator()
@@ -45,10 +58,12 @@ namespace anton {
 
   Arena_Allocator& Arena_Allocator::operator=(Arena_Allocator&& allocator)
   {
+    anton::swap(upstream, allocator.upstream);
     anton::swap(first, allocator.first);
     anton::swap(last, allocator.last);
     anton::swap(default_block_size, allocator.default_block_size);
     anton::swap(default_block_alignment, allocator.default_block_alignment);
+    anton::swap(owned_memory_amount, allocator.owned_memory_amount);
     return *this;
   }
 
@@ -61,11 +76,13 @@ namespace anton {
     i64 const allocation_size =
       align_address(anton::math::max(size + header, default_block_size),
                     allocation_alignment);
-    void* const memory = anton::allocate(allocation_size, allocation_alignment);
+    void* const memory =
+      upstream->allocate(allocation_size, allocation_alignment);
     Block* const block = reinterpret_cast<Block*>(memory);
     block->next = nullptr;
     block->free = advance(memory, sizeof(Block));
     block->end = advance(memory, allocation_size);
+    block->alignment = allocation_alignment;
     return block;
   }
 
@@ -105,7 +122,8 @@ namespace anton {
   {
     for(Block* block = first; block != nullptr;) {
       Block* const next = block->next;
-      anton::deallocate(block);
+      upstream->deallocate(block, difference(block->end, block),
+                           block->alignment);
       block = next;
     }
 
@@ -121,6 +139,7 @@ namespace anton {
 
   void swap(Arena_Allocator& lhs, Arena_Allocator& rhs)
   {
+    swap(lhs.upstream, rhs.upstream);
     swap(lhs.first, rhs.first);
     swap(lhs.last, rhs.last);
     swap(lhs.default_block_alignment, rhs.default_block_alignment);
@@ -3,6 +3,7 @@
 #include <anton/array.hpp>
 #include <anton/assert.hpp>
 #include <anton/optional.hpp>
+#include <anton/string_builder.hpp>
 
 namespace anton {
   Format_Buffer::Format_Buffer(Memory_Allocator* const allocator)
@@ -10,9 +11,18 @@ namespace anton {
   {
   }
 
+  Format_Buffer::Format_Buffer(String_Builder& builder)
+    : _string(builder.get_allocator()), _builder(&builder)
+  {
+  }
+
   void Format_Buffer::write(String_View string)
   {
-    _string += string;
+    if(_builder != nullptr) {
+      _builder->append(string);
+    } else {
+      _string += string;
+    }
   }
 
   String Format_Buffer::to_string()
@@ -177,6 +187,17 @@ namespace anton {
   detail::format_internal(Memory_Allocator* const allocator,
                           String_View const format_string,
                           Slice<Formatter_Base const* const> const arguments)
+  {
+    Format_Buffer buffer(allocator);
+    format_internal(allocator, buffer, format_string, arguments);
+    return buffer.to_string();
+  }
+
+  void
+  detail::format_internal(Memory_Allocator* const allocator,
+                          Format_Buffer& buffer,
+                          String_View const format_string,
+                          Slice<Formatter_Base const* const> const arguments)
   {
     Array<String_View> string_slices;
     Array<Format_Field> format_fields;
@@ -184,7 +205,6 @@ namespace anton {
       ANTON_FAIL(false, "invalid format string");
     }
 
-    Format_Buffer buffer(allocator);
     auto field = format_fields.begin();
     auto const field_end = format_fields.end();
     auto args = arguments.begin();
@@ -206,7 +226,5 @@ namespace anton {
     if(field != field_end || args != args_end) {
       ANTON_FAIL(false, "incorrect number of arguments");
     }
-
-    return buffer.to_string();
   }
 } // namespace anton
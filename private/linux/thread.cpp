@@ -0,0 +1,73 @@
+#include <anton/thread.hpp>
+
+#include <anton/assert.hpp>
+#include <anton/memory.hpp>
+
+#include <limits.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace anton {
+  namespace {
+    struct Thread_Start {
+      Thread_Function function;
+      void* data;
+    };
+  } // namespace
+
+  static void* thread_trampoline(void* const data)
+  {
+    Thread_Start* const start = static_cast<Thread_Start*>(data);
+    Thread_Start const copy = *start;
+    delete_obj(start);
+    copy.function(copy.data);
+    return nullptr;
+  }
+
+  Thread create_thread(Thread_Function const function, void* const data)
+  {
+    Thread_Start* const start = new_obj<Thread_Start>(function, data);
+    pthread_t handle;
+    int const result =
+      pthread_create(&handle, nullptr, thread_trampoline, start);
+    ANTON_VERIFY(result == 0, "failed to create thread");
+    return Thread{static_cast<u64>(handle)};
+  }
+
+  void join_thread(Thread const thread)
+  {
+    pthread_join(static_cast<pthread_t>(thread.native_handle), nullptr);
+  }
+
+  void yield_thread()
+  {
+    sched_yield();
+  }
+
+  i64 get_hardware_concurrency()
+  {
+    long const count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? count : 1;
+  }
+
+  void wait_on_address(Atomic<i32>& address, i32 const expected)
+  {
+    syscall(SYS_futex, reinterpret_cast<i32*>(&address), FUTEX_WAIT_PRIVATE,
+            expected, nullptr, nullptr, 0);
+  }
+
+  void wake_one_on_address(Atomic<i32>& address)
+  {
+    syscall(SYS_futex, reinterpret_cast<i32*>(&address), FUTEX_WAKE_PRIVATE, 1,
+            nullptr, nullptr, 0);
+  }
+
+  void wake_all_on_address(Atomic<i32>& address)
+  {
+    syscall(SYS_futex, reinterpret_cast<i32*>(&address), FUTEX_WAKE_PRIVATE,
+            INT_MAX, nullptr, nullptr, 0);
+  }
+} // namespace anton
@@ -19,19 +19,28 @@ namespace anton {
 
   void fill_memory(void* first, void* last, char8 value)
   {
-    char8* f = reinterpret_cast<char8*>(first);
-    char8* l = reinterpret_cast<char8*>(last);
-    for(; f != l; ++f) {
-      *f = value;
+    char8* const f = reinterpret_cast<char8*>(first);
+    char8* const l = reinterpret_cast<char8*>(last);
+    if(f != l) {
+      memset(f, static_cast<u8>(value), static_cast<usize>(l - f));
     }
   }
 
   void zero_memory(void* first, void* last)
   {
-    char8* f = reinterpret_cast<char8*>(first);
-    char8* l = reinterpret_cast<char8*>(last);
-    for(; f != l; ++f) {
-      *f = 0;
+    char8* const f = reinterpret_cast<char8*>(first);
+    char8* const l = reinterpret_cast<char8*>(last);
+    if(f != l) {
+      memset(f, 0, static_cast<usize>(l - f));
+    }
+  }
+
+  void copy_memory(void const* first, void const* last, void* destination)
+  {
+    char8 const* const f = reinterpret_cast<char8 const*>(first);
+    char8 const* const l = reinterpret_cast<char8 const*>(last);
+    if(f != l) {
+      memcpy(destination, f, static_cast<usize>(l - f));
     }
   }
 } // namespace anton
@@ -0,0 +1,380 @@
+#include <anton/multi_pattern_matcher.hpp>
+
+#include <anton/assert.hpp>
+#include <anton/detail/crt.hpp>
+#include <anton/sort.hpp>
+#include <simd/string.hpp>
+
+namespace anton {
+  // The largest set of patterns searched with Teddy.
+  constexpr i64 teddy_max_pattern_count = 32;
+  constexpr i64 teddy_bucket_count = 8;
+  constexpr i64 teddy_max_fingerprint_size = 3;
+  // Flags the transitions into states in which an occurrence ends.
+  constexpr u32 output_flag = 0x80000000;
+  // Marks the transitions not created yet while the trie is built.
+  constexpr u32 no_transition = 0xFFFFFFFF;
+
+  Multi_Pattern_Matcher::Multi_Pattern_Matcher(): _bytes(), _offsets()
+  {
+    _offsets.push_back(0);
+  }
+
+  Multi_Pattern_Matcher::Multi_Pattern_Matcher(
+    allocator_type const& allocator)
+    : _bytes(allocator), _offsets(allocator), _transitions(allocator),
+      _state_pattern(allocator), _output_link(allocator),
+      _next_equal(allocator)
+  {
+    _offsets.push_back(0);
+  }
+
+  Multi_Pattern_Matcher::Multi_Pattern_Matcher(
+    Slice<String_View const> const patterns)
+    : Multi_Pattern_Matcher()
+  {
+    build(patterns);
+  }
+
+  Multi_Pattern_Matcher::Multi_Pattern_Matcher(
+    allocator_type const& allocator, Slice<String_View const> const patterns)
+    : Multi_Pattern_Matcher(allocator)
+  {
+    build(patterns);
+  }
+
+  void Multi_Pattern_Matcher::build(Slice<String_View const> const patterns)
+  {
+    i64 total_size = 0;
+    for(String_View const pattern: patterns) {
+      ANTON_ASSERT(pattern.size_bytes() > 0, u8"pattern must not be empty");
+      total_size += pattern.size_bytes();
+    }
+
+    _bytes.ensure_capacity(total_size);
+    _offsets.ensure_capacity(patterns.size() + 1);
+    for(String_View const pattern: patterns) {
+      i64 const size = pattern.size_bytes();
+      i64 const offset = _bytes.size();
+      _bytes.force_size(offset + size);
+      memcpy(_bytes.data() + offset, pattern.data(), size);
+      _offsets.push_back(offset + size);
+      if(size > _max_pattern_size) {
+        _max_pattern_size = size;
+      }
+    }
+
+#if ANTON_SIMD_X86
+    if(patterns.size() > 0 && patterns.size() <= teddy_max_pattern_count &&
+       simd::cpu_supports_avx2()) {
+      build_teddy();
+      return;
+    }
+#endif
+    build_automaton();
+  }
+
+  void Multi_Pattern_Matcher::build_teddy()
+  {
+    _teddy = true;
+    _fingerprint_size = teddy_max_fingerprint_size;
+    for(i64 i = 0; i < get_pattern_count(); ++i) {
+      i64 const size = _offsets[i + 1] - _offsets[i];
+      if(size < _fingerprint_size) {
+        _fingerprint_size = size;
+      }
+    }
+
+    for(i64 i = 0; i < get_pattern_count(); ++i) {
+      u8 const bucket = static_cast<u8>(1 << (i % teddy_bucket_count));
+      for(i64 f = 0; f < _fingerprint_size; ++f) {
+        u8 const byte = static_cast<u8>(_bytes[_offsets[i] + f]);
+        _teddy_masks[32 * f + (byte & 0x0F)] |= bucket;
+        _teddy_masks[32 * f + 16 + (byte >> 4)] |= bucket;
+      }
+    }
+  }
+
+  void Multi_Pattern_Matcher::build_automaton()
+  {
+    // Assign a class to every byte that occurs in the patterns and a common
+    // class to all the remaining bytes. There are at most 256 classes.
+    bool used[256] = {};
+    for(char8 const byte: _bytes) {
+      used[static_cast<u8>(byte)] = true;
+    }
+
+    i64 class_count = 0;
+    for(i64 byte = 0; byte < 256; ++byte) {
+      if(used[byte]) {
+        _classes[byte] = static_cast<u8>(class_count);
+        class_count += 1;
+      }
+    }
+
+    if(class_count < 256) {
+      for(i64 byte = 0; byte < 256; ++byte) {
+        if(!used[byte]) {
+          _classes[byte] = static_cast<u8>(class_count);
+        }
+      }
+      class_count += 1;
+    }
+    _class_count = class_count;
+
+    // Build the trie of the patterns. The transitions hold the indices of the
+    // states until the automaton is complete.
+    auto add_state = [this]() -> i32 {
+      i64 const state = _state_pattern.size();
+      ANTON_ASSERT((state + 1) * _class_count < static_cast<i64>(output_flag),
+                   u8"too many states in the automaton");
+      _transitions.force_size((state + 1) * _class_count);
+      for(i64 c = 0; c < _class_count; ++c) {
+        _transitions[state * _class_count + c] = no_transition;
+      }
+      _state_pattern.push_back(-1);
+      _output_link.push_back(0);
+      return static_cast<i32>(state);
+    };
+
+    i64 const pattern_count = get_pattern_count();
+    _transitions.ensure_capacity((_bytes.size() + 1) * _class_count);
+    _state_pattern.ensure_capacity(_bytes.size() + 1);
+    _output_link.ensure_capacity(_bytes.size() + 1);
+    _next_equal.ensure_capacity(pattern_count);
+    add_state();
+    for(i64 i = 0; i < pattern_count; ++i) {
+      i64 state = 0;
+      for(i64 j = _offsets[i]; j < _offsets[i + 1]; ++j) {
+        i64 const entry =
+          state * _class_count + _classes[static_cast<u8>(_bytes[j])];
+        if(_transitions[entry] == no_transition) {
+          i32 const next = add_state();
+          _transitions[entry] = static_cast<u32>(next);
+        }
+        state = _transitions[entry];
+      }
+
+      // Keep the equal patterns chained in the order of their indices.
+      _next_equal.push_back(-1);
+      if(_state_pattern[state] == -1) {
+        _state_pattern[state] = static_cast<i32>(i);
+      } else {
+        i32 last = _state_pattern[state];
+        while(_next_equal[last] != -1) {
+          last = _next_equal[last];
+        }
+        _next_equal[last] = static_cast<i32>(i);
+      }
+    }
+
+    // Complete the automaton in breadth-first order so that the transitions
+    // of the failure state of every state are complete before the state is
+    // visited. The transitions missing from the trie are taken from the
+    // failure state.
+    i64 const state_count = _state_pattern.size();
+    Array<i32> failure{reserve, state_count};
+    failure.force_size(state_count);
+    Array<i32> queue{reserve, state_count};
+    failure[0] = 0;
+    queue.push_back(0);
+    for(i64 head = 0; head < queue.size(); ++head) {
+      i32 const state = queue[head];
+      i32 const state_failure = failure[state];
+      for(i64 c = 0; c < _class_count; ++c) {
+        u32& transition = _transitions[state * _class_count + c];
+        u32 const fallback = _transitions[state_failure * _class_count + c];
+        if(transition == no_transition) {
+          transition = state == 0 ? 0 : fallback;
+          continue;
+        }
+
+        i32 const next = static_cast<i32>(transition);
+        i32 const next_failure = state == 0 ? 0 : static_cast<i32>(fallback);
+        failure[next] = next_failure;
+        _output_link[next] = _state_pattern[next_failure] != -1
+                               ? next_failure
+                               : _output_link[next_failure];
+        queue.push_back(next);
+      }
+    }
+
+    for(u32& transition: _transitions) {
+      bool const output =
+        _state_pattern[transition] != -1 || _output_link[transition] != 0;
+      transition = static_cast<u32>(transition * _class_count) |
+                   (output ? output_flag : 0);
+    }
+  }
+
+  // The searches report the occurrences to callback which returns the end of
+  // the range of positions at which the occurrences are still of interest.
+
+  template<typename Callback>
+  void Multi_Pattern_Matcher::search_teddy(String_View const string,
+                                           Callback& callback) const
+  {
+    char8 const* const data = string.data();
+    i64 const size = string.size_bytes();
+    i64 const pattern_count = get_pattern_count();
+    i64 limit = size;
+    // Reports the occurrences of the patterns of buckets at position. The
+    // occurrences at the same position are not ordered by pattern index.
+    auto verify = [&](i64 const position, u32 buckets) {
+      for(; buckets != 0; buckets &= buckets - 1) {
+        for(i64 i = simd::count_trailing_zeros(buckets); i < pattern_count;
+            i += teddy_bucket_count) {
+          char8 const* const pattern = _bytes.data() + _offsets[i];
+          i64 const pattern_size = _offsets[i + 1] - _offsets[i];
+          if(position + pattern_size <= size &&
+             data[position] == pattern[0] &&
+             memcmp(data + position, pattern, pattern_size) == 0) {
+            limit = callback(Pattern_Match{i, position});
+          }
+        }
+      }
+    };
+
+    i64 i = 0;
+#if ANTON_SIMD_X86
+    simd::Teddy_Candidates candidates;
+    while(i < limit) {
+      i = simd::find_teddy_candidates_avx2(_teddy_masks, _fingerprint_size,
+                                           data, size, i, candidates);
+      for(i64 k = 0; k < candidates.count; ++k) {
+        if(candidates.positions[k] >= limit) {
+          break;
+        }
+
+        verify(candidates.positions[k], candidates.buckets[k]);
+      }
+
+      if(i + _fingerprint_size - 1 + 32 > size) {
+        break;
+      }
+    }
+#endif
+
+    // The fingerprints of the remaining positions do not fit in a block.
+    for(; i < limit; ++i) {
+      verify(i, 0xFF);
+    }
+  }
+
+  template<typename Callback>
+  void Multi_Pattern_Matcher::search_automaton(String_View const string,
+                                               Callback& callback) const
+  {
+    u8 const* const data = reinterpret_cast<u8 const*>(string.data());
+    i64 const size = string.size_bytes();
+    u32 const* const transitions = _transitions.data();
+    i64 limit = size;
+    u32 state = 0;
+    // An occurrence that ends at i begins at i - _max_pattern_size + 1 at the
+    // earliest.
+    for(i64 i = 0; i < size && i - _max_pattern_size + 1 < limit; ++i) {
+      u32 const transition = transitions[state + _classes[data[i]]];
+      state = transition & ~output_flag;
+      if(!(transition & output_flag)) {
+        continue;
+      }
+
+      i32 s = static_cast<i32>(state / _class_count);
+      if(_state_pattern[s] == -1) {
+        s = _output_link[s];
+      }
+
+      for(; s != 0; s = _output_link[s]) {
+        for(i32 p = _state_pattern[s]; p != -1; p = _next_equal[p]) {
+          i64 const pattern_size = _offsets[p + 1] - _offsets[p];
+          limit = callback(Pattern_Match{p, i - pattern_size + 1});
+        }
+      }
+    }
+  }
+
+  i64 Multi_Pattern_Matcher::get_pattern_count() const
+  {
+    return _offsets.size() - 1;
+  }
+
+  String_View Multi_Pattern_Matcher::get_pattern(i64 const index) const
+  {
+    ANTON_ASSERT(index >= 0 && index < get_pattern_count(),
+                 u8"index out of bounds");
+    return String_View{_bytes.data() + _offsets[index],
+                       _bytes.data() + _offsets[index + 1]};
+  }
+
+  Optional<Pattern_Match>
+  Multi_Pattern_Matcher::find_first(String_View const string) const
+  {
+    if(get_pattern_count() == 0) {
+      return null_optional;
+    }
+
+    Pattern_Match best{-1, string.size_bytes()};
+    auto callback = [&best](Pattern_Match const match) -> i64 {
+      if(match.position < best.position ||
+         (match.position == best.position && match.pattern < best.pattern)) {
+        best = match;
+      }
+      // Only the occurrences beginning at the same position or earlier may
+      // precede the best one.
+      return best.position + 1;
+    };
+
+    if(_teddy) {
+      search_teddy(string, callback);
+    } else {
+      search_automaton(string, callback);
+    }
+
+    if(best.pattern != -1) {
+      return best;
+    } else {
+      return null_optional;
+    }
+  }
+
+  Array<Pattern_Match>
+  Multi_Pattern_Matcher::find_all(String_View const string) const
+  {
+    Array<Pattern_Match> matches(get_allocator());
+    if(get_pattern_count() == 0) {
+      return matches;
+    }
+
+    i64 const size = string.size_bytes();
+    auto callback = [&matches, size](Pattern_Match const match) -> i64 {
+      matches.push_back(match);
+      return size;
+    };
+
+    if(_teddy) {
+      search_teddy(string, callback);
+    } else {
+      search_automaton(string, callback);
+    }
+
+    // Teddy reports the occurrences in the order of their positions and the
+    // automaton in the order of their ends.
+    quick_sort(matches.begin(), matches.end(),
+               [](Pattern_Match const& lhs, Pattern_Match const& rhs) {
+                 return lhs.position < rhs.position ||
+                        (lhs.position == rhs.position &&
+                         lhs.pattern < rhs.pattern);
+               });
+    return matches;
+  }
+
+  auto Multi_Pattern_Matcher::get_allocator() -> allocator_type&
+  {
+    return _bytes.get_allocator();
+  }
+
+  auto Multi_Pattern_Matcher::get_allocator() const -> allocator_type const&
+  {
+    return _bytes.get_allocator();
+  }
+} // namespace anton
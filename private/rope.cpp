@@ -0,0 +1,830 @@
+#include <anton/rope.hpp>
+
+#include <anton/algorithm.hpp>
+#include <anton/assert.hpp>
+#include <anton/detail/crt.hpp>
+#include <anton/swap.hpp>
+#include <anton/unicode/common.hpp>
+
+namespace anton::detail {
+  // Rope_Node
+  // A leaf holding a chunk of the text or an internal node joining two
+  // subtrees. The counts describe the whole subtree.
+  //
+  struct Rope_Node {
+    // Both children are null in leaves.
+    Rope_Node* left;
+    Rope_Node* right;
+    // 0 for leaves.
+    i64 height;
+    i64 bytes;
+    i64 code_points;
+    i64 newlines;
+    // The number of bytes the leaf may hold. The bytes follow the node.
+    i64 capacity;
+  };
+} // namespace anton::detail
+
+namespace anton {
+  using detail::Rope_Node;
+
+  namespace {
+    struct Metrics {
+      i64 bytes;
+      i64 code_points;
+      i64 newlines;
+    };
+
+    [[nodiscard]] Metrics measure(char8 const* const data, i64 const size)
+    {
+      return Metrics{
+        size, unicode::get_utf32_length_from_utf8(data, size),
+        detail::simd_count(reinterpret_cast<u8 const*>(data), size, u8'\n')};
+    }
+
+    [[nodiscard]] bool is_leaf(Rope_Node const* const node)
+    {
+      return node->left == nullptr;
+    }
+
+    [[nodiscard]] char8* leaf_data(Rope_Node* const node)
+    {
+      return reinterpret_cast<char8*>(node + 1);
+    }
+
+    [[nodiscard]] char8 const* leaf_data(Rope_Node const* const node)
+    {
+      return reinterpret_cast<char8 const*>(node + 1);
+    }
+
+    // leaf_capacity
+    // Leaves are allocated in steps of 64 bytes, so that small ropes remain
+    // small, while typing into a leaf rarely reallocates it.
+    //
+    [[nodiscard]] i64 leaf_capacity(i64 const size)
+    {
+      i64 const capacity = (size + 63) & ~static_cast<i64>(63);
+      return capacity < Rope::max_chunk_size ? capacity : Rope::max_chunk_size;
+    }
+
+    [[nodiscard]] Rope_Node* allocate_leaf(Polymorphic_Allocator& allocator,
+                                           i64 const capacity)
+    {
+      void* const memory =
+        allocator.allocate(static_cast<i64>(sizeof(Rope_Node)) + capacity,
+                           alignof(Rope_Node));
+      Rope_Node* const node = static_cast<Rope_Node*>(memory);
+      node->left = nullptr;
+      node->right = nullptr;
+      node->height = 0;
+      node->capacity = capacity;
+      return node;
+    }
+
+    void deallocate_node(Polymorphic_Allocator& allocator,
+                         Rope_Node* const node)
+    {
+      i64 size = sizeof(Rope_Node);
+      if(is_leaf(node)) {
+        size += node->capacity;
+      }
+      allocator.deallocate(node, size, alignof(Rope_Node));
+    }
+
+    void destroy_tree(Polymorphic_Allocator& allocator, Rope_Node* const node)
+    {
+      if(node == nullptr) {
+        return;
+      }
+
+      if(!is_leaf(node)) {
+        destroy_tree(allocator, node->left);
+        destroy_tree(allocator, node->right);
+      }
+      deallocate_node(allocator, node);
+    }
+
+    [[nodiscard]] Rope_Node* create_leaf(Polymorphic_Allocator& allocator,
+                                         char8 const* const data,
+                                         i64 const size, Metrics const metrics)
+    {
+      Rope_Node* const leaf = allocate_leaf(allocator, leaf_capacity(size));
+      memcpy(leaf_data(leaf), data, size);
+      leaf->bytes = metrics.bytes;
+      leaf->code_points = metrics.code_points;
+      leaf->newlines = metrics.newlines;
+      return leaf;
+    }
+
+    void update(Rope_Node* const node)
+    {
+      Rope_Node const* const left = node->left;
+      Rope_Node const* const right = node->right;
+      node->height =
+        1 + (left->height > right->height ? left->height : right->height);
+      node->bytes = left->bytes + right->bytes;
+      node->code_points = left->code_points + right->code_points;
+      node->newlines = left->newlines + right->newlines;
+    }
+
+    [[nodiscard]] Rope_Node* create_internal(Polymorphic_Allocator& allocator,
+                                             Rope_Node* const left,
+                                             Rope_Node* const right)
+    {
+      Rope_Node* const node = static_cast<Rope_Node*>(
+        allocator.allocate(sizeof(Rope_Node), alignof(Rope_Node)));
+      node->left = left;
+      node->right = right;
+      node->capacity = 0;
+      update(node);
+      return node;
+    }
+
+    [[nodiscard]] Rope_Node* rotate_left(Rope_Node* const node)
+    {
+      Rope_Node* const right = node->right;
+      node->right = right->left;
+      update(node);
+      right->left = node;
+      update(right);
+      return right;
+    }
+
+    [[nodiscard]] Rope_Node* rotate_right(Rope_Node* const node)
+    {
+      Rope_Node* const left = node->left;
+      node->left = left->right;
+      update(node);
+      left->right = node;
+      update(left);
+      return left;
+    }
+
+    // rebalance
+    // Restores the AVL invariant of a node whose subtrees differ in height by
+    // at most 2.
+    //
+    [[nodiscard]] Rope_Node* rebalance(Rope_Node* const node)
+    {
+      i64 const balance = node->left->height - node->right->height;
+      if(balance > 1) {
+        if(node->left->left->height < node->left->right->height) {
+          node->left = rotate_left(node->left);
+        }
+        return rotate_right(node);
+      } else if(balance < -1) {
+        if(node->right->right->height < node->right->left->height) {
+          node->right = rotate_right(node->right);
+        }
+        return rotate_left(node);
+      } else {
+        return node;
+      }
+    }
+
+    // join
+    // Concatenates two trees. Takes time proportional to the difference of
+    // their heights.
+    //
+    [[nodiscard]] Rope_Node* join(Polymorphic_Allocator& allocator,
+                                  Rope_Node* const left,
+                                  Rope_Node* const right)
+    {
+      if(left == nullptr) {
+        return right;
+      }
+
+      if(right == nullptr) {
+        return left;
+      }
+
+      if(left->height > right->height + 1) {
+        left->right = join(allocator, left->right, right);
+        update(left);
+        return rebalance(left);
+      } else if(right->height > left->height + 1) {
+        right->left = join(allocator, left, right->left);
+        update(right);
+        return rebalance(right);
+      } else {
+        return create_internal(allocator, left, right);
+      }
+    }
+
+    // split
+    // Splits a tree into the trees of the bytes [0, offset[ and
+    // [offset, node->bytes[.
+    //
+    void split(Polymorphic_Allocator& allocator, Rope_Node* const node,
+               i64 const offset, Rope_Node*& left, Rope_Node*& right)
+    {
+      if(offset == 0) {
+        left = nullptr;
+        right = node;
+        return;
+      }
+
+      if(offset == node->bytes) {
+        left = node;
+        right = nullptr;
+        return;
+      }
+
+      if(is_leaf(node)) {
+        char8 const* const data = leaf_data(node) + offset;
+        i64 const size = node->bytes - offset;
+        right = create_leaf(allocator, data, size, measure(data, size));
+        node->bytes = offset;
+        node->code_points -= right->code_points;
+        node->newlines -= right->newlines;
+        left = node;
+        return;
+      }
+
+      Rope_Node* const node_left = node->left;
+      Rope_Node* const node_right = node->right;
+      deallocate_node(allocator, node);
+      Rope_Node* middle;
+      if(offset <= node_left->bytes) {
+        split(allocator, node_left, offset, left, middle);
+        right = join(allocator, middle, node_right);
+      } else {
+        split(allocator, node_right, offset - node_left->bytes, middle, right);
+        left = join(allocator, node_left, middle);
+      }
+    }
+
+    // build
+    // Builds a tree of the bytes [data, data + size[ divided into chunks at
+    // code point boundaries.
+    //
+    [[nodiscard]] Rope_Node* build(Polymorphic_Allocator& allocator,
+                                   char8 const* const data, i64 const size)
+    {
+      if(size <= Rope::max_chunk_size) {
+        return create_leaf(allocator, data, size, measure(data, size));
+      }
+
+      i64 middle = size / 2;
+      while((data[middle] & 0xC0) == 0x80) {
+        middle -= 1;
+      }
+
+      Rope_Node* const left = build(allocator, data, middle);
+      Rope_Node* const right = build(allocator, data + middle, size - middle);
+      return join(allocator, left, right);
+    }
+
+    [[nodiscard]] Rope_Node* clone(Polymorphic_Allocator& allocator,
+                                   Rope_Node const* const node)
+    {
+      if(is_leaf(node)) {
+        Rope_Node* const leaf = allocate_leaf(allocator, node->capacity);
+        memcpy(leaf_data(leaf), leaf_data(node), node->bytes);
+        leaf->bytes = node->bytes;
+        leaf->code_points = node->code_points;
+        leaf->newlines = node->newlines;
+        return leaf;
+      }
+
+      Rope_Node* const left = clone(allocator, node->left);
+      Rope_Node* const right = clone(allocator, node->right);
+      return create_internal(allocator, left, right);
+    }
+
+    // find_leaf
+    // Finds the leaf containing the byte at offset or the last leaf if offset
+    // is the end of the tree.
+    //
+    [[nodiscard]] Rope_Node const* find_leaf(Rope_Node const* node,
+                                             i64& offset)
+    {
+      while(!is_leaf(node)) {
+        if(offset < node->left->bytes) {
+          node = node->left;
+        } else {
+          offset -= node->left->bytes;
+          node = node->right;
+        }
+      }
+      return node;
+    }
+
+    [[nodiscard]] Rope_Node const* leftmost_leaf(Rope_Node const* node)
+    {
+      while(!is_leaf(node)) {
+        node = node->left;
+      }
+      return node;
+    }
+
+    [[nodiscard]] Rope_Node const* rightmost_leaf(Rope_Node const* node)
+    {
+      while(!is_leaf(node)) {
+        node = node->right;
+      }
+      return node;
+    }
+
+    // insert_into_leaf
+    // Inserts the bytes into the leaf containing offset if the leaf has room
+    // for them.
+    //
+    // Returns:
+    // The node replacing node. inserted is set to true if the bytes have
+    // been inserted.
+    //
+    [[nodiscard]] Rope_Node*
+    insert_into_leaf(Polymorphic_Allocator& allocator, Rope_Node* const node,
+                     i64 const offset, char8 const* const data,
+                     Metrics const metrics, bool& inserted)
+    {
+      if(!is_leaf(node)) {
+        if(offset <= node->left->bytes) {
+          node->left = insert_into_leaf(allocator, node->left, offset, data,
+                                        metrics, inserted);
+        } else {
+          node->right =
+            insert_into_leaf(allocator, node->right, offset - node->left->bytes,
+                             data, metrics, inserted);
+        }
+
+        if(inserted) {
+          update(node);
+        }
+        return node;
+      }
+
+      i64 const size = node->bytes + metrics.bytes;
+      if(size > Rope::max_chunk_size) {
+        return node;
+      }
+
+      Rope_Node* leaf = node;
+      if(size > node->capacity) {
+        leaf = allocate_leaf(allocator, leaf_capacity(size));
+        memcpy(leaf_data(leaf), leaf_data(node), offset);
+        memcpy(leaf_data(leaf) + offset + metrics.bytes,
+               leaf_data(node) + offset, node->bytes - offset);
+        leaf->bytes = node->bytes;
+        leaf->code_points = node->code_points;
+        leaf->newlines = node->newlines;
+        deallocate_node(allocator, node);
+      } else {
+        memmove(leaf_data(leaf) + offset + metrics.bytes,
+                leaf_data(leaf) + offset, leaf->bytes - offset);
+      }
+
+      memcpy(leaf_data(leaf) + offset, data, metrics.bytes);
+      leaf->bytes += metrics.bytes;
+      leaf->code_points += metrics.code_points;
+      leaf->newlines += metrics.newlines;
+      inserted = true;
+      return leaf;
+    }
+
+    // erase_in_leaf
+    // Erases the bytes [first, last[ if they belong to one leaf which does not
+    // become empty.
+    //
+    void erase_in_leaf(Rope_Node* const node, i64 const first, i64 const last,
+                       bool& erased)
+    {
+      if(!is_leaf(node)) {
+        i64 const left_bytes = node->left->bytes;
+        if(last <= left_bytes) {
+          erase_in_leaf(node->left, first, last, erased);
+        } else if(first >= left_bytes) {
+          erase_in_leaf(node->right, first - left_bytes, last - left_bytes,
+                        erased);
+        }
+
+        if(erased) {
+          update(node);
+        }
+        return;
+      }
+
+      if(first == 0 && last == node->bytes) {
+        return;
+      }
+
+      char8* const data = leaf_data(node);
+      Metrics const metrics = measure(data + first, last - first);
+      memmove(data + first, data + last, node->bytes - last);
+      node->bytes -= metrics.bytes;
+      node->code_points -= metrics.code_points;
+      node->newlines -= metrics.newlines;
+      erased = true;
+    }
+
+    // remove_first_leaf
+    //
+    // Returns:
+    // The tree without its first leaf, which is written to leaf.
+    //
+    [[nodiscard]] Rope_Node* remove_first_leaf(Polymorphic_Allocator& allocator,
+                                               Rope_Node* const node,
+                                               Rope_Node*& leaf)
+    {
+      if(is_leaf(node)) {
+        leaf = node;
+        return nullptr;
+      }
+
+      Rope_Node* const left = remove_first_leaf(allocator, node->left, leaf);
+      if(left == nullptr) {
+        Rope_Node* const right = node->right;
+        deallocate_node(allocator, node);
+        return right;
+      }
+
+      node->left = left;
+      update(node);
+      return rebalance(node);
+    }
+
+    // append_to_last_leaf
+    // Appends the bytes to the last leaf of the tree. The leaf must have room
+    // for them.
+    //
+    // Returns:
+    // The node replacing node.
+    //
+    [[nodiscard]] Rope_Node*
+    append_to_last_leaf(Polymorphic_Allocator& allocator, Rope_Node* const node,
+                        char8 const* const data, Metrics const metrics)
+    {
+      if(is_leaf(node)) {
+        bool inserted = false;
+        return insert_into_leaf(allocator, node, node->bytes, data, metrics,
+                                inserted);
+      }
+
+      node->right =
+        append_to_last_leaf(allocator, node->right, data, metrics);
+      update(node);
+      return node;
+    }
+
+    // concat
+    // Joins two trees merging the adjacent leaves if they fit in one leaf,
+    // so that repeated edits do not fragment the text into tiny leaves.
+    //
+    [[nodiscard]] Rope_Node* concat(Polymorphic_Allocator& allocator,
+                                    Rope_Node* left, Rope_Node* right)
+    {
+      if(left == nullptr) {
+        return right;
+      }
+
+      if(right == nullptr) {
+        return left;
+      }
+
+      if(rightmost_leaf(left)->bytes + leftmost_leaf(right)->bytes <=
+         Rope::max_chunk_size) {
+        Rope_Node* leaf;
+        right = remove_first_leaf(allocator, right, leaf);
+        Metrics const metrics{leaf->bytes, leaf->code_points, leaf->newlines};
+        left = append_to_last_leaf(allocator, left, leaf_data(leaf), metrics);
+        deallocate_node(allocator, leaf);
+      }
+      return join(allocator, left, right);
+    }
+
+    [[maybe_unused, nodiscard]] bool
+    is_code_point_boundary(Rope_Node const* const root, i64 offset)
+    {
+      if(root == nullptr || offset == root->bytes) {
+        return true;
+      }
+
+      Rope_Node const* const leaf = find_leaf(root, offset);
+      return (leaf_data(leaf)[offset] & 0xC0) != 0x80;
+    }
+  } // namespace
+
+  Rope_Chunk_Iterator::Rope_Chunk_Iterator(Rope_Node const* const root,
+                                           Rope_Node const* const leaf,
+                                           i64 const offset)
+    : _root(root), _leaf(leaf), _offset(offset)
+  {
+  }
+
+  Rope_Chunk_Iterator& Rope_Chunk_Iterator::operator++()
+  {
+    _offset += _leaf->bytes;
+    if(_offset == _root->bytes) {
+      _leaf = nullptr;
+    } else {
+      i64 offset = _offset;
+      _leaf = find_leaf(_root, offset);
+    }
+    return *this;
+  }
+
+  Rope_Chunk_Iterator Rope_Chunk_Iterator::operator++(int)
+  {
+    Rope_Chunk_Iterator copy = *this;
+    ++(*this);
+    return copy;
+  }
+
+  String_View Rope_Chunk_Iterator::operator*() const
+  {
+    ANTON_ASSERT(_leaf != nullptr, u8"dereferencing end iterator");
+    char8 const* const data = leaf_data(_leaf);
+    return String_View{data, data + _leaf->bytes};
+  }
+
+  i64 Rope_Chunk_Iterator::get_offset() const
+  {
+    return _offset;
+  }
+
+  Rope::Rope(): _allocator() {}
+
+  Rope::Rope(allocator_type const& allocator): _allocator(allocator) {}
+
+  Rope::Rope(String_View const string): Rope(allocator_type(), string) {}
+
+  Rope::Rope(allocator_type const& allocator, String_View const string)
+    : _allocator(allocator)
+  {
+    if(string.size_bytes() > 0) {
+      _root = build(_allocator, string.data(), string.size_bytes());
+    }
+  }
+
+  Rope::Rope(Rope const& other): _allocator(other._allocator)
+  {
+    if(other._root != nullptr) {
+      _root = clone(_allocator, other._root);
+    }
+  }
+
+  Rope::Rope(Rope&& other)
+    : _allocator(ANTON_MOV(other._allocator)), _root(other._root)
+  {
+    other._root = nullptr;
+  }
+
+  Rope::~Rope()
+  {
+    destroy_tree(_allocator, _root);
+  }
+
+  Rope& Rope::operator=(Rope const& other)
+  {
+    if(this != &other) {
+      destroy_tree(_allocator, _root);
+      _root = nullptr;
+      if(other._root != nullptr) {
+        _root = clone(_allocator, other._root);
+      }
+    }
+    return *this;
+  }
+
+  Rope& Rope::operator=(Rope&& other)
+  {
+    swap(*this, other);
+    return *this;
+  }
+
+  auto Rope::get_allocator() -> allocator_type&
+  {
+    return _allocator;
+  }
+
+  auto Rope::get_allocator() const -> allocator_type const&
+  {
+    return _allocator;
+  }
+
+  auto Rope::size_bytes() const -> size_type
+  {
+    return _root != nullptr ? _root->bytes : 0;
+  }
+
+  auto Rope::size_utf8() const -> size_type
+  {
+    return _root != nullptr ? _root->code_points : 0;
+  }
+
+  auto Rope::line_count() const -> size_type
+  {
+    return (_root != nullptr ? _root->newlines : 0) + 1;
+  }
+
+  Range<Rope_Chunk_Iterator> Rope::chunks() const
+  {
+    if(_root == nullptr) {
+      return Range(Rope_Chunk_Iterator(), Rope_Chunk_Iterator());
+    }
+
+    return Range(Rope_Chunk_Iterator(_root, leftmost_leaf(_root), 0),
+                 Rope_Chunk_Iterator());
+  }
+
+  void Rope::insert(i64 const offset, String_View const string)
+  {
+    ANTON_ASSERT(offset >= 0 && offset <= size_bytes(),
+                 u8"offset out of bounds");
+    ANTON_ASSERT(is_code_point_boundary(_root, offset),
+                 u8"offset is not a code point boundary");
+    char8 const* const data = string.data();
+    i64 const size = string.size_bytes();
+    if(size == 0) {
+      return;
+    }
+
+    if(_root == nullptr) {
+      _root = build(_allocator, data, size);
+      return;
+    }
+
+    if(size <= max_chunk_size) {
+      bool inserted = false;
+      _root = insert_into_leaf(_allocator, _root, offset, data,
+                               measure(data, size), inserted);
+      if(inserted) {
+        return;
+      }
+    }
+
+    Rope_Node* left;
+    Rope_Node* right;
+    split(_allocator, _root, offset, left, right);
+    Rope_Node* const middle = build(_allocator, data, size);
+    _root = concat(_allocator, concat(_allocator, left, middle), right);
+  }
+
+  void Rope::append(String_View const string)
+  {
+    insert(size_bytes(), string);
+  }
+
+  void Rope::erase(i64 const first, i64 const last)
+  {
+    ANTON_ASSERT(first >= 0 && first <= last && last <= size_bytes(),
+                 u8"range out of bounds");
+    ANTON_ASSERT(is_code_point_boundary(_root, first) &&
+                   is_code_point_boundary(_root, last),
+                 u8"range does not lie on code point boundaries");
+    if(first == last) {
+      return;
+    }
+
+    bool erased = false;
+    erase_in_leaf(_root, first, last, erased);
+    if(erased) {
+      return;
+    }
+
+    Rope_Node* left;
+    Rope_Node* middle;
+    Rope_Node* right;
+    split(_allocator, _root, last, middle, right);
+    split(_allocator, middle, first, left, middle);
+    destroy_tree(_allocator, middle);
+    _root = concat(_allocator, left, right);
+  }
+
+  void Rope::clear()
+  {
+    destroy_tree(_allocator, _root);
+    _root = nullptr;
+  }
+
+  i64 Rope::get_byte_offset(i64 index) const
+  {
+    ANTON_ASSERT(index >= 0 && index <= size_utf8(), u8"index out of bounds");
+    if(index == size_utf8()) {
+      return size_bytes();
+    }
+
+    i64 offset = 0;
+    Rope_Node const* node = _root;
+    while(!is_leaf(node)) {
+      if(index < node->left->code_points) {
+        node = node->left;
+      } else {
+        index -= node->left->code_points;
+        offset += node->left->bytes;
+        node = node->right;
+      }
+    }
+
+    char8 const* const data = leaf_data(node);
+    i64 i = 0;
+    for(; index > 0; --index) {
+      i += unicode::get_byte_count_from_utf8_leading_byte(data[i]);
+    }
+    return offset + i;
+  }
+
+  i64 Rope::get_line_offset(i64 const line) const
+  {
+    ANTON_ASSERT(line >= 0 && line < line_count(), u8"line out of bounds");
+    if(line == 0) {
+      return 0;
+    }
+
+    // The line begins after the line-th line feed.
+    i64 remaining = line;
+    i64 offset = 0;
+    Rope_Node const* node = _root;
+    while(!is_leaf(node)) {
+      if(remaining <= node->left->newlines) {
+        node = node->left;
+      } else {
+        remaining -= node->left->newlines;
+        offset += node->left->bytes;
+        node = node->right;
+      }
+    }
+
+    u8 const* const data = reinterpret_cast<u8 const*>(leaf_data(node));
+    i64 i = 0;
+    while(true) {
+      i += detail::simd_find(data + i, node->bytes - i, u8'\n');
+      remaining -= 1;
+      if(remaining == 0) {
+        return offset + i + 1;
+      }
+      i += 1;
+    }
+  }
+
+  i64 Rope::get_char_index(i64 offset) const
+  {
+    ANTON_ASSERT(offset >= 0 && offset <= size_bytes(),
+                 u8"offset out of bounds");
+    if(_root == nullptr) {
+      return 0;
+    }
+
+    i64 result = 0;
+    Rope_Node const* node = _root;
+    while(!is_leaf(node)) {
+      if(offset < node->left->bytes) {
+        node = node->left;
+      } else {
+        result += node->left->code_points;
+        offset -= node->left->bytes;
+        node = node->right;
+      }
+    }
+    return result +
+           unicode::get_utf32_length_from_utf8(leaf_data(node), offset);
+  }
+
+  i64 Rope::get_line_index(i64 offset) const
+  {
+    ANTON_ASSERT(offset >= 0 && offset <= size_bytes(),
+                 u8"offset out of bounds");
+    if(_root == nullptr) {
+      return 0;
+    }
+
+    i64 result = 0;
+    Rope_Node const* node = _root;
+    while(!is_leaf(node)) {
+      if(offset < node->left->bytes) {
+        node = node->left;
+      } else {
+        result += node->left->newlines;
+        offset -= node->left->bytes;
+        node = node->right;
+      }
+    }
+    return result +
+           detail::simd_count(reinterpret_cast<u8 const*>(leaf_data(node)),
+                              offset, u8'\n');
+  }
+
+  char32 Rope::char_at(i64 const index) const
+  {
+    ANTON_ASSERT(index >= 0 && index < size_utf8(), u8"index out of bounds");
+    i64 offset = get_byte_offset(index);
+    Rope_Node const* const leaf = find_leaf(_root, offset);
+    return unicode::convert_codepoint_utf8_to_utf32(leaf_data(leaf) + offset);
+  }
+
+  String Rope::to_string() const
+  {
+    String result(reserve, size_bytes(), _allocator);
+    for(String_View const chunk: chunks()) {
+      result.append(chunk);
+    }
+    return result;
+  }
+
+  void swap(Rope& lhs, Rope& rhs)
+  {
+    swap(lhs._allocator, rhs._allocator);
+    swap(lhs._root, rhs._root);
+  }
+} // namespace anton
@@ -0,0 +1,36 @@
+#include <anton/searcher.hpp>
+
+namespace anton {
+  Searcher::Searcher(String_View const substr)
+    : _data(substr.data()), _size(substr.size_bytes())
+  {
+    if(_size > 0) {
+      detail::build_two_way_table(_table, _data, _size);
+    }
+  }
+
+  Searcher::Searcher(String7_View const substr)
+    : _data(substr.data()), _size(substr.size())
+  {
+    if(_size > 0) {
+      detail::build_two_way_table(_table, _data, _size);
+    }
+  }
+
+  String_View Searcher::get_substring() const
+  {
+    return String_View{_data, _size};
+  }
+
+  i64 Searcher::find(String_View const string) const
+  {
+    return detail::find_substring_bytes(string.data(), string.size_bytes(),
+                                        _data, _size, &_table);
+  }
+
+  i64 Searcher::find(String7_View const string) const
+  {
+    return detail::find_substring_bytes(string.data(), string.size(), _data,
+                                        _size, &_table);
+  }
+} // namespace anton
@@ -0,0 +1,310 @@
+#pragma once
+
+#include <anton/type_traits/base.hpp>
+#include <anton/type_traits/properties.hpp>
+#include <simd/simd.hpp>
+
+namespace anton::simd {
+  // Entry points of the kernels instantiated for AVX2 in algorithm_avx2.cpp.
+  // Instantiated for u8, u16, u32 and u64. min_element_avx2 and
+  // max_element_avx2 are additionally instantiated for i8, i16, i32 and i64.
+
+  template<typename T>
+  [[nodiscard]] i64 find_avx2(T const* data, i64 length, T value);
+  template<typename T>
+  [[nodiscard]] i64 count_avx2(T const* data, i64 length, T value);
+  [[nodiscard]] i64 mismatch_avx2(u8 const* lhs, u8 const* rhs, i64 size);
+  template<typename T>
+  [[nodiscard]] i64 min_element_avx2(T const* data, i64 length);
+  template<typename T>
+  [[nodiscard]] i64 max_element_avx2(T const* data, i64 length);
+  // Instantiated for i32, i64, u32 and u64.
+  template<typename T>
+  [[nodiscard]] i64 set_intersection_avx2(T const* first1, i64 length1,
+                                          T const* first2, i64 length2,
+                                          T* out);
+
+  namespace {
+    // set_intersection_scalar
+    // Intersects [first1 + i, first1 + length1[ and [first2 + j, first2 +
+    // length2[ until either range reaches its end, i.e. index end1 or end2.
+    //
+    template<typename T>
+    void set_intersection_scalar(T const* const first1, i64& i, i64 const end1,
+                                 T const* const first2, i64& j, i64 const end2,
+                                 T* const out, i64& count)
+    {
+      while(i < end1 && j < end2) {
+        T const a = first1[i];
+        T const b = first2[j];
+        if(a < b) {
+          ++i;
+        } else if(b < a) {
+          ++j;
+        } else {
+          out[count] = a;
+          ++count;
+          ++i;
+          ++j;
+        }
+      }
+    }
+
+    template<typename T>
+    [[nodiscard]] i64 find_scalar(T const* const data, i64 i, i64 const length,
+                                  T const value)
+    {
+      while(i < length && data[i] != value) {
+        ++i;
+      }
+      return i;
+    }
+
+    // find
+    // Returns the index of the first element equal to value or length if
+    // there is none.
+    //
+    template<typename Ops, typename T>
+    [[nodiscard]] i64 find(T const* const data, i64 const length,
+                           T const value)
+    {
+      constexpr i64 size = sizeof(T);
+      constexpr i64 lanes = Ops::width / size;
+      if(length < lanes) {
+        return find_scalar(data, 0, length, value);
+      }
+
+      auto const needle = Ops::broadcast(value);
+      i64 i = 0;
+      // Test 4 vectors per iteration to keep more loads in flight. The match
+      // is located by the loop below.
+      for(; i + 4 * lanes <= length; i += 4 * lanes) {
+        auto const e0 =
+          Ops::template equal<size>(Ops::load(data + i), needle);
+        auto const e1 =
+          Ops::template equal<size>(Ops::load(data + i + lanes), needle);
+        auto const e2 =
+          Ops::template equal<size>(Ops::load(data + i + 2 * lanes), needle);
+        auto const e3 =
+          Ops::template equal<size>(Ops::load(data + i + 3 * lanes), needle);
+        auto const any = Ops::bit_or(Ops::bit_or(e0, e1), Ops::bit_or(e2, e3));
+        if(Ops::mask(any) != 0) {
+          break;
+        }
+      }
+
+      for(; i + lanes <= length; i += lanes) {
+        auto const mask =
+          Ops::mask(Ops::template equal<size>(Ops::load(data + i), needle));
+        if(mask != 0) {
+          return i + count_trailing_zeros(mask) / size;
+        }
+      }
+
+      // The last vector overlaps the elements already tested, which did not
+      // match, therefore the first match in it is the first match overall.
+      if(i < length) {
+        i64 const tail = length - lanes;
+        auto const mask = Ops::mask(
+          Ops::template equal<size>(Ops::load(data + tail), needle));
+        if(mask != 0) {
+          return tail + count_trailing_zeros(mask) / size;
+        }
+      }
+      return length;
+    }
+
+    // count
+    // Returns the number of elements equal to value.
+    //
+    template<typename Ops, typename T>
+    [[nodiscard]] i64 count(T const* const data, i64 const length,
+                            T const value)
+    {
+      constexpr i64 size = sizeof(T);
+      constexpr i64 lanes = Ops::width / size;
+      // The number of iterations after which the lanes of the accumulator
+      // might overflow.
+      constexpr i64 flush_interval =
+        size == 1 ? 255 : (size == 2 ? 65535 : 0x7FFFFFFF);
+
+      i64 result = 0;
+      i64 i = 0;
+      if(length >= lanes) {
+        auto const needle = Ops::broadcast(value);
+        while(i + lanes <= length) {
+          // Matching lanes are all ones, i.e. -1. Subtracting them increments
+          // the per-lane counters.
+          auto accumulator = Ops::zero();
+          for(i64 n = 0; n < flush_interval && i + lanes <= length;
+              ++n, i += lanes) {
+            accumulator = Ops::template subtract<size>(
+              accumulator,
+              Ops::template equal<size>(Ops::load(data + i), needle));
+          }
+
+          T counters[lanes];
+          Ops::store(counters, accumulator);
+          for(i64 lane = 0; lane < lanes; ++lane) {
+            result += static_cast<i64>(counters[lane]);
+          }
+        }
+      }
+
+      for(; i < length; ++i) {
+        result += data[i] == value;
+      }
+      return result;
+    }
+
+    // mismatch
+    // Returns the index of the first byte that differs between lhs and rhs or
+    // size if the ranges are equal.
+    //
+    template<typename Ops>
+    [[nodiscard]] i64 mismatch(u8 const* const lhs, u8 const* const rhs,
+                               i64 const size)
+    {
+      constexpr i64 width = Ops::width;
+      if(size < width) {
+        i64 i = 0;
+        while(i < size && lhs[i] == rhs[i]) {
+          ++i;
+        }
+        return i;
+      }
+
+      i64 i = 0;
+      for(; i + width <= size; i += width) {
+        auto const mask = Ops::mask(
+          Ops::template equal<1>(Ops::load(lhs + i), Ops::load(rhs + i)));
+        if(mask != Ops::full_mask) {
+          return i + count_trailing_zeros(~mask);
+        }
+      }
+
+      if(i < size) {
+        i64 const tail = size - width;
+        auto const mask = Ops::mask(
+          Ops::template equal<1>(Ops::load(lhs + tail), Ops::load(rhs + tail)));
+        if(mask != Ops::full_mask) {
+          return tail + count_trailing_zeros(~mask);
+        }
+      }
+      return size;
+    }
+
+    // extreme_element
+    // Returns the index of the first smallest element or the first largest
+    // element if Maximum is true. The extreme value is found first and then
+    // searched for, both passes being vectorized.
+    //
+    template<typename Ops, bool Maximum, typename T>
+    [[nodiscard]] i64 extreme_element(T const* const data, i64 const length)
+    {
+      constexpr i64 size = sizeof(T);
+      constexpr i64 lanes = Ops::width / size;
+      if(length == 0) {
+        return 0;
+      }
+
+      T extreme = data[0];
+      i64 i = 0;
+      if constexpr(size < 8 || Ops::has_compare_64) {
+        if(length >= lanes) {
+          // Only signed comparisons are available. Flipping the sign bit maps
+          // the unsigned order onto the signed order.
+          T const sign_bit =
+            static_cast<T>(static_cast<T>(1) << (size * 8 - 1));
+          auto const bias =
+            Ops::broadcast(is_signed<T> ? static_cast<T>(0) : sign_bit);
+          auto best = Ops::bit_xor(Ops::load(data), bias);
+          auto const accumulate = [&best](auto const v) {
+            if constexpr(Maximum) {
+              best =
+                Ops::select(Ops::template greater<size>(v, best), v, best);
+            } else {
+              best =
+                Ops::select(Ops::template greater<size>(best, v), v, best);
+            }
+          };
+
+          for(i = lanes; i + lanes <= length; i += lanes) {
+            accumulate(Ops::bit_xor(Ops::load(data + i), bias));
+          }
+
+          if(i < length) {
+            accumulate(Ops::bit_xor(Ops::load(data + length - lanes), bias));
+            i = length;
+          }
+
+          T values[lanes];
+          Ops::store(values, Ops::bit_xor(best, bias));
+          extreme = values[0];
+          for(i64 lane = 1; lane < lanes; ++lane) {
+            if(Maximum ? values[lane] > extreme : values[lane] < extreme) {
+              extreme = values[lane];
+            }
+          }
+        }
+      }
+
+      for(; i < length; ++i) {
+        if(Maximum ? data[i] > extreme : data[i] < extreme) {
+          extreme = data[i];
+        }
+      }
+
+      using unsigned_type = conditional<
+        size == 1, u8,
+        conditional<size == 2, u16, conditional<size == 4, u32, u64>>>;
+      return find<Ops>(reinterpret_cast<unsigned_type const*>(data), length,
+                       static_cast<unsigned_type>(extreme));
+    }
+
+    // set_intersection
+    // Intersects the sorted ranges block by block. Every element of a block of
+    // the first range is compared with every element of a block of the second
+    // range. When no pair is equal, the block with the smaller last element
+    // cannot have any equal elements in the rest of the other range and is
+    // skipped. Otherwise the blocks are merged with the scalar loop, which
+    // also handles duplicate elements.
+    //
+    // Returns: The number of elements written to out.
+    //
+    template<typename Ops, typename T>
+    [[nodiscard]] i64 set_intersection(T const* const first1, i64 const length1,
+                                       T const* const first2, i64 const length2,
+                                       T* const out)
+    {
+      constexpr i64 size = sizeof(T);
+      constexpr i64 lanes = Ops::width / size;
+      i64 i = 0;
+      i64 j = 0;
+      i64 count = 0;
+      while(i + lanes <= length1 && j + lanes <= length2) {
+        auto const block = Ops::load(first1 + i);
+        auto matches =
+          Ops::template equal<size>(block, Ops::broadcast(first2[j]));
+        for(i64 lane = 1; lane < lanes; ++lane) {
+          matches = Ops::bit_or(
+            matches,
+            Ops::template equal<size>(block, Ops::broadcast(first2[j + lane])));
+        }
+
+        if(Ops::mask(matches) != 0) {
+          set_intersection_scalar(first1, i, i + lanes, first2, j, j + lanes,
+                                  out, count);
+        } else if(first1[i + lanes - 1] < first2[j + lanes - 1]) {
+          i += lanes;
+        } else {
+          j += lanes;
+        }
+      }
+
+      set_intersection_scalar(first1, i, length1, first2, j, length2, out,
+                              count);
+      return count;
+    }
+  } // namespace
+} // namespace anton::simd
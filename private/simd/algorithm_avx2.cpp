@@ -0,0 +1,78 @@
+// Compiled with AVX2 enabled. Must not include headers that define functions
+// with external linkage other than the ones in private/simd.
+
+#include <simd/algorithm.hpp>
+
+#if ANTON_SIMD_X86
+
+  #include <simd/avx2.hpp>
+
+namespace anton::simd {
+  template<typename T>
+  i64 find_avx2(T const* const data, i64 const length, T const value)
+  {
+    return find<AVX2>(data, length, value);
+  }
+
+  template<typename T>
+  i64 count_avx2(T const* const data, i64 const length, T const value)
+  {
+    return count<AVX2>(data, length, value);
+  }
+
+  i64 mismatch_avx2(u8 const* const lhs, u8 const* const rhs, i64 const size)
+  {
+    return mismatch<AVX2>(lhs, rhs, size);
+  }
+
+  template<typename T>
+  i64 min_element_avx2(T const* const data, i64 const length)
+  {
+    return extreme_element<AVX2, false>(data, length);
+  }
+
+  template<typename T>
+  i64 max_element_avx2(T const* const data, i64 const length)
+  {
+    return extreme_element<AVX2, true>(data, length);
+  }
+
+  template<typename T>
+  i64 set_intersection_avx2(T const* const first1, i64 const length1,
+                            T const* const first2, i64 const length2,
+                            T* const out)
+  {
+    return set_intersection<AVX2>(first1, length1, first2, length2, out);
+  }
+
+  template i64 find_avx2(u8 const*, i64, u8);
+  template i64 find_avx2(u16 const*, i64, u16);
+  template i64 find_avx2(u32 const*, i64, u32);
+  template i64 find_avx2(u64 const*, i64, u64);
+  template i64 count_avx2(u8 const*, i64, u8);
+  template i64 count_avx2(u16 const*, i64, u16);
+  template i64 count_avx2(u32 const*, i64, u32);
+  template i64 count_avx2(u64 const*, i64, u64);
+  template i64 min_element_avx2(i8 const*, i64);
+  template i64 min_element_avx2(i16 const*, i64);
+  template i64 min_element_avx2(i32 const*, i64);
+  template i64 min_element_avx2(i64 const*, i64);
+  template i64 min_element_avx2(u8 const*, i64);
+  template i64 min_element_avx2(u16 const*, i64);
+  template i64 min_element_avx2(u32 const*, i64);
+  template i64 min_element_avx2(u64 const*, i64);
+  template i64 max_element_avx2(i8 const*, i64);
+  template i64 max_element_avx2(i16 const*, i64);
+  template i64 max_element_avx2(i32 const*, i64);
+  template i64 max_element_avx2(i64 const*, i64);
+  template i64 max_element_avx2(u8 const*, i64);
+  template i64 max_element_avx2(u16 const*, i64);
+  template i64 max_element_avx2(u32 const*, i64);
+  template i64 max_element_avx2(u64 const*, i64);
+  template i64 set_intersection_avx2(i32 const*, i64, i32 const*, i64, i32*);
+  template i64 set_intersection_avx2(i64 const*, i64, i64 const*, i64, i64*);
+  template i64 set_intersection_avx2(u32 const*, i64, u32 const*, i64, u32*);
+  template i64 set_intersection_avx2(u64 const*, i64, u64 const*, i64, u64*);
+} // namespace anton::simd
+
+#endif
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <simd/simd.hpp>
+
+#if ANTON_SIMD_X86
+
+  #include <immintrin.h>
+
+namespace anton::simd {
+  namespace {
+    // AVX2
+    // Description of the AVX2 instruction set used by the kernels. May only be
+    // included in the translation units compiled with AVX2 enabled.
+    //
+    struct AVX2 {
+      using vector = __m256i;
+      using mask_type = u32;
+
+      // Width of the vector in bytes.
+      static constexpr i64 width = 32;
+      // Mask with all bits set returned by mask() when all bytes compare equal.
+      static constexpr mask_type full_mask = 0xFFFFFFFF;
+      static constexpr bool has_compare_64 = true;
+
+      [[nodiscard]] static vector load(void const* const data)
+      {
+        return _mm256_loadu_si256(static_cast<__m256i const*>(data));
+      }
+
+      static void store(void* const data, vector const v)
+      {
+        _mm256_storeu_si256(static_cast<__m256i*>(data), v);
+      }
+
+      [[nodiscard]] static vector zero()
+      {
+        return _mm256_setzero_si256();
+      }
+
+      template<typename T>
+      [[nodiscard]] static vector broadcast(T const value)
+      {
+        if constexpr(sizeof(T) == 1) {
+          return _mm256_set1_epi8(static_cast<char>(value));
+        } else if constexpr(sizeof(T) == 2) {
+          return _mm256_set1_epi16(static_cast<short>(value));
+        } else if constexpr(sizeof(T) == 4) {
+          return _mm256_set1_epi32(static_cast<int>(value));
+        } else {
+          return _mm256_set1_epi64x(static_cast<long long>(value));
+        }
+      }
+
+      // mask
+      // Gathers the most significant bits of the bytes of v.
+      //
+      [[nodiscard]] static mask_type mask(vector const v)
+      {
+        return static_cast<mask_type>(_mm256_movemask_epi8(v));
+      }
+
+      [[nodiscard]] static vector bit_or(vector const lhs, vector const rhs)
+      {
+        return _mm256_or_si256(lhs, rhs);
+      }
+
+      [[nodiscard]] static vector bit_and(vector const lhs, vector const rhs)
+      {
+        return _mm256_and_si256(lhs, rhs);
+      }
+
+      [[nodiscard]] static vector bit_xor(vector const lhs, vector const rhs)
+      {
+        return _mm256_xor_si256(lhs, rhs);
+      }
+
+      // select
+      // Selects the bytes of lhs where mask is set and of rhs elsewhere.
+      //
+      [[nodiscard]] static vector select(vector const mask, vector const lhs,
+                                         vector const rhs)
+      {
+        return _mm256_blendv_epi8(rhs, lhs, mask);
+      }
+
+      template<i64 Size>
+      [[nodiscard]] static vector equal(vector const lhs, vector const rhs)
+      {
+        if constexpr(Size == 1) {
+          return _mm256_cmpeq_epi8(lhs, rhs);
+        } else if constexpr(Size == 2) {
+          return _mm256_cmpeq_epi16(lhs, rhs);
+        } else if constexpr(Size == 4) {
+          return _mm256_cmpeq_epi32(lhs, rhs);
+        } else {
+          return _mm256_cmpeq_epi64(lhs, rhs);
+        }
+      }
+
+      // greater
+      // Signed comparison lhs > rhs.
+      //
+      template<i64 Size>
+      [[nodiscard]] static vector greater(vector const lhs, vector const rhs)
+      {
+        if constexpr(Size == 1) {
+          return _mm256_cmpgt_epi8(lhs, rhs);
+        } else if constexpr(Size == 2) {
+          return _mm256_cmpgt_epi16(lhs, rhs);
+        } else if constexpr(Size == 4) {
+          return _mm256_cmpgt_epi32(lhs, rhs);
+        } else {
+          return _mm256_cmpgt_epi64(lhs, rhs);
+        }
+      }
+
+      template<i64 Size>
+      [[nodiscard]] static vector subtract(vector const lhs, vector const rhs)
+      {
+        if constexpr(Size == 1) {
+          return _mm256_sub_epi8(lhs, rhs);
+        } else if constexpr(Size == 2) {
+          return _mm256_sub_epi16(lhs, rhs);
+        } else if constexpr(Size == 4) {
+          return _mm256_sub_epi32(lhs, rhs);
+        } else {
+          return _mm256_sub_epi64(lhs, rhs);
+        }
+      }
+    };
+  } // namespace
+} // namespace anton::simd
+
+#endif
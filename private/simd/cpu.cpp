@@ -0,0 +1,63 @@
+#include <simd/simd.hpp>
+
+#if ANTON_SIMD_X86 && !ANTON_COMPILER_MSVC
+  #include <cpuid.h>
+#endif
+
+namespace anton::simd {
+  static bool detect_avx2()
+  {
+#if ANTON_SIMD_X86
+    u32 registers[4] = {};
+  #if ANTON_COMPILER_MSVC
+    __cpuid(reinterpret_cast<int*>(registers), 0);
+  #else
+    __cpuid(0, registers[0], registers[1], registers[2], registers[3]);
+  #endif
+    if(registers[0] < 7) {
+      return false;
+    }
+
+  #if ANTON_COMPILER_MSVC
+    __cpuid(reinterpret_cast<int*>(registers), 1);
+  #else
+    __cpuid(1, registers[0], registers[1], registers[2], registers[3]);
+  #endif
+    // OSXSAVE and AVX.
+    constexpr u32 osxsave_avx = (1u << 27) | (1u << 28);
+    if((registers[2] & osxsave_avx) != osxsave_avx) {
+      return false;
+    }
+
+    // The operating system must preserve the XMM and YMM state.
+  #if ANTON_COMPILER_MSVC
+    u64 const xcr0 = _xgetbv(0);
+  #else
+    u32 xcr0_low;
+    u32 xcr0_high;
+    __asm__("xgetbv" : "=a"(xcr0_low), "=d"(xcr0_high) : "c"(0));
+    u64 const xcr0 = (static_cast<u64>(xcr0_high) << 32) | xcr0_low;
+  #endif
+    if((xcr0 & 0x6) != 0x6) {
+      return false;
+    }
+
+  #if ANTON_COMPILER_MSVC
+    __cpuidex(reinterpret_cast<int*>(registers), 7, 0);
+  #else
+    __cpuid_count(7, 0, registers[0], registers[1], registers[2],
+                  registers[3]);
+  #endif
+    // AVX2 is bit 5 of EBX.
+    return (registers[1] & (1u << 5)) != 0;
+#else
+    return false;
+#endif
+  }
+
+  bool cpu_supports_avx2()
+  {
+    static bool const supported = detect_avx2();
+    return supported;
+  }
+} // namespace anton::simd
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <anton/types.hpp>
+
+#if defined(__x86_64__) || defined(_M_X64)
+  #define ANTON_SIMD_X86 1
+#else
+  #define ANTON_SIMD_X86 0
+#endif
+
+#if ANTON_COMPILER_MSVC
+  #include <intrin.h>
+#endif
+
+// Internal vectorization support shared by the kernels in private/. The
+// kernels are written once against an instruction set description (SSE2 or
+// AVX2 in sse2.hpp and avx2.hpp) and instantiated in separate translation
+// units. The AVX2 translation units are compiled with AVX2 enabled and must
+// only be entered after cpu_supports_avx2 returned true.
+//
+// Everything defined in the headers of private/simd has internal linkage so
+// that the instantiations compiled with different instruction sets never get
+// merged by the linker.
+
+namespace anton::simd {
+  // cpu_supports_avx2
+  // Checks whether both the processor and the operating system support AVX2.
+  // The result is computed once and cached.
+  //
+  [[nodiscard]] bool cpu_supports_avx2();
+
+  namespace {
+    // count_trailing_zeros
+    // mask must not be 0.
+    //
+    [[nodiscard]] inline i64 count_trailing_zeros(u32 const mask)
+    {
+#if ANTON_COMPILER_MSVC
+      unsigned long index;
+      _BitScanForward(&index, mask);
+      return static_cast<i64>(index);
+#else
+      return __builtin_ctz(mask);
+#endif
+    }
+
+    [[nodiscard]] inline i64 count_trailing_zeros(u64 const mask)
+    {
+#if ANTON_COMPILER_MSVC
+      unsigned long index;
+      _BitScanForward64(&index, mask);
+      return static_cast<i64>(index);
+#else
+      return __builtin_ctzll(mask);
+#endif
+    }
+
+    // count_leading_zeros
+    // mask must not be 0.
+    //
+    [[nodiscard]] inline i64 count_leading_zeros(u32 const mask)
+    {
+#if ANTON_COMPILER_MSVC
+      unsigned long index;
+      _BitScanReverse(&index, mask);
+      return 31 - static_cast<i64>(index);
+#else
+      return __builtin_clz(mask);
+#endif
+    }
+  } // namespace
+} // namespace anton::simd
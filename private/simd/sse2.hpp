@@ -0,0 +1,138 @@
+#pragma once
+
+#include <simd/simd.hpp>
+
+#if ANTON_SIMD_X86
+
+  #include <emmintrin.h>
+
+namespace anton::simd {
+  namespace {
+    // SSE2
+    // Description of the SSE2 instruction set used by the kernels. SSE2 is
+    // part of the x86-64 baseline and is always available.
+    //
+    struct SSE2 {
+      using vector = __m128i;
+      using mask_type = u32;
+
+      // Width of the vector in bytes.
+      static constexpr i64 width = 16;
+      // Mask with all bits set returned by mask() when all bytes compare equal.
+      static constexpr mask_type full_mask = 0xFFFF;
+      // SSE2 lacks 64-bit comparisons.
+      static constexpr bool has_compare_64 = false;
+
+      [[nodiscard]] static vector load(void const* const data)
+      {
+        return _mm_loadu_si128(static_cast<__m128i const*>(data));
+      }
+
+      static void store(void* const data, vector const v)
+      {
+        _mm_storeu_si128(static_cast<__m128i*>(data), v);
+      }
+
+      [[nodiscard]] static vector zero()
+      {
+        return _mm_setzero_si128();
+      }
+
+      template<typename T>
+      [[nodiscard]] static vector broadcast(T const value)
+      {
+        if constexpr(sizeof(T) == 1) {
+          return _mm_set1_epi8(static_cast<char>(value));
+        } else if constexpr(sizeof(T) == 2) {
+          return _mm_set1_epi16(static_cast<short>(value));
+        } else if constexpr(sizeof(T) == 4) {
+          return _mm_set1_epi32(static_cast<int>(value));
+        } else {
+          return _mm_set1_epi64x(static_cast<long long>(value));
+        }
+      }
+
+      // mask
+      // Gathers the most significant bits of the bytes of v.
+      //
+      [[nodiscard]] static mask_type mask(vector const v)
+      {
+        return static_cast<mask_type>(_mm_movemask_epi8(v));
+      }
+
+      [[nodiscard]] static vector bit_or(vector const lhs, vector const rhs)
+      {
+        return _mm_or_si128(lhs, rhs);
+      }
+
+      [[nodiscard]] static vector bit_and(vector const lhs, vector const rhs)
+      {
+        return _mm_and_si128(lhs, rhs);
+      }
+
+      [[nodiscard]] static vector bit_xor(vector const lhs, vector const rhs)
+      {
+        return _mm_xor_si128(lhs, rhs);
+      }
+
+      // select
+      // Selects the bytes of lhs where mask is set and of rhs elsewhere.
+      //
+      [[nodiscard]] static vector select(vector const mask, vector const lhs,
+                                         vector const rhs)
+      {
+        return _mm_or_si128(_mm_and_si128(mask, lhs),
+                            _mm_andnot_si128(mask, rhs));
+      }
+
+      template<i64 Size>
+      [[nodiscard]] static vector equal(vector const lhs, vector const rhs)
+      {
+        if constexpr(Size == 1) {
+          return _mm_cmpeq_epi8(lhs, rhs);
+        } else if constexpr(Size == 2) {
+          return _mm_cmpeq_epi16(lhs, rhs);
+        } else if constexpr(Size == 4) {
+          return _mm_cmpeq_epi32(lhs, rhs);
+        } else {
+          // Both halves of a 64-bit lane must compare equal.
+          __m128i const halves = _mm_cmpeq_epi32(lhs, rhs);
+          return _mm_and_si128(
+            halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+      }
+
+      // greater
+      // Signed comparison lhs > rhs. Not available for 64-bit lanes.
+      //
+      template<i64 Size>
+      [[nodiscard]] static vector greater(vector const lhs, vector const rhs)
+      {
+        static_assert(Size != 8, "SSE2 has no 64-bit comparison");
+        if constexpr(Size == 1) {
+          return _mm_cmpgt_epi8(lhs, rhs);
+        } else if constexpr(Size == 2) {
+          return _mm_cmpgt_epi16(lhs, rhs);
+        } else {
+          return _mm_cmpgt_epi32(lhs, rhs);
+        }
+      }
+
+      template<i64 Size>
+      [[nodiscard]] static vector subtract(vector const lhs, vector const rhs)
+      {
+        if constexpr(Size == 1) {
+          return _mm_sub_epi8(lhs, rhs);
+        } else if constexpr(Size == 2) {
+          return _mm_sub_epi16(lhs, rhs);
+        } else if constexpr(Size == 4) {
+          return _mm_sub_epi32(lhs, rhs);
+        } else {
+          return _mm_sub_epi64(lhs, rhs);
+        }
+      }
+    };
+  } // namespace
+} // namespace anton::simd
+
+#endif
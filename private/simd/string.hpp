@@ -0,0 +1,205 @@
+#pragma once
+
+#include <anton/detail/crt.hpp>
+#include <simd/simd.hpp>
+
+namespace anton::simd {
+  // Substring_Filter_Result
+  //
+  struct Substring_Filter_Result {
+    // The position of the occurrence, -1 if there is none or the position at
+    // which the search has been abandoned.
+    i64 position;
+    // Whether the search has been abandoned because the verification of the
+    // candidates did too much work. The forward search has examined the
+    // positions preceding position, the backward search the positions from
+    // position onwards.
+    bool abandoned;
+  };
+
+  // Entry points of the kernels instantiated for AVX2 in string_avx2.cpp.
+
+  [[nodiscard]] Substring_Filter_Result
+  find_substring_avx2(char8 const* string, i64 size, char8 const* substr,
+                      i64 substr_size);
+  [[nodiscard]] Substring_Filter_Result
+  find_last_substring_avx2(char8 const* string, i64 size, char8 const* substr,
+                           i64 substr_size);
+
+  // find_any_ascii_avx2
+  // Finds the first byte of string that belongs to a set of ASCII bytes.
+  //
+  // Parameters:
+  // string - the string to search.
+  //   size - the number of bytes in string.
+  //  table - the set indexed by the low nibble of the bytes. Bit n of an
+  //          entry is set when the byte with the high nibble n is in the set.
+  //
+  // Returns:
+  // The position of the byte or size if string contains none of the bytes.
+  //
+  [[nodiscard]] i64 find_any_ascii_avx2(char8 const* string, i64 size,
+                                        u8 const* table);
+
+  // Teddy_Candidates
+  // The positions at which a pattern of a Teddy set may begin and the buckets
+  // of the patterns that may begin there.
+  //
+  struct Teddy_Candidates {
+    static constexpr i64 capacity = 128;
+
+    i64 count;
+    i64 positions[capacity];
+    u8 buckets[capacity];
+  };
+
+  // find_teddy_candidates_avx2
+  // Looks for the positions at which a pattern of a Teddy set may begin,
+  // testing 32 positions at once. Every pattern belongs to one of 8 buckets.
+  // The first fingerprint_size bytes of the patterns are described by
+  // masks, which holds two tables of 16 bytes for every fingerprint byte:
+  // the buckets containing a pattern with the given low nibble followed by
+  // the buckets containing a pattern with the given high nibble.
+  //
+  // The search stops when candidates is nearly full, so that dense
+  // candidates are collected in batches rather than one block at a time.
+  //
+  // Parameters:
+  //            masks - the lookup tables.
+  // fingerprint_size - the number of fingerprint bytes in [1, 3].
+  //           string - the string to search.
+  //             size - the number of bytes in string.
+  //            first - the position to start the search at.
+  //       candidates - receives the candidates in increasing order.
+  //
+  // Returns:
+  // The position to resume the search at. The search is complete when the
+  // fingerprints of the block at the returned position do not fit in string.
+  //
+  [[nodiscard]] i64 find_teddy_candidates_avx2(u8 const* masks,
+                                               i64 fingerprint_size,
+                                               char8 const* string, i64 size,
+                                               i64 first,
+                                               Teddy_Candidates& candidates);
+
+  namespace {
+    // The search is abandoned once the bytes compared while verifying the
+    // candidates exceed the bytes scanned this many times over, plus the
+    // allowance. Repetitive strings produce a candidate at nearly every
+    // position and are better served by an algorithm with linear worst-case.
+    constexpr i64 substring_verification_factor = 8;
+    constexpr i64 substring_verification_allowance = 4096;
+
+    // substring_matches
+    // Verifies a candidate whose first and last bytes are known to match.
+    //
+    [[nodiscard]] inline bool substring_matches(char8 const* const window,
+                                                char8 const* const substr,
+                                                i64 const substr_size)
+    {
+      return substr_size <= 2 ||
+             memcmp(window + 1, substr + 1, substr_size - 2) == 0;
+    }
+
+    // find_substring
+    // Finds the first occurrence of substr in string. The first and the last
+    // byte of substr are compared with width consecutive positions at once
+    // and only the positions where both match are verified. substr_size must
+    // be in [1, size].
+    //
+    template<typename Ops>
+    [[nodiscard]] Substring_Filter_Result
+    find_substring(char8 const* const string, i64 const size,
+                   char8 const* const substr, i64 const substr_size)
+    {
+      constexpr i64 width = Ops::width;
+      i64 const positions = size - substr_size + 1;
+      char8 const first_byte = substr[0];
+      char8 const last_byte = substr[substr_size - 1];
+      auto const first = Ops::broadcast(first_byte);
+      auto const last = Ops::broadcast(last_byte);
+      i64 work = 0;
+      i64 i = 0;
+      for(; i + width <= positions; i += width) {
+        auto const first_equal =
+          Ops::template equal<1>(Ops::load(string + i), first);
+        auto const last_equal = Ops::template equal<1>(
+          Ops::load(string + i + substr_size - 1), last);
+        u32 mask = Ops::mask(Ops::bit_and(first_equal, last_equal));
+        while(mask != 0) {
+          i64 const candidate = i + count_trailing_zeros(mask);
+          if(substring_matches(string + candidate, substr, substr_size)) {
+            return {candidate, false};
+          }
+          work += substr_size;
+          mask &= mask - 1;
+        }
+
+        if(work > substring_verification_factor * i +
+                    substring_verification_allowance) {
+          return {i + width, true};
+        }
+      }
+
+      for(; i < positions; ++i) {
+        if(string[i] == first_byte &&
+           string[i + substr_size - 1] == last_byte &&
+           substring_matches(string + i, substr, substr_size)) {
+          return {i, false};
+        }
+      }
+      return {-1, false};
+    }
+
+    // find_last_substring
+    // Finds the last occurrence of substr in string scanning backwards.
+    // substr_size must be in [1, size].
+    //
+    template<typename Ops>
+    [[nodiscard]] Substring_Filter_Result
+    find_last_substring(char8 const* const string, i64 const size,
+                        char8 const* const substr, i64 const substr_size)
+    {
+      constexpr i64 width = Ops::width;
+      i64 const positions = size - substr_size + 1;
+      char8 const first_byte = substr[0];
+      char8 const last_byte = substr[substr_size - 1];
+      auto const first = Ops::broadcast(first_byte);
+      auto const last = Ops::broadcast(last_byte);
+      i64 work = 0;
+      // The positions from end onwards have been examined.
+      i64 end = positions;
+      for(; end >= width; end -= width) {
+        i64 const i = end - width;
+        auto const first_equal =
+          Ops::template equal<1>(Ops::load(string + i), first);
+        auto const last_equal = Ops::template equal<1>(
+          Ops::load(string + i + substr_size - 1), last);
+        u32 mask = Ops::mask(Ops::bit_and(first_equal, last_equal));
+        while(mask != 0) {
+          i64 const bit = 31 - count_leading_zeros(mask);
+          i64 const candidate = i + bit;
+          if(substring_matches(string + candidate, substr, substr_size)) {
+            return {candidate, false};
+          }
+          work += substr_size;
+          mask &= ~(static_cast<u32>(1) << bit);
+        }
+
+        if(work > substring_verification_factor * (positions - i) +
+                    substring_verification_allowance) {
+          return {i, true};
+        }
+      }
+
+      for(i64 i = end - 1; i >= 0; --i) {
+        if(string[i] == first_byte &&
+           string[i + substr_size - 1] == last_byte &&
+           substring_matches(string + i, substr, substr_size)) {
+          return {i, false};
+        }
+      }
+      return {-1, false};
+    }
+  } // namespace
+} // namespace anton::simd
@@ -0,0 +1,133 @@
+// Compiled with AVX2 enabled. Must not include headers that define functions
+// with external linkage other than the ones in private/simd.
+
+#include <simd/string.hpp>
+
+#if ANTON_SIMD_X86
+
+  #include <simd/avx2.hpp>
+
+namespace anton::simd {
+  namespace {
+    template<i64 Fingerprint_Size>
+    [[nodiscard]] i64 find_teddy_candidates(u8 const* const masks,
+                                            char8 const* const string,
+                                            i64 const size, i64 i,
+                                            Teddy_Candidates& candidates)
+    {
+      __m256i const nibble = _mm256_set1_epi8(0x0F);
+      __m256i low[Fingerprint_Size];
+      __m256i high[Fingerprint_Size];
+      for(i64 f = 0; f < Fingerprint_Size; ++f) {
+        // The shuffle looks up each 128-bit lane separately.
+        low[f] = _mm256_broadcastsi128_si256(
+          _mm_loadu_si128(reinterpret_cast<__m128i const*>(masks + 32 * f)));
+        high[f] = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+          reinterpret_cast<__m128i const*>(masks + 32 * f + 16)));
+      }
+
+      for(; i + Fingerprint_Size - 1 + 32 <= size; i += 32) {
+        __m256i result = _mm256_set1_epi8(-1);
+        for(i64 f = 0; f < Fingerprint_Size; ++f) {
+          __m256i const v = AVX2::load(string + i + f);
+          __m256i const low_buckets =
+            _mm256_shuffle_epi8(low[f], _mm256_and_si256(v, nibble));
+          __m256i const high_buckets = _mm256_shuffle_epi8(
+            high[f], _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+          result = _mm256_and_si256(
+            result, _mm256_and_si256(low_buckets, high_buckets));
+        }
+
+        u32 mask = ~static_cast<u32>(_mm256_movemask_epi8(
+          _mm256_cmpeq_epi8(result, _mm256_setzero_si256())));
+        if(mask == 0) {
+          continue;
+        }
+
+        alignas(32) u8 buckets[32];
+        AVX2::store(buckets, result);
+        for(; mask != 0; mask &= mask - 1) {
+          i64 const j = count_trailing_zeros(mask);
+          candidates.positions[candidates.count] = i + j;
+          candidates.buckets[candidates.count] = buckets[j];
+          candidates.count += 1;
+        }
+
+        if(candidates.count > Teddy_Candidates::capacity - 32) {
+          return i + 32;
+        }
+      }
+      return i;
+    }
+  } // namespace
+
+  i64 find_any_ascii_avx2(char8 const* const string, i64 const size,
+                          u8 const* const table)
+  {
+    // The shuffle looks up each 128-bit lane separately.
+    __m256i const low_table = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<__m128i const*>(table)));
+    // Maps the high nibble n to bit n. Non-ASCII bytes map to 0.
+    __m256i const high_table = _mm256_setr_epi8(
+      1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16,
+      32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m256i const nibble = _mm256_set1_epi8(0x0F);
+    i64 i = 0;
+    for(; i + 32 <= size; i += 32) {
+      __m256i const v = AVX2::load(string + i);
+      __m256i const low =
+        _mm256_shuffle_epi8(low_table, _mm256_and_si256(v, nibble));
+      __m256i const high = _mm256_shuffle_epi8(
+        high_table, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+      __m256i const matches = _mm256_cmpeq_epi8(
+        _mm256_and_si256(low, high), _mm256_setzero_si256());
+      u32 const mask = ~static_cast<u32>(_mm256_movemask_epi8(matches));
+      if(mask != 0) {
+        return i + count_trailing_zeros(mask);
+      }
+    }
+
+    for(; i < size; ++i) {
+      u8 const byte = static_cast<u8>(string[i]);
+      if(byte < 0x80 && (table[byte & 0x0F] >> (byte >> 4)) & 1) {
+        return i;
+      }
+    }
+    return size;
+  }
+
+  i64 find_teddy_candidates_avx2(u8 const* const masks,
+                                 i64 const fingerprint_size,
+                                 char8 const* const string, i64 const size,
+                                 i64 const first,
+                                 Teddy_Candidates& candidates)
+  {
+    candidates.count = 0;
+    switch(fingerprint_size) {
+    case 1:
+      return find_teddy_candidates<1>(masks, string, size, first, candidates);
+    case 2:
+      return find_teddy_candidates<2>(masks, string, size, first, candidates);
+    default:
+      return find_teddy_candidates<3>(masks, string, size, first, candidates);
+    }
+  }
+
+  Substring_Filter_Result find_substring_avx2(char8 const* const string,
+                                              i64 const size,
+                                              char8 const* const substr,
+                                              i64 const substr_size)
+  {
+    return find_substring<AVX2>(string, size, substr, substr_size);
+  }
+
+  Substring_Filter_Result find_last_substring_avx2(char8 const* const string,
+                                                   i64 const size,
+                                                   char8 const* const substr,
+                                                   i64 const substr_size)
+  {
+    return find_last_substring<AVX2>(string, size, substr, substr_size);
+  }
+} // namespace anton::simd
+
+#endif
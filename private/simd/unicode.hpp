@@ -0,0 +1,33 @@
+#pragma once
+
+#include <simd/simd.hpp>
+
+namespace anton::simd {
+  // Entry points of the Unicode kernels implemented in unicode_avx2.cpp.
+
+  // validate_utf8_avx2
+  // Validates UTF-8 by classifying every pair of adjacent bytes with lookup
+  // tables as described in "Validating UTF-8 In Less Than One Instruction Per
+  // Byte" by John Keiser and Daniel Lemire.
+  //
+  // Returns:
+  // true if [data, data + size[ is well-formed UTF-8.
+  //
+  [[nodiscard]] bool validate_utf8_avx2(char8 const* data, i64 size);
+
+  // validate_ascii_avx2
+  //
+  // Returns:
+  // true if none of the bytes of [data, data + size[ has the most significant
+  // bit set.
+  //
+  [[nodiscard]] bool validate_ascii_avx2(char8 const* data, i64 size);
+
+  // count_utf8_code_points_avx2
+  //
+  // Returns:
+  // The number of bytes of [data, data + size[ that are not continuation
+  // bytes, i.e. the number of code points in well-formed UTF-8.
+  //
+  [[nodiscard]] i64 count_utf8_code_points_avx2(char8 const* data, i64 size);
+} // namespace anton::simd
@@ -0,0 +1,243 @@
+// Compiled with AVX2 enabled. Must not include headers that define functions
+// with external linkage other than the ones in private/simd.
+
+#include <simd/unicode.hpp>
+
+#if ANTON_SIMD_X86
+
+  #include <simd/avx2.hpp>
+
+namespace anton::simd {
+  namespace {
+    // The error classes of a pair of adjacent bytes. A pair is invalid when
+    // the classes of its first byte (looked up by the high and the low
+    // nibble) and of its second byte (looked up by the high nibble) share a
+    // bit.
+
+    // 11______ 0_______
+    // 11______ 11______
+    constexpr u8 too_short = 1 << 0;
+    // 0_______ 10______
+    constexpr u8 too_long = 1 << 1;
+    // 11100000 100_____
+    constexpr u8 overlong_3 = 1 << 2;
+    // 11110100 1001____
+    // 11110100 101_____
+    // 11110101 1001____
+    // 11110101 101_____
+    // 1111011_ 1001____
+    // 1111011_ 101_____
+    // 11111___ 1001____
+    // 11111___ 101_____
+    constexpr u8 too_large = 1 << 3;
+    // 11101101 101_____
+    constexpr u8 surrogate = 1 << 4;
+    // 1100000_ 10______
+    constexpr u8 overlong_2 = 1 << 5;
+    // 11110101 1000____
+    // 1111011_ 1000____
+    // 11111___ 1000____
+    constexpr u8 too_large_1000 = 1 << 6;
+    // 11110000 1000____
+    constexpr u8 overlong_4 = 1 << 6;
+    // 10______ 10______
+    constexpr u8 two_conts = 1 << 7;
+    // The classes that depend only on the high nibble of the first byte.
+    constexpr u8 carry = too_short | too_long | two_conts;
+
+    [[nodiscard]] __m256i table(u8 const t0, u8 const t1, u8 const t2,
+                                u8 const t3, u8 const t4, u8 const t5,
+                                u8 const t6, u8 const t7, u8 const t8,
+                                u8 const t9, u8 const t10, u8 const t11,
+                                u8 const t12, u8 const t13, u8 const t14,
+                                u8 const t15)
+    {
+      // The shuffle looks up each 128-bit lane separately.
+      return _mm256_setr_epi8(t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11,
+                              t12, t13, t14, t15, t0, t1, t2, t3, t4, t5, t6,
+                              t7, t8, t9, t10, t11, t12, t13, t14, t15);
+    }
+
+    [[nodiscard]] __m256i high_nibbles(__m256i const v)
+    {
+      return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F));
+    }
+
+    [[nodiscard]] __m256i low_nibbles(__m256i const v)
+    {
+      return _mm256_and_si256(v, _mm256_set1_epi8(0x0F));
+    }
+
+    // previous
+    // The bytes of input shifted up by N bytes with the last N bytes of
+    // previous_input shifted in.
+    //
+    template<i32 N>
+    [[nodiscard]] __m256i previous(__m256i const input,
+                                   __m256i const previous_input)
+    {
+      __m256i const straddle =
+        _mm256_permute2x128_si256(previous_input, input, 0x21);
+      return _mm256_alignr_epi8(input, straddle, 16 - N);
+    }
+
+    [[nodiscard]] __m256i classify_pairs(__m256i const input,
+                                         __m256i const previous1)
+    {
+      __m256i const byte_1_high = _mm256_shuffle_epi8(
+        table(too_long, too_long, too_long, too_long, too_long, too_long,
+              too_long, too_long, two_conts, two_conts, two_conts, two_conts,
+              too_short | overlong_2, too_short,
+              too_short | overlong_3 | surrogate,
+              too_short | too_large | too_large_1000 | overlong_4),
+        high_nibbles(previous1));
+      constexpr u8 large = carry | too_large | too_large_1000;
+      __m256i const byte_1_low = _mm256_shuffle_epi8(
+        table(carry | overlong_3 | overlong_2 | overlong_4, carry | overlong_2,
+              carry, carry, carry | too_large, large, large, large, large,
+              large, large, large, large, large | surrogate, large, large),
+        low_nibbles(previous1));
+      constexpr u8 continuation_1000 = too_long | overlong_2 | two_conts |
+                                       overlong_3 | too_large_1000 |
+                                       overlong_4;
+      constexpr u8 continuation_1001 =
+        too_long | overlong_2 | two_conts | overlong_3 | too_large;
+      constexpr u8 continuation_101 =
+        too_long | overlong_2 | two_conts | surrogate | too_large;
+      __m256i const byte_2_high = _mm256_shuffle_epi8(
+        table(too_short, too_short, too_short, too_short, too_short, too_short,
+              too_short, too_short, continuation_1000, continuation_1001,
+              continuation_101, continuation_101, too_short, too_short,
+              too_short, too_short),
+        high_nibbles(input));
+      return _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low),
+                              byte_2_high);
+    }
+
+    // UTF8_Validator
+    // Accumulates the errors of consecutive 32-byte blocks.
+    //
+    struct UTF8_Validator {
+      __m256i error = _mm256_setzero_si256();
+      __m256i previous_input = _mm256_setzero_si256();
+      // Nonzero when the previous block ends in the middle of a sequence.
+      __m256i previous_incomplete = _mm256_setzero_si256();
+
+      void check_block(__m256i const input)
+      {
+        if(_mm256_movemask_epi8(input) == 0) {
+          // An ASCII block is valid unless it interrupts a sequence.
+          error = _mm256_or_si256(error, previous_incomplete);
+        } else {
+          __m256i const previous1 = previous<1>(input, previous_input);
+          __m256i const special_cases = classify_pairs(input, previous1);
+          // The third and fourth bytes of the 3 and 4-byte sequences are
+          // continuations which the pairs classify as two_conts. They must be
+          // preceded by a 3 or 4-byte leading byte 2 or 3 bytes earlier.
+          __m256i const previous2 = previous<2>(input, previous_input);
+          __m256i const previous3 = previous<3>(input, previous_input);
+          __m256i const is_third_byte =
+            _mm256_subs_epu8(previous2, _mm256_set1_epi8(0xE0u - 0x80));
+          __m256i const is_fourth_byte =
+            _mm256_subs_epu8(previous3, _mm256_set1_epi8(0xF0u - 0x80));
+          __m256i const must_be_continuation =
+            _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte),
+                             _mm256_set1_epi8(static_cast<char>(0x80)));
+          error = _mm256_or_si256(
+            error, _mm256_xor_si256(must_be_continuation, special_cases));
+          // A leading byte in the last 3 bytes whose sequence does not fit.
+          __m256i const max_value = _mm256_setr_epi8(
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0xF0u - 1,
+            0xE0u - 1, 0xC0u - 1);
+          previous_incomplete = _mm256_subs_epu8(input, max_value);
+        }
+        previous_input = input;
+      }
+
+      [[nodiscard]] bool finish() const
+      {
+        __m256i const result = _mm256_or_si256(error, previous_incomplete);
+        return _mm256_testz_si256(result, result) != 0;
+      }
+    };
+  } // namespace
+
+  bool validate_utf8_avx2(char8 const* const data, i64 const size)
+  {
+    UTF8_Validator validator;
+    i64 i = 0;
+    for(; i + 32 <= size; i += 32) {
+      validator.check_block(AVX2::load(data + i));
+    }
+
+    if(i < size) {
+      // Pad the last block with zeros. A sequence cut short by the padding
+      // is reported as too_short.
+      alignas(32) char8 block[32] = {};
+      for(i64 j = 0; i + j < size; ++j) {
+        block[j] = data[i + j];
+      }
+      validator.check_block(AVX2::load(block));
+    }
+    return validator.finish();
+  }
+
+  bool validate_ascii_avx2(char8 const* const data, i64 const size)
+  {
+    __m256i accumulator = _mm256_setzero_si256();
+    i64 i = 0;
+    for(; i + 32 <= size; i += 32) {
+      accumulator = _mm256_or_si256(accumulator, AVX2::load(data + i));
+    }
+
+    if(_mm256_movemask_epi8(accumulator) != 0) {
+      return false;
+    }
+
+    for(; i < size; ++i) {
+      if(static_cast<u8>(data[i]) >= 0x80) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  i64 count_utf8_code_points_avx2(char8 const* const data, i64 const size)
+  {
+    // The continuation bytes are [0x80, 0xBF], i.e. [-128, -65] as signed.
+    __m256i const max_continuation = _mm256_set1_epi8(-65);
+    i64 result = 0;
+    i64 i = 0;
+    while(i + 128 <= size) {
+      // Matching lanes are all ones, i.e. -1. Subtracting them increments the
+      // 8-bit counters. Every iteration adds at most 4, hence the counters are
+      // summed every 63 iterations before they might overflow.
+      __m256i accumulator = _mm256_setzero_si256();
+      for(i64 n = 0; n < 63 && i + 128 <= size; ++n, i += 128) {
+        __m256i const c0 =
+          _mm256_cmpgt_epi8(AVX2::load(data + i), max_continuation);
+        __m256i const c1 =
+          _mm256_cmpgt_epi8(AVX2::load(data + i + 32), max_continuation);
+        __m256i const c2 =
+          _mm256_cmpgt_epi8(AVX2::load(data + i + 64), max_continuation);
+        __m256i const c3 =
+          _mm256_cmpgt_epi8(AVX2::load(data + i + 96), max_continuation);
+        accumulator = _mm256_sub_epi8(
+          accumulator,
+          _mm256_add_epi8(_mm256_add_epi8(c0, c1), _mm256_add_epi8(c2, c3)));
+      }
+
+      u64 sums[4];
+      AVX2::store(sums, _mm256_sad_epu8(accumulator, _mm256_setzero_si256()));
+      result += static_cast<i64>(sums[0] + sums[1] + sums[2] + sums[3]);
+    }
+
+    for(; i < size; ++i) {
+      result += (data[i] & 0xC0) != 0x80;
+    }
+    return result;
+  }
+} // namespace anton::simd
+
+#endif
@@ -13,30 +13,84 @@
 #include <stdio.h> // sprintf
 
 namespace anton {
-  constexpr i64 min_allocation_size = 64;
+  [[maybe_unused]] static void
+  verify_encoding(detail::String_Storage const& storage)
+  {
+    ANTON_FAIL(unicode::validate_utf8(storage.data(), storage.size()),
+               u8"string is not valid UTF-8");
+  }
+
+  // get_null_terminated_length
+  // The number of code units preceding the null-terminator.
+  //
+  template<typename T>
+  [[nodiscard]] static i64 get_null_terminated_length(T const* const string)
+  {
+    i64 length = 0;
+    while(string[length] != 0) {
+      length += 1;
+    }
+    return length;
+  }
+
+  // transcode_to_string
+  // Converts source to UTF-8 in a single pass. The capacity starts at 1 byte
+  // per code unit, which fits ASCII exactly, and grows geometrically whenever
+  // the next code point does not fit.
+  //
+  template<typename T, typename Transcode>
+  [[nodiscard]] static String transcode_to_string(T const* const source,
+                                                  i64 const length,
+                                                  Transcode const transcode)
+  {
+    String str{anton::reserve, length};
+    i64 read = 0;
+    i64 written = 0;
+    while(true) {
+      // Leave space for the null-terminator.
+      i64 const available = str.capacity() - 1 - written;
+      unicode::Transcode_Result const result = transcode(
+        source + read, length - read, str.data() + written, available);
+      read += result.read;
+      written += result.written;
+      str.force_size(written);
+      if(read == length) {
+        return str;
+      }
+
+      // Every code point fits in 4 bytes. Nothing read despite enough space
+      // means the rest of the source cannot be converted.
+      ANTON_FAIL(result.read > 0 || available < 4,
+                 u8"source cannot be converted");
+
+      // A code point takes at most 4 bytes.
+      str.ensure_capacity(written + 4);
+    }
+  }
 
   String String::from_utf32(char32 const* string, i64 const length)
   {
-    i64 const buffer_size =
-      unicode::convert_utf32_to_utf8(string, length, nullptr);
-    // null-terminator is present when length == -1 in which case we have to
-    // subtract it from the size since String automatically takes care of that.
-    i64 const str_size = (length == -1 ? buffer_size - 1 : buffer_size);
-    String str{anton::reserve, str_size};
-    str.force_size(str_size);
-    unicode::convert_utf32_to_utf8(string, length, str.data());
-    return str;
+    // The null-terminator is not converted since String maintains its own.
+    i64 const string_length =
+      length != -1 ? length / 4 : get_null_terminated_length(string);
+    if constexpr(ANTON_UNICODE_VALIDATE_ENCODING) {
+      ANTON_FAIL(unicode::validate_utf32(string, string_length),
+                 u8"invalid UTF-32");
+    }
+    return transcode_to_string(string, string_length,
+                               unicode::transcode_utf32_to_utf8);
   }
 
   String String::from_utf16(char16 const* string, i64 const length)
   {
-    i64 const buffer_size =
-      unicode::convert_utf16_to_utf8(string, length, nullptr);
-    i64 const str_size = (length == -1 ? buffer_size - 1 : buffer_size);
-    String str{anton::reserve, str_size};
-    str.force_size(str_size);
-    unicode::convert_utf16_to_utf8(string, length, str.data());
-    return str;
+    i64 const string_length =
+      length != -1 ? length / 2 : get_null_terminated_length(string);
+    if constexpr(ANTON_UNICODE_VALIDATE_ENCODING) {
+      ANTON_FAIL(unicode::validate_utf16(string, string_length),
+                 u8"invalid UTF-16");
+    }
+    return transcode_to_string(string, string_length,
+                               unicode::transcode_utf16_to_utf8);
   }
 
   String::String(): _allocator() {}
@@ -51,9 +105,11 @@ namespace anton {
   String::String(Reserve_Tag, size_type n, allocator_type const& allocator)
     : _allocator(allocator)
   {
-    _capacity = math::max(min_allocation_size - 1, n) + 1;
-    _data = (value_type*)_allocator.allocate(_capacity, alignof(value_type));
-    zero_memory(_data, _data + _capacity);
+    if(n >= detail::String_Storage::inline_capacity) {
+      _storage.reserve_exact(
+        _allocator,
+        math::max(detail::String_Storage::min_allocation_size, n + 1));
+    }
   }
 
   String::String(value_type const* cstr): String(cstr, allocator_type()) {}
@@ -61,14 +117,10 @@ namespace anton {
   String::String(value_type const* cstr, allocator_type const& allocator)
     : _allocator(allocator)
   {
-    _size = strlen(cstr);
-    _capacity = math::max(min_allocation_size - 1, _size) + 1;
-    _data = (value_type*)_allocator.allocate(_capacity, alignof(value_type));
-    zero_memory(_data + _size, _data + _capacity);
-    copy(cstr, cstr + _size, _data);
+    _storage.assign(_allocator, cstr, strlen(cstr));
 
     if constexpr(ANTON_STRING_VERIFY_ENCODING) {
-      // TODO: Implement
+      verify_encoding(_storage);
     }
   }
 
@@ -82,15 +134,11 @@ namespace anton {
     : _allocator(allocator)
   {
     if(n > 0) {
-      _size = n;
-      _capacity = math::max(min_allocation_size - 1, _size) + 1;
-      _data = (value_type*)_allocator.allocate(_capacity, alignof(value_type));
-      zero_memory(_data + _size, _data + _capacity);
-      copy(cstr, cstr + n, _data);
+      _storage.assign(_allocator, cstr, n);
     }
 
     if constexpr(ANTON_STRING_VERIFY_ENCODING) {
-      // TODO: Implement
+      verify_encoding(_storage);
     }
   }
 
@@ -103,16 +151,12 @@ namespace anton {
                  allocator_type const& allocator)
     : _allocator(allocator)
   {
-    _size = last - first;
-    if(_size > 0) {
-      _capacity = math::max(min_allocation_size - 1, _size) + 1;
-      _data = (value_type*)_allocator.allocate(_capacity, alignof(value_type));
-      zero_memory(_data + _size, _data + _capacity);
-      copy(first, last, _data);
+    if(last - first > 0) {
+      _storage.assign(_allocator, first, last - first);
     }
 
     if constexpr(ANTON_STRING_VERIFY_ENCODING) {
-      // TODO: Implement
+      verify_encoding(_storage);
     }
   }
 
@@ -121,97 +165,60 @@ namespace anton {
   String::String(String_View const sv, allocator_type const& allocator)
     : _allocator(allocator)
   {
-    _size = sv.size_bytes();
-    if(_size > 0) {
-      _capacity = math::max(min_allocation_size - 1, _size) + 1;
-      _data = (value_type*)_allocator.allocate(_capacity, alignof(value_type));
-      zero_memory(_data + _size, _data + _capacity);
-      copy(sv.bytes_begin(), sv.bytes_end(), _data);
-    }
+    _storage.assign(_allocator, sv.data(), sv.size_bytes());
 
     if constexpr(ANTON_STRING_VERIFY_ENCODING) {
-      // TODO: Implement
+      verify_encoding(_storage);
     }
   }
 
   String::String(String const& other): String(other, allocator_type()) {}
 
   String::String(String const& other, allocator_type const& allocator)
-    : _allocator(allocator), _capacity(other._capacity), _size(other._size)
+    : _allocator(allocator)
   {
-    if(_capacity > 0) {
-      _data = (value_type*)_allocator.allocate(_capacity, alignof(value_type));
-      zero_memory(_data + _size, _data + _capacity);
-      copy(other._data, other._data + other._size, _data);
-    }
+    _storage.assign(_allocator, other.data(), other.size_bytes());
 
     if constexpr(ANTON_STRING_VERIFY_ENCODING) {
-      // TODO: Implement
+      verify_encoding(_storage);
     }
   }
 
   String::String(String&& other)
-    : _allocator(ANTON_MOV(other._allocator)), _data(other._data),
-      _capacity(other._capacity), _size(other._size)
+    : _allocator(ANTON_MOV(other._allocator)),
+      _storage(ANTON_MOV(other._storage))
   {
-    other._data = nullptr;
-    other._size = 0;
-    other._capacity = 0;
     if constexpr(ANTON_STRING_VERIFY_ENCODING) {
-      // TODO: Implement
+      verify_encoding(_storage);
     }
   }
 
   String::String(String&& other, allocator_type const& allocator)
     : _allocator(allocator)
   {
-    if(_allocator == other._allocator) {
-      _data = other._data;
-      other._data = nullptr;
-      _capacity = other._capacity;
-      other._capacity = 0;
-      _size = other._size;
-      other._size = 0;
+    // Inline strings do not own memory and are always taken over.
+    if(_allocator == other._allocator || other._storage.is_inline()) {
+      swap(_storage, other._storage);
     } else {
-      if(other._capacity > 0) {
-        _size = other._size;
-        _capacity = other._capacity;
-        _data =
-          (value_type*)_allocator.allocate(_capacity, alignof(value_type));
-        zero_memory(_data + _size, _data + _capacity);
-        move(other._data, other._data + other._size, _data);
-      }
+      _storage.assign(_allocator, other.data(), other.size_bytes());
     }
 
     if constexpr(ANTON_STRING_VERIFY_ENCODING) {
-      // TODO: Implement
+      verify_encoding(_storage);
     }
   }
 
   String::~String()
   {
-    _allocator.deallocate(_data, _capacity, alignof(value_type));
+    _storage.release(_allocator);
   }
 
   String& String::operator=(String const& other)
   {
-    if(other._size + 1 > _capacity) {
-      value_type* const new_data =
-        (value_type*)_allocator.allocate(other._capacity, alignof(value_type));
-      zero_memory(new_data + other._size, new_data + other._capacity);
-      copy(other._data, other._data + other._size, new_data);
-      _allocator.deallocate(_data, _capacity, alignof(value_type));
-      _data = new_data;
-      _capacity = other._capacity;
-      _size = other._size;
-    } else {
-      zero_memory(_data + other._size, _data + _capacity);
-      copy(other._data, other._data + other._size, _data);
-      _size = other._size;
-    }
+    _storage.assign(_allocator, other.data(), other.size_bytes());
 
     if constexpr(ANTON_STRING_VERIFY_ENCODING) {
-      // TODO: Implement
+      verify_encoding(_storage);
     }
 
     return *this;
@@ -221,7 +228,7 @@ namespace anton {
   {
     swap(*this, other);
     if constexpr(ANTON_STRING_VERIFY_ENCODING) {
-      // TODO: Implement
+      verify_encoding(_storage);
     }
 
     return *this;
@@ -229,32 +236,11 @@ namespace anton {
 
   String& String::operator=(String_View const sv)
   {
-    size_type const new_size = sv.size_bytes();
-    if(new_size + 1 > _capacity) {
-      size_type new_capacity = min_allocation_size;
-      while(new_capacity < new_size + 1) {
-        new_capacity *= 2;
-      }
-
-      // The String_View can not possibly point to our own memory
-      // (self-assignment) because its size is greater than our capacity.
-      value_type* const new_data =
-        (value_type*)_allocator.allocate(new_capacity, alignof(value_type));
-      zero_memory(new_data + new_size, new_data + new_capacity);
-      copy(sv.data(), sv.data() + sv.size_bytes(), new_data);
-      _allocator.deallocate(_data, _capacity, alignof(value_type));
-      _data = new_data;
-      _capacity = new_capacity;
-      _size = new_size;
-    } else {
-      // The String_View may point to our own memory!
-      zero_memory(_data + new_size, _data + _capacity);
-      copy(sv.data(), sv.data() + sv.size_bytes(), _data);
-      _size = new_size;
-    }
+    // The String_View may point to our own memory which assign handles.
+    _storage.assign(_allocator, sv.data(), sv.size_bytes());
 
     if constexpr(ANTON_STRING_VERIFY_ENCODING) {
-      // TODO: Implement
+      verify_encoding(_storage);
     }
 
     return *this;
@@ -268,7 +254,7 @@ namespace anton {
 
   String::operator String_View() const
   {
-    return {_data, _size};
+    return {_storage.data(), _storage.size()};
   }
 
   String::allocator_type& String::get_allocator()
@@ -283,162 +269,148 @@ namespace anton {
 
   auto String::data() -> value_type*
   {
-    return _data;
+    return _storage.data();
   }
 
   auto String::data() const -> value_type const*
   {
-    return _data;
+    return _storage.data();
   }
 
   auto String::c_str() -> value_type*
   {
-    return _data;
+    return _storage.data();
   }
 
   auto String::c_str() const -> value_type const*
   {
-    return _data;
+    return _storage.data();
   }
 
   auto String::bytes() -> UTF8_Bytes
   {
-    return {_data, _data + _size};
+    value_type* const data = _storage.data();
+    return {data, data + _storage.size()};
   }
 
   auto String::bytes() const -> UTF8_Const_Bytes
   {
-    return {_data, _data + _size};
+    value_type const* const data = _storage.data();
+    return {data, data + _storage.size()};
   }
 
   auto String::const_bytes() const -> UTF8_Const_Bytes
   {
-    return {_data, _data + _size};
+    value_type const* const data = _storage.data();
+    return {data, data + _storage.size()};
   }
 
   auto String::chars() const -> UTF8_Chars
   {
-    return {_data, _data + _size};
+    value_type const* const data = _storage.data();
+    return {data, data + _storage.size()};
   }
 
   auto String::bytes_begin() -> byte_iterator
   {
-    return _data;
+    return _storage.data();
   }
 
   auto String::bytes_begin() const -> byte_const_iterator
   {
-    return _data;
+    return const_cast<value_type*>(_storage.data());
   }
 
   auto String::bytes_cbegin() const -> byte_const_iterator
   {
-    return _data;
+    return const_cast<value_type*>(_storage.data());
   }
 
   auto String::bytes_end() -> byte_iterator
   {
-    return _data + _size;
+    return _storage.data() + _storage.size();
   }
 
   auto String::bytes_end() const -> byte_const_iterator
   {
-    return _data + _size;
+    return const_cast<value_type*>(_storage.data()) + _storage.size();
   }
 
   auto String::bytes_cend() const -> byte_const_iterator
   {
-    return _data + _size;
+    return const_cast<value_type*>(_storage.data()) + _storage.size();
   }
 
   auto String::chars_begin() const -> char_iterator
   {
-    return char_iterator{_data, 0};
+    return char_iterator{_storage.data(), 0};
   }
 
   auto String::chars_end() const -> char_iterator
   {
-    return char_iterator{_data + _size, _size};
+    i64 const size = _storage.size();
+    return char_iterator{_storage.data() + size, size};
   }
 
   auto String::capacity() const -> size_type
   {
-    return _capacity;
+    return _storage.capacity();
   }
 
   auto String::size_bytes() const -> size_type
   {
-    return _size;
+    return _storage.size();
   }
 
   auto String::size_utf8() const -> size_type
   {
-    return chars_end() - chars_begin();
+    return unicode::get_utf32_length_from_utf8(_storage.data(),
+                                               _storage.size());
   }
 
   void String::ensure_capacity(size_type const requested_capacity)
   {
-    if(requested_capacity >= _capacity) {
-      size_type new_capacity =
-        (_capacity > 0 ? _capacity : min_allocation_size);
-      while(new_capacity <= requested_capacity) {
-        new_capacity *= 2;
-      }
-
-      value_type* new_data =
-        (value_type*)_allocator.allocate(new_capacity, alignof(value_type));
-      zero_memory(new_data + _size, new_data + new_capacity);
-      move(_data, _data + _size, new_data);
-      _allocator.deallocate(_data, _capacity, alignof(value_type));
-      _data = new_data;
-      _capacity = new_capacity;
-    }
+    _storage.reserve(_allocator, requested_capacity);
   }
 
   void String::ensure_capacity_exact(size_type const requested_capacity)
   {
-    if(requested_capacity > _capacity) {
-      value_type* new_data = (value_type*)_allocator.allocate(
-        requested_capacity, alignof(value_type));
-      zero_memory(new_data + _size, new_data + requested_capacity);
-      move(_data, _data + _size, new_data);
-      _allocator.deallocate(_data, _capacity, alignof(value_type));
-      _data = new_data;
-      _capacity = requested_capacity;
-    }
+    _storage.reserve_exact(_allocator, requested_capacity);
   }
 
   void String::force_size(size_type n)
   {
-    _size = n;
+    _storage.set_size(n);
   }
 
   void String::clear()
   {
-    zero_memory(_data, _data + _size);
-    _size = 0;
+    _storage.clear();
   }
 
   void String::append(char8 const c)
   {
-    ensure_capacity(_size + 1);
-    _data[_size] = c;
-    _size += 1;
+    i64 const size = _storage.size();
+    _storage.reserve(_allocator, size + 1);
+    _storage.data()[size] = c;
+    _storage.set_size(size + 1);
   }
 
   void String::append(char32 const c)
   {
-    ensure_capacity(_size + 4);
+    i64 const size = _storage.size();
+    _storage.reserve(_allocator, size + 4);
     i64 const bytes_written =
-      unicode::convert_utf32_to_utf8(&c, 4, _data + _size);
-    _size += bytes_written;
+      unicode::convert_utf32_to_utf8(&c, 4, _storage.data() + size);
+    _storage.set_size(size + bytes_written);
   }
 
   void String::append(String_View str)
   {
-    ensure_capacity(_size + str.size_bytes());
-    copy(str.bytes_begin(), str.bytes_end(), _data + _size);
-    _size += str.size_bytes();
+    i64 const size = _storage.size();
+    _storage.reserve(_allocator, size + str.size_bytes());
+    copy(str.bytes_begin(), str.bytes_end(), _storage.data() + size);
+    _storage.set_size(size + str.size_bytes());
   }
 
   inline namespace literals {
@@ -452,9 +424,7 @@ namespace anton {
   {
     if(str1._allocator == str2._allocator) {
       swap(str1._allocator, str2._allocator);
-      swap(str1._data, str2._data);
-      swap(str1._capacity, str2._capacity);
-      swap(str1._size, str2._size);
+      swap(str1._storage, str2._storage);
     } else {
       // Move operations call swap, which could lead to an endless loop
       String temp{str1};
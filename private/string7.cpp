@@ -14,7 +14,12 @@
 #include <stdio.h> // sprintf
 
 namespace anton {
-  constexpr i64 min_allocation_size = 64;
+  [[maybe_unused]] static void
+  verify_encoding(detail::String_Storage const& storage)
+  {
+    ANTON_FAIL(unicode::validate_ascii(storage.data(), storage.size()),
+               u8"string is not valid ASCII");
+  }
 
   String7::String7(): _allocator() {}
 
@@ -28,9 +33,11 @@ namespace anton {
   String7::String7(Reserve_Tag, size_type n, allocator_type const& allocator)
     : _allocator(allocator)
   {
-    _capacity = math::max(min_allocation_size - 1, n) + 1;
-    _data = (value_type*)_allocator.allocate(_capacity, alignof(value_type));
-    zero_memory(_data, _data + _capacity);
+    if(n >= detail::String_Storage::inline_capacity) {
+      _storage.reserve_exact(
+        _allocator,
+        math::max(detail::String_Storage::min_allocation_size, n + 1));
+    }
   }
 
   String7::String7(value_type const* cstr): String7(cstr, allocator_type()) {}
@@ -38,14 +45,10 @@ namespace anton {
   String7::String7(value_type const* cstr, allocator_type const& allocator)
     : _allocator(allocator)
   {
-    _size = strlen(cstr);
-    _capacity = math::max(min_allocation_size - 1, _size) + 1;
-    _data = (value_type*)_allocator.allocate(_capacity, alignof(value_type));
-    zero_memory(_data + _size, _data + _capacity);
-    copy(cstr, cstr + _size, _data);
+    _storage.assign(_allocator, cstr, strlen(cstr));
 
     if constexpr(ANTON_STRING_VERIFY_ENCODING) {
-      // TODO: Implement
+      verify_encoding(_storage);
     }
   }
 
@@ -59,15 +62,11 @@ namespace anton {
     : _allocator(allocator)
   {
     if(n > 0) {
-      _size = n;
-      _capacity = math::max(min_allocation_size - 1, _size) + 1;
-      _data = (value_type*)_allocator.allocate(_capacity, alignof(value_type));
-      zero_memory(_data + _size, _data + _capacity);
-      copy(cstr, cstr + n, _data);
+      _storage.assign(_allocator, cstr, n);
     }
 
     if constexpr(ANTON_STRING_VERIFY_ENCODING) {
-      // TODO: Implement
+      verify_encoding(_storage);
     }
   }
 
@@ -78,17 +77,14 @@ namespace anton {
 
   String7::String7(value_type const* first, value_type const* last,
                    allocator_type const& allocator)
+    : _allocator(allocator)
   {
-    _size = last - first;
-    if(_size > 0) {
-      _capacity = math::max(min_allocation_size - 1, _size) + 1;
-      _data = (value_type*)_allocator.allocate(_capacity, alignof(value_type));
-      zero_memory(_data + _size, _data + _capacity);
-      copy(first, last, _data);
+    if(last - first > 0) {
+      _storage.assign(_allocator, first, last - first);
     }
 
     if constexpr(ANTON_STRING_VERIFY_ENCODING) {
-      // TODO: Implement
+      verify_encoding(_storage);
     }
   }
 
@@ -97,97 +93,60 @@ namespace anton {
   String7::String7(String7_View const sv, allocator_type const& allocator)
     : _allocator(allocator)
   {
-    _size = sv.size();
-    if(_size > 0) {
-      _capacity = math::max(min_allocation_size - 1, _size) + 1;
-      _data = (value_type*)_allocator.allocate(_capacity, alignof(value_type));
-      zero_memory(_data + _size, _data + _capacity);
-      copy(sv.begin(), sv.end(), _data);
-    }
+    _storage.assign(_allocator, sv.data(), sv.size());
 
     if constexpr(ANTON_STRING_VERIFY_ENCODING) {
-      // TODO: Implement
+      verify_encoding(_storage);
     }
   }
 
   String7::String7(String7 const& other): String7(other, allocator_type()) {}
 
   String7::String7(String7 const& other, allocator_type const& allocator)
-    : _allocator(allocator), _capacity(other._capacity), _size(other._size)
+    : _allocator(allocator)
   {
-    if(_capacity > 0) {
-      _data = (value_type*)_allocator.allocate(_capacity, alignof(value_type));
-      zero_memory(_data + _size, _data + _capacity);
-      copy(other._data, other._data + other._size, _data);
-    }
+    _storage.assign(_allocator, other.data(), other.size());
 
     if constexpr(ANTON_STRING_VERIFY_ENCODING) {
-      // TODO: Implement
+      verify_encoding(_storage);
     }
   }
 
   String7::String7(String7&& other)
-    : _allocator(ANTON_MOV(other._allocator)), _data(other._data),
-      _capacity(other._capacity), _size(other._size)
+    : _allocator(ANTON_MOV(other._allocator)),
+      _storage(ANTON_MOV(other._storage))
   {
-    other._data = nullptr;
-    other._size = 0;
-    other._capacity = 0;
     if constexpr(ANTON_STRING_VERIFY_ENCODING) {
-      // TODO: Implement
+      verify_encoding(_storage);
     }
   }
 
   String7::String7(String7&& other, allocator_type const& allocator)
     : _allocator(allocator)
   {
-    if(_allocator == other._allocator) {
-      _data = other._data;
-      other._data = nullptr;
-      _capacity = other._capacity;
-      other._capacity = 0;
-      _size = other._size;
-      other._size = 0;
+    // Inline strings do not own memory and are always taken over.
+    if(_allocator == other._allocator || other._storage.is_inline()) {
+      swap(_storage, other._storage);
     } else {
-      if(other._capacity > 0) {
-        _size = other._size;
-        _capacity = other._capacity;
-        _data =
-          (value_type*)_allocator.allocate(_capacity, alignof(value_type));
-        zero_memory(_data + _size, _data + _capacity);
-        move(other._data, other._data + other._size, _data);
-      }
+      _storage.assign(_allocator, other.data(), other.size());
     }
 
     if constexpr(ANTON_STRING_VERIFY_ENCODING) {
-      // TODO: Implement
+      verify_encoding(_storage);
     }
   }
 
   String7::~String7()
   {
-    _allocator.deallocate(_data, _capacity, alignof(value_type));
+    _storage.release(_allocator);
   }
 
   String7& String7::operator=(String7 const& other)
   {
-    if(other._size + 1 > _capacity) {
-      value_type* const new_data =
-        (value_type*)_allocator.allocate(other._capacity, alignof(value_type));
-      zero_memory(new_data + other._size, new_data + other._capacity);
-      copy(other._data, other._data + other._size, new_data);
-      _allocator.deallocate(_data, _capacity, alignof(value_type));
-      _data = new_data;
-      _capacity = other._capacity;
-      _size = other._size;
-    } else {
-      zero_memory(_data + other._size, _data + _capacity);
-      copy(other._data, other._data + other._size, _data);
-      _size = other._size;
-    }
+    _storage.assign(_allocator, other.data(), other.size());
 
     if constexpr(ANTON_STRING_VERIFY_ENCODING) {
-      // TODO: Implement
+      verify_encoding(_storage);
     }
 
     return *this;
@@ -197,7 +156,7 @@ namespace anton {
   {
     swap(*this, other);
     if constexpr(ANTON_STRING_VERIFY_ENCODING) {
-      // TODO: Implement
+      verify_encoding(_storage);
     }
 
     return *this;
@@ -205,32 +164,11 @@ namespace anton {
 
   String7& String7::operator=(String7_View const sv)
   {
-    size_type const new_size = sv.size();
-    if(new_size + 1 > _capacity) {
-      size_type new_capacity = min_allocation_size;
-      while(new_capacity < new_size + 1) {
-        new_capacity *= 2;
-      }
-
-      // The String7_View can not possibly point to our own memory
-      // (self-assignment) because its size is greater than our capacity.
-      value_type* const new_data =
-        (value_type*)_allocator.allocate(new_capacity, alignof(value_type));
-      zero_memory(new_data + new_size, new_data + new_capacity);
-      copy(sv.data(), sv.data() + sv.size(), new_data);
-      _allocator.deallocate(_data, _capacity, alignof(value_type));
-      _data = new_data;
-      _capacity = new_capacity;
-      _size = new_size;
-    } else {
-      // The String7_View may point to our own memory!
-      zero_memory(_data + new_size, _data + _capacity);
-      copy(sv.data(), sv.data() + sv.size(), _data);
-      _size = new_size;
-    }
+    // The String7_View may point to our own memory which assign handles.
+    _storage.assign(_allocator, sv.data(), sv.size());
 
     if constexpr(ANTON_STRING_VERIFY_ENCODING) {
-      // TODO: Implement
+      verify_encoding(_storage);
     }
 
     return *this;
@@ -244,7 +182,7 @@ namespace anton {
 
   String7::operator String7_View() const
   {
-    return {_data, _size};
+    return {_storage.data(), _storage.size()};
   }
 
   String7::allocator_type& String7::get_allocator()
@@ -260,122 +198,102 @@ namespace anton {
   auto String7::operator[](size_type const index) const -> value_type
   {
     if constexpr(ANTON_ITERATOR_DEBUG) {
-      ANTON_FAIL(index < _size && index >= 0, u8"index out of bounds");
+      ANTON_FAIL(index < _storage.size() && index >= 0,
+                 u8"index out of bounds");
     }
 
-    return _data[index];
+    return _storage.data()[index];
   }
 
   auto String7::data() -> value_type*
   {
-    return _data;
+    return _storage.data();
   }
 
   auto String7::data() const -> value_type const*
   {
-    return _data;
+    return _storage.data();
   }
 
   auto String7::c_str() const -> value_type const*
   {
-    return _data;
+    return _storage.data();
   }
 
   auto String7::begin() -> iterator
   {
-    return _data;
+    return _storage.data();
   }
 
   auto String7::begin() const -> const_iterator
   {
-    return _data;
+    return const_cast<value_type*>(_storage.data());
   }
 
   auto String7::cbegin() const -> const_iterator
   {
-    return _data;
+    return const_cast<value_type*>(_storage.data());
   }
 
   auto String7::end() -> iterator
   {
-    return _data + _size;
+    return _storage.data() + _storage.size();
   }
 
   auto String7::end() const -> const_iterator
   {
-    return _data + _size;
+    return const_cast<value_type*>(_storage.data()) + _storage.size();
   }
 
   auto String7::cend() const -> const_iterator
   {
-    return _data + _size;
+    return const_cast<value_type*>(_storage.data()) + _storage.size();
   }
 
   auto String7::capacity() const -> size_type
   {
-    return _capacity;
+    return _storage.capacity();
   }
 
   auto String7::size() const -> size_type
   {
-    return _size;
+    return _storage.size();
   }
 
   void String7::ensure_capacity(size_type const requested_capacity)
   {
-    if(requested_capacity >= _capacity) {
-      size_type new_capacity =
-        (_capacity > 0 ? _capacity : min_allocation_size);
-      while(new_capacity <= requested_capacity) {
-        new_capacity *= 2;
-      }
-
-      value_type* new_data =
-        (value_type*)_allocator.allocate(new_capacity, alignof(value_type));
-      zero_memory(new_data + _size, new_data + new_capacity);
-      move(_data, _data + _size, new_data);
-      _allocator.deallocate(_data, _capacity, alignof(value_type));
-      _data = new_data;
-      _capacity = new_capacity;
-    }
+    _storage.reserve(_allocator, requested_capacity);
   }
 
   void String7::ensure_capacity_exact(size_type const requested_capacity)
   {
-    if(requested_capacity > _capacity) {
-      value_type* new_data = (value_type*)_allocator.allocate(
-        requested_capacity, alignof(value_type));
-      zero_memory(new_data + _size, new_data + requested_capacity);
-      move(_data, _data + _size, new_data);
-      _allocator.deallocate(_data, _capacity, alignof(value_type));
-      _data = new_data;
-      _capacity = requested_capacity;
-    }
+    _storage.reserve_exact(_allocator, requested_capacity);
   }
 
   void String7::force_size(size_type n)
   {
-    _size = n;
+    _storage.set_size(n);
   }
 
   void String7::clear()
   {
-    zero_memory(_data, _data + _size);
-    _size = 0;
+    _storage.clear();
   }
 
   void String7::append(char8 const c)
   {
-    ensure_capacity(_size + 1);
-    _data[_size] = c;
-    _size += 1;
+    i64 const size = _storage.size();
+    _storage.reserve(_allocator, size + 1);
+    _storage.data()[size] = c;
+    _storage.set_size(size + 1);
   }
 
   void String7::append(String7_View str)
   {
-    ensure_capacity(_size + str.size());
-    copy(str.begin(), str.end(), _data + _size);
-    _size += str.size();
+    i64 const size = _storage.size();
+    _storage.reserve(_allocator, size + str.size());
+    copy(str.begin(), str.end(), _storage.data() + size);
+    _storage.set_size(size + str.size());
   }
 
   inline namespace literals {
@@ -389,9 +307,7 @@ namespace anton {
   {
     if(str1._allocator == str2._allocator) {
       swap(str1._allocator, str2._allocator);
-      swap(str1._data, str2._data);
-      swap(str1._capacity, str2._capacity);
-      swap(str1._size, str2._size);
+      swap(str1._storage, str2._storage);
     } else {
       // Move operations call swap, which could lead to an endless loop
       String7 temp{str1};
@@ -92,6 +92,40 @@ namespace anton {
     return (*this) += -n;
   }
 
+  UTF8_Char_Iterator::difference_type operator-(UTF8_Char_Iterator const& lhs,
+                                                UTF8_Char_Iterator const& rhs)
+  {
+    char8 const* const lhs_data = lhs.get_underlying_pointer();
+    char8 const* const rhs_data = rhs.get_underlying_pointer();
+    if(lhs.get_offset() >= 0 && rhs.get_offset() >= 0) {
+      // Both iterators point at code point boundaries within the string,
+      // hence the code points between them are the bytes that are not
+      // continuation bytes.
+      if(lhs_data < rhs_data) {
+        return -unicode::get_utf32_length_from_utf8(lhs_data,
+                                                    rhs_data - lhs_data);
+      } else {
+        return unicode::get_utf32_length_from_utf8(rhs_data,
+                                                   lhs_data - rhs_data);
+      }
+    }
+
+    UTF8_Char_Iterator::difference_type difference = 0;
+    UTF8_Char_Iterator i = rhs;
+    if(lhs < i) {
+      while(lhs != i) {
+        --i;
+        difference -= 1;
+      }
+    } else {
+      while(lhs != i) {
+        ++i;
+        difference += 1;
+      }
+    }
+    return difference;
+  }
+
   UTF8_Char_Iterator::value_type UTF8_Char_Iterator::operator*() const
   {
     char32 const c = unicode::convert_codepoint_utf8_to_utf32(_data);
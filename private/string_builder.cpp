@@ -0,0 +1,230 @@
+#include <anton/string_builder.hpp>
+
+#include <anton/assert.hpp>
+#include <anton/detail/crt.hpp>
+#include <anton/swap.hpp>
+#include <anton/unicode/common.hpp>
+
+namespace anton::detail {
+  // String_Builder_Chunk
+  // The header of a chunk. The bytes of the chunk follow the header.
+  //
+  struct String_Builder_Chunk {
+    String_Builder_Chunk* next;
+    i64 size;
+    i64 capacity;
+  };
+} // namespace anton::detail
+
+namespace anton {
+  using detail::String_Builder_Chunk;
+
+  [[nodiscard]] static char8* chunk_data(String_Builder_Chunk* const chunk)
+  {
+    return reinterpret_cast<char8*>(chunk + 1);
+  }
+
+  [[nodiscard]] static char8 const*
+  chunk_data(String_Builder_Chunk const* const chunk)
+  {
+    return reinterpret_cast<char8 const*>(chunk + 1);
+  }
+
+  String_Builder_Chunk_Iterator::String_Builder_Chunk_Iterator(
+    String_Builder_Chunk const* const chunk)
+    : _chunk(chunk)
+  {
+  }
+
+  String_Builder_Chunk_Iterator& String_Builder_Chunk_Iterator::operator++()
+  {
+    _chunk = _chunk->next;
+    return *this;
+  }
+
+  String_Builder_Chunk_Iterator String_Builder_Chunk_Iterator::operator++(int)
+  {
+    String_Builder_Chunk_Iterator copy = *this;
+    ++(*this);
+    return copy;
+  }
+
+  String_View String_Builder_Chunk_Iterator::operator*() const
+  {
+    ANTON_ASSERT(_chunk != nullptr, u8"dereferencing end iterator");
+    char8 const* const data = chunk_data(_chunk);
+    return String_View{data, data + _chunk->size};
+  }
+
+  String_Builder::String_Builder(): _allocator() {}
+
+  String_Builder::String_Builder(allocator_type const& allocator)
+    : _allocator(allocator)
+  {
+  }
+
+  String_Builder::String_Builder(String_Builder&& other)
+    : _allocator(ANTON_MOV(other._allocator)), _first(other._first),
+      _last(other._last), _size(other._size)
+  {
+    other._first = nullptr;
+    other._last = nullptr;
+    other._size = 0;
+  }
+
+  String_Builder::~String_Builder()
+  {
+    clear();
+  }
+
+  String_Builder& String_Builder::operator=(String_Builder&& other)
+  {
+    swap(*this, other);
+    return *this;
+  }
+
+  auto String_Builder::get_allocator() -> allocator_type&
+  {
+    return _allocator;
+  }
+
+  auto String_Builder::get_allocator() const -> allocator_type const&
+  {
+    return _allocator;
+  }
+
+  auto String_Builder::size_bytes() const -> size_type
+  {
+    return _size;
+  }
+
+  String_Builder_Chunk* String_Builder::add_chunk(i64 const min_capacity)
+  {
+    // Double the capacity with every chunk so that the number of chunks
+    // remains logarithmic in the size of the text until max_chunk_size.
+    i64 capacity = min_chunk_size;
+    if(_last != nullptr) {
+      capacity = _last->capacity * 2;
+      if(capacity > max_chunk_size) {
+        capacity = max_chunk_size;
+      }
+    }
+
+    if(capacity < min_capacity) {
+      capacity = min_capacity;
+    }
+
+    void* const memory = _allocator.allocate(
+      static_cast<i64>(sizeof(String_Builder_Chunk)) + capacity,
+      alignof(String_Builder_Chunk));
+    String_Builder_Chunk* const chunk =
+      static_cast<String_Builder_Chunk*>(memory);
+    chunk->next = nullptr;
+    chunk->size = 0;
+    chunk->capacity = capacity;
+    if(_last != nullptr) {
+      _last->next = chunk;
+    } else {
+      _first = chunk;
+    }
+    _last = chunk;
+    return chunk;
+  }
+
+  void String_Builder::append(String_View const string)
+  {
+    char8 const* data = string.data();
+    i64 size = string.size_bytes();
+    if(size == 0) {
+      return;
+    }
+
+    _size += size;
+    if(_last != nullptr) {
+      // Fill the last chunk before adding a new one. The pieces of a code
+      // point may end up in different chunks.
+      i64 const available = _last->capacity - _last->size;
+      i64 const count = available < size ? available : size;
+      memcpy(chunk_data(_last) + _last->size, data, count);
+      _last->size += count;
+      data += count;
+      size -= count;
+      if(size == 0) {
+        return;
+      }
+    }
+
+    String_Builder_Chunk* const chunk = add_chunk(size);
+    memcpy(chunk_data(chunk), data, size);
+    chunk->size = size;
+  }
+
+  void String_Builder::append(char8 const c)
+  {
+    String_Builder_Chunk* chunk = _last;
+    if(chunk == nullptr || chunk->size == chunk->capacity) {
+      chunk = add_chunk(1);
+    }
+
+    chunk_data(chunk)[chunk->size] = c;
+    chunk->size += 1;
+    _size += 1;
+  }
+
+  void String_Builder::append(char32 const c)
+  {
+    char8 buffer[4];
+    i64 const size = unicode::convert_utf32_to_utf8(&c, 4, buffer);
+    append(String_View{buffer, size});
+  }
+
+  void String_Builder::clear()
+  {
+    String_Builder_Chunk* chunk = _first;
+    while(chunk != nullptr) {
+      String_Builder_Chunk* const next = chunk->next;
+      _allocator.deallocate(
+        chunk, static_cast<i64>(sizeof(String_Builder_Chunk)) + chunk->capacity,
+        alignof(String_Builder_Chunk));
+      chunk = next;
+    }
+    _first = nullptr;
+    _last = nullptr;
+    _size = 0;
+  }
+
+  Range<String_Builder_Chunk_Iterator> String_Builder::chunks() const
+  {
+    return Range(String_Builder_Chunk_Iterator(_first),
+                 String_Builder_Chunk_Iterator());
+  }
+
+  String String_Builder::to_string() const
+  {
+    String result(reserve, _size, _allocator);
+    char8* destination = result.data();
+    for(String_Builder_Chunk const* chunk = _first; chunk != nullptr;
+        chunk = chunk->next) {
+      memcpy(destination, chunk_data(chunk), chunk->size);
+      destination += chunk->size;
+    }
+    result.force_size(_size);
+    return result;
+  }
+
+  void String_Builder::write_to(Output_Stream& stream) const
+  {
+    for(String_Builder_Chunk const* chunk = _first; chunk != nullptr;
+        chunk = chunk->next) {
+      stream.write(chunk_data(chunk), chunk->size);
+    }
+  }
+
+  void swap(String_Builder& lhs, String_Builder& rhs)
+  {
+    swap(lhs._allocator, rhs._allocator);
+    swap(lhs._first, rhs._first);
+    swap(lhs._last, rhs._last);
+    swap(lhs._size, rhs._size);
+  }
+} // namespace anton
@@ -0,0 +1,234 @@
+#include <anton/string_pool.hpp>
+
+#include <anton/detail/crt.hpp>
+#include <anton/swap.hpp>
+
+namespace anton {
+  namespace detail {
+    namespace {
+      struct Empty_Interned_String {
+        Interned_String_Entry entry;
+        char8 terminator;
+      };
+
+      constexpr Empty_Interned_String empty_entry{{hash(String_View()), 0},
+                                                  u8'\0'};
+    } // namespace
+
+    Interned_String_Entry const* const empty_interned_string =
+      &empty_entry.entry;
+  } // namespace detail
+
+  using detail::Interned_String_Entry;
+
+  // The capacity of the table once the first string is stored.
+  constexpr i64 string_pool_min_capacity = 64;
+
+  String_Pool::String_Pool(): _table() {}
+
+  // The arena is initialized after the table, therefore it may obtain the
+  // allocator from the table.
+  String_Pool::String_Pool(allocator_type const& allocator)
+    : _table(allocator), _arena(_table.get_allocator().get_wrapped_allocator())
+  {
+  }
+
+  String_Pool::String_Pool(String_Pool&& other)
+    : _table(ANTON_MOV(other._table)), _arena(ANTON_MOV(other._arena)),
+      _size(other._size)
+  {
+    other._size = 0;
+  }
+
+  String_Pool& String_Pool::operator=(String_Pool&& other)
+  {
+    swap(*this, other);
+    return *this;
+  }
+
+  i64 String_Pool::find_slot(String_View const string, u64 const hash) const
+  {
+    i64 const size = string.size_bytes();
+    i64 const mask = _table.size() - 1;
+    for(i64 i = static_cast<i64>(hash) & mask;; i = (i + 1) & mask) {
+      Interned_String_Entry const* const entry = _table[i];
+      if(entry == nullptr) {
+        return i;
+      }
+
+      if(entry->hash == hash && entry->size == size &&
+         memcmp(reinterpret_cast<char8 const*>(entry) +
+                  sizeof(Interned_String_Entry),
+                string.data(), size) == 0) {
+        return i;
+      }
+    }
+  }
+
+  void String_Pool::grow()
+  {
+    i64 const capacity = _table.size() > 0 ? 2 * _table.size()
+                                           : string_pool_min_capacity;
+    Array<Interned_String_Entry const*> table(get_allocator());
+    table.resize(capacity, nullptr);
+    i64 const mask = capacity - 1;
+    for(Interned_String_Entry const* const entry: _table) {
+      if(entry == nullptr) {
+        continue;
+      }
+
+      i64 i = static_cast<i64>(entry->hash) & mask;
+      while(table[i] != nullptr) {
+        i = (i + 1) & mask;
+      }
+      table[i] = entry;
+    }
+    swap(_table, table);
+  }
+
+  Interned_String String_Pool::intern(String_View const string)
+  {
+    return intern(string, anton::hash(string));
+  }
+
+  Interned_String String_Pool::intern(String_View const string,
+                                      u64 const hash)
+  {
+    i64 const size = string.size_bytes();
+    if(size == 0) {
+      return Interned_String();
+    }
+
+    if(2 * (_size + 1) > _table.size()) {
+      grow();
+    }
+
+    i64 const slot = find_slot(string, hash);
+    if(_table[slot] != nullptr) {
+      return Interned_String(_table[slot]);
+    }
+
+    void* const memory =
+      _arena.allocate(static_cast<i64>(sizeof(Interned_String_Entry)) + size +
+                        1,
+                      alignof(Interned_String_Entry));
+    Interned_String_Entry* const entry =
+      static_cast<Interned_String_Entry*>(memory);
+    entry->hash = hash;
+    entry->size = size;
+    char8* const data =
+      static_cast<char8*>(memory) + sizeof(Interned_String_Entry);
+    memcpy(data, string.data(), size);
+    data[size] = u8'\0';
+    _table[slot] = entry;
+    _size += 1;
+    return Interned_String(entry);
+  }
+
+  Optional<Interned_String> String_Pool::find(String_View const string) const
+  {
+    return find(string, anton::hash(string));
+  }
+
+  Optional<Interned_String> String_Pool::find(String_View const string,
+                                              u64 const hash) const
+  {
+    if(string.size_bytes() == 0) {
+      return Interned_String();
+    }
+
+    if(_size == 0) {
+      return null_optional;
+    }
+
+    i64 const slot = find_slot(string, hash);
+    if(_table[slot] != nullptr) {
+      return Interned_String(_table[slot]);
+    } else {
+      return null_optional;
+    }
+  }
+
+  i64 String_Pool::size() const
+  {
+    return _size;
+  }
+
+  i64 String_Pool::owned_memory() const
+  {
+    return _arena.owned_memory() +
+           _table.capacity() *
+             static_cast<i64>(sizeof(Interned_String_Entry const*));
+  }
+
+  auto String_Pool::get_allocator() -> allocator_type&
+  {
+    return _table.get_allocator();
+  }
+
+  auto String_Pool::get_allocator() const -> allocator_type const&
+  {
+    return _table.get_allocator();
+  }
+
+  void swap(String_Pool& lhs, String_Pool& rhs)
+  {
+    swap(lhs._table, rhs._table);
+    swap(lhs._arena, rhs._arena);
+    swap(lhs._size, rhs._size);
+  }
+
+  static void lock(Atomic<bool>& locked)
+  {
+    while(locked.exchange(true, Memory_Order::acquire)) {
+      while(locked.load(Memory_Order::relaxed)) {
+        cpu_relax();
+      }
+    }
+  }
+
+  static void unlock(Atomic<bool>& locked)
+  {
+    locked.store(false, Memory_Order::release);
+  }
+
+  // The shard of a string is selected by the high bits of its hash, which
+  // are independent of the low bits that select the slot in the shard.
+  [[nodiscard]] static i64 select_shard(u64 const hash)
+  {
+    static_assert(Concurrent_String_Pool::shard_count == 64);
+    return static_cast<i64>(hash >> 58);
+  }
+
+  Interned_String Concurrent_String_Pool::intern(String_View const string)
+  {
+    u64 const hash = anton::hash(string);
+    Shard& shard = _shards[select_shard(hash)];
+    lock(shard.locked);
+    Interned_String const result = shard.pool.intern(string, hash);
+    unlock(shard.locked);
+    return result;
+  }
+
+  Optional<Interned_String>
+  Concurrent_String_Pool::find(String_View const string)
+  {
+    u64 const hash = anton::hash(string);
+    Shard& shard = _shards[select_shard(hash)];
+    lock(shard.locked);
+    Optional<Interned_String> result = shard.pool.find(string, hash);
+    unlock(shard.locked);
+    return result;
+  }
+
+  i64 Concurrent_String_Pool::size()
+  {
+    i64 result = 0;
+    for(Shard& shard: _shards) {
+      lock(shard.locked);
+      result += shard.pool.size();
+      unlock(shard.locked);
+    }
+    return result;
+  }
+} // namespace anton
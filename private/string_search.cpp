@@ -0,0 +1,284 @@
+#include <anton/detail/string_search.hpp>
+
+#include <anton/detail/string_common.hpp>
+#include <simd/sse2.hpp>
+#include <simd/string.hpp>
+
+namespace anton::detail {
+  // Substrings up to this size are searched with the vectorized filter first.
+  constexpr i64 short_substring_size = 32;
+
+  namespace {
+    // Byte_Sequence
+    // Accesses bytes in order or, when Reverse is true, in reverse order. The
+    // last occurrence of a substring is the first occurrence of the reversed
+    // substring in the reversed string.
+    //
+    template<bool Reverse>
+    struct Byte_Sequence {
+      u8 const* data;
+      i64 size;
+
+      [[nodiscard]] u8 operator[](i64 const i) const
+      {
+        if constexpr(Reverse) {
+          return data[size - 1 - i];
+        } else {
+          return data[i];
+        }
+      }
+    };
+
+    // maximal_suffix
+    // Computes the maximal suffix of substr with respect to the byte order or
+    // the reversed byte order if Greater is false.
+    //
+    // Returns:
+    // The position preceding the suffix. The period of the suffix is written
+    // to period.
+    //
+    template<bool Greater, bool Reverse>
+    [[nodiscard]] i64 maximal_suffix(Byte_Sequence<Reverse> const substr,
+                                     i64& period)
+    {
+      i64 i = -1;
+      i64 j = 0;
+      i64 k = 1;
+      period = 1;
+      while(j + k < substr.size) {
+        u8 const a = substr[i + k];
+        u8 const b = substr[j + k];
+        if(a == b) {
+          if(k == period) {
+            j += period;
+            k = 1;
+          } else {
+            k += 1;
+          }
+        } else if(Greater ? a > b : a < b) {
+          j += k;
+          k = 1;
+          period = j - i;
+        } else {
+          i = j;
+          j += 1;
+          k = 1;
+          period = 1;
+        }
+      }
+      return i;
+    }
+
+    template<bool Reverse>
+    void build_table(Two_Way_Table& table, Byte_Sequence<Reverse> const substr)
+    {
+      i64 const size = substr.size;
+      for(i64 c = 0; c < 256; ++c) {
+        table.shift[c] = 0;
+      }
+
+      for(i64 i = 0; i < size; ++i) {
+        table.shift[substr[i]] = i + 1;
+      }
+
+      // The critical factorization is given by the longer of the maximal
+      // suffixes with respect to both orders.
+      i64 period_greater;
+      i64 const suffix_greater = maximal_suffix<true>(substr, period_greater);
+      i64 period_less;
+      i64 const suffix_less = maximal_suffix<false>(substr, period_less);
+      i64 suffix = suffix_greater;
+      i64 period = period_greater;
+      if(suffix_less > suffix_greater) {
+        suffix = suffix_less;
+        period = period_less;
+      }
+
+      // The substring is periodic when the left half occurs again one period
+      // later.
+      bool periodic = true;
+      for(i64 i = 0; i <= suffix; ++i) {
+        if(substr[i] != substr[i + period]) {
+          periodic = false;
+          break;
+        }
+      }
+
+      table.suffix = suffix;
+      if(periodic) {
+        table.period = period;
+        table.memory = size - period;
+      } else {
+        table.period =
+          (suffix > size - suffix - 1 ? suffix : size - suffix - 1) + 1;
+        table.memory = 0;
+      }
+    }
+
+    // two_way
+    //
+    // Returns:
+    // The position of the first occurrence of substr in string or npos.
+    //
+    template<bool Reverse>
+    [[nodiscard]] i64 two_way(Two_Way_Table const& table,
+                              Byte_Sequence<Reverse> const string,
+                              Byte_Sequence<Reverse> const substr)
+    {
+      i64 const size = substr.size;
+      i64 const suffix = table.suffix;
+      // The length of the prefix of the window known to match.
+      i64 memory = 0;
+      i64 position = 0;
+      while(position + size <= string.size) {
+        // Skip by the last byte of the window.
+        i64 const shift = size - table.shift[string[position + size - 1]];
+        if(shift != 0) {
+          position += shift > memory ? shift : memory;
+          memory = 0;
+          continue;
+        }
+
+        // Compare the right half.
+        i64 k = suffix + 1 > memory ? suffix + 1 : memory;
+        while(k < size && substr[k] == string[position + k]) {
+          k += 1;
+        }
+
+        if(k < size) {
+          position += k - suffix;
+          memory = 0;
+          continue;
+        }
+
+        // Compare the left half.
+        k = suffix + 1;
+        while(k > memory && substr[k - 1] == string[position + k - 1]) {
+          k -= 1;
+        }
+
+        if(k <= memory) {
+          return position;
+        }
+
+        position += table.period;
+        memory = table.memory;
+      }
+      return npos;
+    }
+
+    [[nodiscard]] simd::Substring_Filter_Result
+    filter_forward(char8 const* const string, i64 const size,
+                   char8 const* const substr, i64 const substr_size)
+    {
+#if ANTON_SIMD_X86
+      if(size >= 64 && simd::cpu_supports_avx2()) {
+        return simd::find_substring_avx2(string, size, substr, substr_size);
+      } else {
+        return simd::find_substring<simd::SSE2>(string, size, substr,
+                                                substr_size);
+      }
+#else
+      return {0, true};
+#endif
+    }
+
+    [[nodiscard]] simd::Substring_Filter_Result
+    filter_backward(char8 const* const string, i64 const size,
+                    char8 const* const substr, i64 const substr_size)
+    {
+#if ANTON_SIMD_X86
+      if(size >= 64 && simd::cpu_supports_avx2()) {
+        return simd::find_last_substring_avx2(string, size, substr,
+                                              substr_size);
+      } else {
+        return simd::find_last_substring<simd::SSE2>(string, size, substr,
+                                                     substr_size);
+      }
+#else
+      return {size - substr_size + 1, true};
+#endif
+    }
+  } // namespace
+
+  void build_two_way_table(Two_Way_Table& table, char8 const* const substr,
+                           i64 const substr_size)
+  {
+    build_table(table,
+                Byte_Sequence<false>{reinterpret_cast<u8 const*>(substr),
+                                     substr_size});
+  }
+
+  i64 find_substring_bytes(char8 const* const string, i64 const size,
+                           char8 const* const substr, i64 const substr_size,
+                           Two_Way_Table const* table)
+  {
+    if(substr_size == 0) {
+      return 0;
+    }
+
+    if(substr_size > size) {
+      return npos;
+    }
+
+    i64 first = 0;
+    if(substr_size <= short_substring_size) {
+      simd::Substring_Filter_Result const result =
+        filter_forward(string, size, substr, substr_size);
+      if(!result.abandoned) {
+        return result.position;
+      }
+      first = result.position;
+    }
+
+    Two_Way_Table local_table;
+    if(table == nullptr) {
+      build_two_way_table(local_table, substr, substr_size);
+      table = &local_table;
+    }
+
+    i64 const position = two_way(
+      *table,
+      Byte_Sequence<false>{reinterpret_cast<u8 const*>(string + first),
+                           size - first},
+      Byte_Sequence<false>{reinterpret_cast<u8 const*>(substr), substr_size});
+    return position != npos ? first + position : npos;
+  }
+
+  i64 find_last_substring_bytes(char8 const* const string, i64 const size,
+                                char8 const* const substr,
+                                i64 const substr_size)
+  {
+    if(substr_size == 0) {
+      return size;
+    }
+
+    if(substr_size > size) {
+      return npos;
+    }
+
+    // The positions from end onwards have been examined.
+    i64 end = size - substr_size + 1;
+    if(substr_size <= short_substring_size) {
+      simd::Substring_Filter_Result const result =
+        filter_backward(string, size, substr, substr_size);
+      if(!result.abandoned) {
+        return result.position;
+      }
+      end = result.position;
+    }
+
+    // Search the reversed substring in the reversed string that ends before
+    // the position end.
+    i64 const remaining_size = end + substr_size - 1;
+    Byte_Sequence<true> const reversed_substr{
+      reinterpret_cast<u8 const*>(substr), substr_size};
+    Two_Way_Table table;
+    build_table(table, reversed_substr);
+    i64 const position = two_way(
+      table,
+      Byte_Sequence<true>{reinterpret_cast<u8 const*>(string), remaining_size},
+      reversed_substr);
+    return position != npos ? remaining_size - substr_size - position : npos;
+  }
+} // namespace anton::detail
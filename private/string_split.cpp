@@ -0,0 +1,178 @@
+#include <anton/string_split.hpp>
+
+#include <anton/algorithm.hpp>
+#include <anton/assert.hpp>
+#include <anton/detail/string_common.hpp>
+#include <anton/detail/string_search.hpp>
+#include <simd/string.hpp>
+
+namespace anton {
+  [[nodiscard]] static i64 find_any_ascii(char8 const* const string,
+                                          i64 const size, u8 const* const table)
+  {
+#if ANTON_SIMD_X86
+    if(size >= 32 && simd::cpu_supports_avx2()) {
+      return simd::find_any_ascii_avx2(string, size, table);
+    }
+#endif
+
+    // The set lookup needs a byte shuffle which SSE2 does not provide.
+    for(i64 i = 0; i < size; ++i) {
+      u8 const byte = static_cast<u8>(string[i]);
+      if(byte < 0x80 && (table[byte & 0x0F] >> (byte >> 4)) & 1) {
+        return i;
+      }
+    }
+    return size;
+  }
+
+  [[nodiscard]] static i64 find_byte(char8 const* const string, i64 const size,
+                                     char8 const byte)
+  {
+    return detail::simd_find(reinterpret_cast<u8 const*>(string), size,
+                             static_cast<u8>(byte));
+  }
+
+  Split_Iterator::Split_Iterator(String_View const string,
+                                 String_View const delimiter)
+    : _data(string.data()), _size(string.size_bytes()),
+      _delimiter(delimiter.data()), _delimiter_size(delimiter.size_bytes())
+  {
+    ANTON_ASSERT(_delimiter_size > 0, u8"delimiter must not be empty");
+    // Pretend a delimiter precedes the string and advance past it.
+    _piece_end = -_delimiter_size;
+    ++(*this);
+  }
+
+  Split_Iterator& Split_Iterator::operator++()
+  {
+    if(_piece_end == _size) {
+      _position = -1;
+      return *this;
+    }
+
+    _position = _piece_end + _delimiter_size;
+    char8 const* const remaining = _data + _position;
+    i64 const remaining_size = _size - _position;
+    if(_delimiter_size == 1) {
+      _piece_end =
+        _position + find_byte(remaining, remaining_size, *_delimiter);
+    } else {
+      i64 const index = detail::find_substring_bytes(
+        remaining, remaining_size, _delimiter, _delimiter_size);
+      _piece_end = index != npos ? _position + index : _size;
+    }
+    return *this;
+  }
+
+  Split_Iterator Split_Iterator::operator++(int)
+  {
+    Split_Iterator copy = *this;
+    ++(*this);
+    return copy;
+  }
+
+  String_View Split_Iterator::operator*() const
+  {
+    ANTON_ASSERT(_position != -1, u8"dereferencing end iterator");
+    return String_View{_data + _position, _data + _piece_end};
+  }
+
+  Split_Any_Iterator::Split_Any_Iterator(String_View const string,
+                                         String_View const delimiters)
+    : _data(string.data()), _size(string.size_bytes())
+  {
+    for(char8 const c: delimiters.bytes()) {
+      u8 const byte = static_cast<u8>(c);
+      ANTON_ASSERT(byte < 0x80, u8"delimiters must be ASCII");
+      _table[byte & 0x0F] |= static_cast<u8>(1 << (byte >> 4));
+    }
+    _piece_end = -1;
+    ++(*this);
+  }
+
+  Split_Any_Iterator& Split_Any_Iterator::operator++()
+  {
+    if(_piece_end == _size) {
+      _position = -1;
+      return *this;
+    }
+
+    _position = _piece_end + 1;
+    _piece_end =
+      _position + find_any_ascii(_data + _position, _size - _position, _table);
+    return *this;
+  }
+
+  Split_Any_Iterator Split_Any_Iterator::operator++(int)
+  {
+    Split_Any_Iterator copy = *this;
+    ++(*this);
+    return copy;
+  }
+
+  String_View Split_Any_Iterator::operator*() const
+  {
+    ANTON_ASSERT(_position != -1, u8"dereferencing end iterator");
+    return String_View{_data + _position, _data + _piece_end};
+  }
+
+  Line_Iterator::Line_Iterator(String_View const string)
+    : _data(string.data()), _size(string.size_bytes())
+  {
+    if(_size > 0) {
+      _position = 0;
+      _piece_end = find_byte(_data, _size, u8'\n');
+    }
+  }
+
+  Line_Iterator& Line_Iterator::operator++()
+  {
+    // The string ends with the current line or its terminator.
+    if(_piece_end >= _size - 1) {
+      _position = -1;
+      return *this;
+    }
+
+    _position = _piece_end + 1;
+    _piece_end =
+      _position + find_byte(_data + _position, _size - _position, u8'\n');
+    return *this;
+  }
+
+  Line_Iterator Line_Iterator::operator++(int)
+  {
+    Line_Iterator copy = *this;
+    ++(*this);
+    return copy;
+  }
+
+  String_View Line_Iterator::operator*() const
+  {
+    ANTON_ASSERT(_position != -1, u8"dereferencing end iterator");
+    // Only the '\r' of a "\r\n" terminator is stripped. The last line is
+    // not terminated if it reaches the end of the string.
+    i64 end = _piece_end;
+    if(end < _size && end > _position && _data[end - 1] == u8'\r') {
+      end -= 1;
+    }
+    return String_View{_data + _position, _data + end};
+  }
+
+  Range<Split_Iterator> split(String_View const string,
+                              String_View const delimiter)
+  {
+    return Range(Split_Iterator(string, delimiter), Split_Iterator());
+  }
+
+  Range<Split_Any_Iterator> split_any(String_View const string,
+                                      String_View const delimiters)
+  {
+    return Range(Split_Any_Iterator(string, delimiters), Split_Any_Iterator());
+  }
+
+  Range<Line_Iterator> lines(String_View const string)
+  {
+    return Range(Line_Iterator(string), Line_Iterator());
+  }
+} // namespace anton
@@ -0,0 +1,124 @@
+#include <anton/detail/string_storage.hpp>
+
+#include <anton/assert.hpp>
+#include <anton/detail/crt.hpp>
+#include <anton/math/math.hpp>
+
+namespace anton::detail {
+  static_assert(sizeof(String_Storage) == 24);
+#if defined(__BYTE_ORDER__)
+  // The tag byte must be the most significant byte of the heap capacity.
+  // MSVC targets only little-endian platforms.
+  static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+                "String_Storage requires a little-endian target");
+#endif
+
+  String_Storage::String_Storage(): _inline{} {}
+
+  String_Storage::String_Storage(String_Storage&& other)
+  {
+    memcpy(static_cast<void*>(this), &other, sizeof(String_Storage));
+    memset(static_cast<void*>(&other), 0, sizeof(String_Storage));
+  }
+
+  void String_Storage::set_size(i64 const n)
+  {
+    ANTON_ASSERT(n >= 0 && n < capacity(),
+                 u8"size does not leave space for the null-terminator");
+    if(is_inline()) {
+      _inline[tag_index] = static_cast<char8>(n);
+    } else {
+      _heap.size = n;
+    }
+  }
+
+  void String_Storage::reallocate(Polymorphic_Allocator& allocator,
+                                  i64 const new_capacity)
+  {
+    i64 const n = size();
+    char8* const new_data =
+      static_cast<char8*>(allocator.allocate(new_capacity, alignof(char8)));
+    memcpy(new_data, data(), n);
+    memset(new_data + n, 0, new_capacity - n);
+    if(!is_inline()) {
+      allocator.deallocate(_heap.data, capacity(), alignof(char8));
+    }
+
+    _heap.data = new_data;
+    _heap.size = n;
+    _heap.capacity = static_cast<u64>(new_capacity) | heap_flag;
+  }
+
+  void String_Storage::reserve(Polymorphic_Allocator& allocator, i64 const n)
+  {
+    i64 const current_capacity = capacity();
+    if(n >= current_capacity) {
+      i64 new_capacity =
+        is_inline() ? min_allocation_size : current_capacity;
+      while(new_capacity <= n) {
+        new_capacity *= 2;
+      }
+      reallocate(allocator, new_capacity);
+    }
+  }
+
+  void String_Storage::reserve_exact(Polymorphic_Allocator& allocator,
+                                     i64 const new_capacity)
+  {
+    if(new_capacity > capacity()) {
+      reallocate(allocator, new_capacity);
+    }
+  }
+
+  void String_Storage::assign(Polymorphic_Allocator& allocator,
+                              char8 const* const first, i64 const n)
+  {
+    if(n >= capacity()) {
+      // The bytes can not possibly be a part of the string because there
+      // are more of them than the capacity.
+      i64 const new_capacity = math::max(min_allocation_size, n + 1);
+      char8* const new_data =
+        static_cast<char8*>(allocator.allocate(new_capacity, alignof(char8)));
+      memcpy(new_data, first, n);
+      memset(new_data + n, 0, new_capacity - n);
+      release(allocator);
+      _heap.data = new_data;
+      _heap.size = n;
+      _heap.capacity = static_cast<u64>(new_capacity) | heap_flag;
+    } else {
+      char8* const destination = data();
+      i64 const old_size = size();
+      if(n > 0) {
+        memmove(destination, first, n);
+      }
+
+      if(old_size > n) {
+        memset(destination + n, 0, old_size - n);
+      }
+      set_size(n);
+    }
+  }
+
+  void String_Storage::clear()
+  {
+    memset(data(), 0, size());
+    set_size(0);
+  }
+
+  void String_Storage::release(Polymorphic_Allocator& allocator)
+  {
+    if(!is_inline()) {
+      allocator.deallocate(_heap.data, capacity(), alignof(char8));
+    }
+    memset(static_cast<void*>(this), 0, sizeof(String_Storage));
+  }
+
+  void swap(String_Storage& lhs, String_Storage& rhs)
+  {
+    // Both inline and heap strings may be relocated bytewise.
+    char8 temporary[sizeof(String_Storage)];
+    memcpy(temporary, &lhs, sizeof(String_Storage));
+    memcpy(static_cast<void*>(&lhs), &rhs, sizeof(String_Storage));
+    memcpy(static_cast<void*>(&rhs), temporary, sizeof(String_Storage));
+  }
+} // namespace anton::detail
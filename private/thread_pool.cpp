@@ -0,0 +1,384 @@
+#include <anton/thread_pool.hpp>
+
+#include <anton/assert.hpp>
+#include <anton/concurrent_queue.hpp>
+#include <anton/thread.hpp>
+
+namespace anton {
+  using detail::Task;
+
+  namespace {
+    struct Deque_Buffer {
+      // The buffer this buffer replaced. Thieves might still be reading from
+      // it, therefore we keep it alive until the deque is destroyed.
+      Deque_Buffer* retired = nullptr;
+      Atomic<Task*>* tasks = nullptr;
+      i64 mask = 0;
+
+      [[nodiscard]] Task* get(i64 const index) const
+      {
+        return tasks[index & mask].load(Memory_Order::relaxed);
+      }
+
+      void put(i64 const index, Task* const task)
+      {
+        tasks[index & mask].store(task, Memory_Order::relaxed);
+      }
+    };
+
+    [[nodiscard]] Deque_Buffer* create_deque_buffer(i64 const capacity)
+    {
+      Deque_Buffer* const buffer = new_obj<Deque_Buffer>();
+      buffer->mask = capacity - 1;
+      buffer->tasks = static_cast<Atomic<Task*>*>(
+        allocate(capacity * static_cast<i64>(sizeof(Atomic<Task*>)),
+                 alignof(Atomic<Task*>)));
+      for(i64 i = 0; i < capacity; ++i) {
+        construct(buffer->tasks + i, nullptr);
+      }
+      return buffer;
+    }
+
+    void destroy_deque_buffer(Deque_Buffer* const buffer)
+    {
+      deallocate(buffer->tasks);
+      delete_obj(buffer);
+    }
+
+    // Work_Stealing_Deque
+    // Chase-Lev deque as described in "Correct and Efficient Work-Stealing for
+    // Weak Memory Models" by Lê, Pop, Cohen and Zappa Nardelli. The owner
+    // pushes and takes tasks at the bottom, thieves steal from the top.
+    //
+    struct Work_Stealing_Deque {
+    public:
+      Work_Stealing_Deque(): _buffer(create_deque_buffer(256)) {}
+      Work_Stealing_Deque(Work_Stealing_Deque const&) = delete;
+      Work_Stealing_Deque& operator=(Work_Stealing_Deque const&) = delete;
+
+      ~Work_Stealing_Deque()
+      {
+        for(Deque_Buffer* buffer = _buffer.load(Memory_Order::relaxed);
+            buffer != nullptr;) {
+          Deque_Buffer* const retired = buffer->retired;
+          destroy_deque_buffer(buffer);
+          buffer = retired;
+        }
+      }
+
+      // push
+      // May only be called by the owner.
+      //
+      void push(Task* const task)
+      {
+        i64 const bottom = _bottom.load(Memory_Order::relaxed);
+        i64 const top = _top.load(Memory_Order::acquire);
+        Deque_Buffer* buffer = _buffer.load(Memory_Order::relaxed);
+        if(bottom - top > buffer->mask) {
+          buffer = grow(buffer, top, bottom);
+        }
+        buffer->put(bottom, task);
+        _bottom.store(bottom + 1, Memory_Order::release);
+      }
+
+      // take
+      // May only be called by the owner.
+      //
+      // Returns:
+      // The most recently pushed task or nullptr if the deque is empty.
+      //
+      [[nodiscard]] Task* take()
+      {
+        i64 const bottom = _bottom.load(Memory_Order::relaxed) - 1;
+        Deque_Buffer* const buffer = _buffer.load(Memory_Order::relaxed);
+        _bottom.store(bottom, Memory_Order::relaxed);
+        atomic_thread_fence(Memory_Order::seq_cst);
+        i64 top = _top.load(Memory_Order::relaxed);
+        if(top > bottom) {
+          // The deque is empty.
+          _bottom.store(bottom + 1, Memory_Order::relaxed);
+          return nullptr;
+        }
+
+        Task* task = buffer->get(bottom);
+        if(top == bottom) {
+          // The last task. Race against the thieves.
+          if(!_top.compare_exchange_strong(top, top + 1, Memory_Order::seq_cst,
+                                           Memory_Order::relaxed)) {
+            task = nullptr;
+          }
+          _bottom.store(bottom + 1, Memory_Order::relaxed);
+        }
+        return task;
+      }
+
+      // steal
+      // May be called by any thread.
+      //
+      // Returns:
+      // The oldest task or nullptr if the deque is empty or the steal lost a
+      // race.
+      //
+      [[nodiscard]] Task* steal()
+      {
+        i64 top = _top.load(Memory_Order::acquire);
+        atomic_thread_fence(Memory_Order::seq_cst);
+        i64 const bottom = _bottom.load(Memory_Order::acquire);
+        if(top >= bottom) {
+          return nullptr;
+        }
+
+        Deque_Buffer* const buffer = _buffer.load(Memory_Order::acquire);
+        Task* const task = buffer->get(top);
+        if(!_top.compare_exchange_strong(top, top + 1, Memory_Order::seq_cst,
+                                         Memory_Order::relaxed)) {
+          return nullptr;
+        }
+        return task;
+      }
+
+    private:
+      alignas(cache_line_size) Atomic<i64> _top = 0;
+      alignas(cache_line_size) Atomic<i64> _bottom = 0;
+      Atomic<Deque_Buffer*> _buffer;
+
+      Deque_Buffer* grow(Deque_Buffer* const buffer, i64 const top,
+                         i64 const bottom)
+      {
+        Deque_Buffer* const new_buffer =
+          create_deque_buffer((buffer->mask + 1) * 2);
+        for(i64 i = top; i < bottom; ++i) {
+          new_buffer->put(i, buffer->get(i));
+        }
+        new_buffer->retired = buffer;
+        _buffer.store(new_buffer, Memory_Order::release);
+        return new_buffer;
+      }
+    };
+  } // namespace
+
+  struct Thread_Pool::Implementation {
+    struct Worker {
+      Work_Stealing_Deque deque;
+      Implementation* pool = nullptr;
+      Thread thread;
+      u64 random_state = 0;
+
+      // next_random
+      // xorshift64 used to select the victims of stealing.
+      //
+      [[nodiscard]] u64 next_random()
+      {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        return random_state;
+      }
+    };
+
+    // The worker executing on the current thread or nullptr if the thread does
+    // not belong to any pool.
+    static thread_local Worker* current_worker;
+
+    Worker* workers = nullptr;
+    i64 worker_count = 0;
+    MPMC_Queue<Task*> injection_queue{4096};
+    Atomic<bool> running = true;
+    // Incremented whenever new work becomes available. Sleeping workers wait
+    // on it.
+    Atomic<i32> epoch = 0;
+    Atomic<i32> sleeping = 0;
+    // Selects the first victim of threads that do not belong to the pool.
+    Atomic<u64> external_steal_index = 0;
+
+    [[nodiscard]] Task* find_task(Worker* worker);
+    void notify();
+    static void run_task(Task* task);
+    static void worker_main(void* data);
+  };
+
+  thread_local Thread_Pool::Implementation::Worker*
+    Thread_Pool::Implementation::current_worker = nullptr;
+
+  Task* Thread_Pool::Implementation::find_task(Worker* const worker)
+  {
+    if(worker != nullptr) {
+      if(Task* const task = worker->deque.take()) {
+        return task;
+      }
+    }
+
+    if(Optional<Task*> task = injection_queue.try_pop()) {
+      return *task;
+    }
+
+    if(worker_count == 0) {
+      return nullptr;
+    }
+
+    // Start at a random victim to spread the thieves over the workers.
+    u64 const start =
+      worker != nullptr
+        ? worker->next_random()
+        : external_steal_index.fetch_add(1, Memory_Order::relaxed);
+    for(i64 i = 0; i < worker_count; ++i) {
+      Worker& victim =
+        workers[(start + static_cast<u64>(i)) % static_cast<u64>(worker_count)];
+      if(&victim == worker) {
+        continue;
+      }
+
+      if(Task* const task = victim.deque.steal()) {
+        return task;
+      }
+    }
+    return nullptr;
+  }
+
+  void Thread_Pool::Implementation::notify()
+  {
+    // The sequentially consistent increment of epoch followed by the load of
+    // sleeping pairs with the increment of sleeping followed by the load of
+    // epoch in wait_on_address in the worker, so that either we observe the
+    // sleeping worker or the worker observes the new epoch.
+    epoch.fetch_add(1, Memory_Order::seq_cst);
+    if(sleeping.load(Memory_Order::seq_cst) > 0) {
+      wake_one_on_address(epoch);
+    }
+  }
+
+  void Thread_Pool::Implementation::run_task(Task* const task)
+  {
+    Task_Group* const group = task->group;
+    task->execute(task);
+    group->_pending.fetch_sub(1, Memory_Order::acq_rel);
+  }
+
+  void Thread_Pool::Implementation::worker_main(void* const data)
+  {
+    constexpr i64 spin_count = 64;
+
+    Worker* const worker = static_cast<Worker*>(data);
+    Implementation* const pool = worker->pool;
+    current_worker = worker;
+    while(pool->running.load(Memory_Order::acquire)) {
+      Task* task = pool->find_task(worker);
+      for(i64 i = 0; task == nullptr && i < spin_count; ++i) {
+        cpu_relax();
+        task = pool->find_task(worker);
+      }
+
+      if(task != nullptr) {
+        run_task(task);
+        continue;
+      }
+
+      i32 const epoch = pool->epoch.load(Memory_Order::seq_cst);
+      // Recheck after reading the epoch so that we do not miss the work
+      // published in between.
+      task = pool->find_task(worker);
+      if(task != nullptr) {
+        run_task(task);
+        continue;
+      }
+
+      if(!pool->running.load(Memory_Order::seq_cst)) {
+        break;
+      }
+
+      pool->sleeping.fetch_add(1, Memory_Order::seq_cst);
+      wait_on_address(pool->epoch, epoch);
+      pool->sleeping.fetch_sub(1, Memory_Order::seq_cst);
+    }
+    current_worker = nullptr;
+  }
+
+  Thread_Pool::Thread_Pool(i64 const worker_count)
+    : _impl(new_obj<Implementation>())
+  {
+    ANTON_VERIFY(worker_count >= 0, "worker_count must not be negative");
+    _impl->worker_count = worker_count;
+    if(worker_count > 0) {
+      using Worker = Implementation::Worker;
+      _impl->workers = static_cast<Worker*>(allocate(
+        worker_count * static_cast<i64>(sizeof(Worker)), alignof(Worker)));
+      for(i64 i = 0; i < worker_count; ++i) {
+        Worker* const worker = construct(_impl->workers + i);
+        worker->pool = _impl;
+        worker->random_state = 0x9E3779B97F4A7C15ULL * static_cast<u64>(i + 1);
+      }
+      // Start the threads after all workers have been constructed since the
+      // workers steal from each other.
+      for(i64 i = 0; i < worker_count; ++i) {
+        Worker* const worker = _impl->workers + i;
+        worker->thread =
+          create_thread(&Implementation::worker_main, worker);
+      }
+    }
+  }
+
+  Thread_Pool::~Thread_Pool()
+  {
+    _impl->running.store(false, Memory_Order::seq_cst);
+    _impl->epoch.fetch_add(1, Memory_Order::seq_cst);
+    wake_all_on_address(_impl->epoch);
+    for(i64 i = 0; i < _impl->worker_count; ++i) {
+      join_thread(_impl->workers[i].thread);
+    }
+
+    // Tasks own their callables and are freed only by executing them. Run the
+    // tasks left in the deques and the injection queue. No other thread
+    // accesses the queues anymore, hence steal never loses a race and nullptr
+    // means that all queues are empty. The tasks may spawn further tasks
+    // which are drained as well.
+    while(Task* const task = _impl->find_task(nullptr)) {
+      Implementation::run_task(task);
+    }
+
+    destruct_n(_impl->workers, _impl->worker_count);
+    deallocate(_impl->workers);
+    delete_obj(_impl);
+  }
+
+  void Thread_Pool::wait(Task_Group& group)
+  {
+    using Worker = Implementation::Worker;
+    Worker* const current_worker = Implementation::current_worker;
+    Worker* const worker =
+      (current_worker != nullptr && current_worker->pool == _impl)
+        ? current_worker
+        : nullptr;
+    while(group._pending.load(Memory_Order::acquire) > 0) {
+      if(Task* const task = _impl->find_task(worker)) {
+        Implementation::run_task(task);
+      } else {
+        yield_thread();
+      }
+    }
+  }
+
+  i64 Thread_Pool::get_worker_count() const
+  {
+    return _impl->worker_count;
+  }
+
+  void Thread_Pool::submit(Task* const task)
+  {
+    Implementation::Worker* const worker = Implementation::current_worker;
+    if(worker != nullptr && worker->pool == _impl) {
+      worker->deque.push(task);
+    } else if(!_impl->injection_queue.try_push(task)) {
+      // The injection queue is full. Execute the task immediately instead of
+      // blocking the caller.
+      Implementation::run_task(task);
+      return;
+    }
+    _impl->notify();
+  }
+
+  Thread_Pool& get_default_thread_pool()
+  {
+    static Thread_Pool pool(get_hardware_concurrency() - 1);
+    return pool;
+  }
+} // namespace anton
@@ -1,8 +1,156 @@
 #include <anton/unicode/common.hpp>
 
+#include <anton/assert.hpp>
+#include <anton/detail/crt.hpp>
 #include <anton/math/math.hpp>
+#include <simd/sse2.hpp>
+#include <simd/unicode.hpp>
 
 namespace anton::unicode {
+  // Width of the words tested at once for ASCII by the scalar loops.
+  constexpr i64 ascii_word_size = 8;
+  constexpr u64 ascii_word_mask = 0x8080808080808080;
+
+  [[nodiscard]] static bool is_ascii_word(char8 const* const data)
+  {
+    u64 word;
+    memcpy(&word, data, ascii_word_size);
+    return (word & ascii_word_mask) == 0;
+  }
+
+  [[nodiscard]] static bool is_continuation(char8 const byte)
+  {
+    return (static_cast<u8>(byte) & 0xC0) == 0x80;
+  }
+
+  [[nodiscard]] static bool validate_utf8_scalar(char8 const* const data,
+                                                 i64 const size)
+  {
+    i64 i = 0;
+    while(i < size) {
+      if(i + ascii_word_size <= size && is_ascii_word(data + i)) {
+        i += ascii_word_size;
+        continue;
+      }
+
+      u8 const leading_byte = data[i];
+      if(leading_byte < 0x80) {
+        i += 1;
+      } else if(leading_byte < 0xC2) {
+        // A continuation or an overlong 2-byte sequence.
+        return false;
+      } else if(leading_byte < 0xE0) {
+        if(i + 1 >= size || !is_continuation(data[i + 1])) {
+          return false;
+        }
+        i += 2;
+      } else if(leading_byte < 0xF0) {
+        if(i + 2 >= size) {
+          return false;
+        }
+        // E0 must not encode an overlong sequence and ED must not encode a
+        // surrogate.
+        u8 const lower = leading_byte == 0xE0 ? 0xA0 : 0x80;
+        u8 const upper = leading_byte == 0xED ? 0x9F : 0xBF;
+        u8 const byte_2 = data[i + 1];
+        if(byte_2 < lower || byte_2 > upper || !is_continuation(data[i + 2])) {
+          return false;
+        }
+        i += 3;
+      } else if(leading_byte < 0xF5) {
+        if(i + 3 >= size) {
+          return false;
+        }
+        // F0 must not encode an overlong sequence and F4 must not encode a
+        // code point above U+10FFFF.
+        u8 const lower = leading_byte == 0xF0 ? 0x90 : 0x80;
+        u8 const upper = leading_byte == 0xF4 ? 0x8F : 0xBF;
+        u8 const byte_2 = data[i + 1];
+        if(byte_2 < lower || byte_2 > upper || !is_continuation(data[i + 2]) ||
+           !is_continuation(data[i + 3])) {
+          return false;
+        }
+        i += 4;
+      } else {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool validate_utf8(char8 const* const data, i64 const size)
+  {
+#if ANTON_SIMD_X86
+    if(size >= 32 && simd::cpu_supports_avx2()) {
+      return simd::validate_utf8_avx2(data, size);
+    }
+#endif
+    return validate_utf8_scalar(data, size);
+  }
+
+  bool validate_utf16(char16 const* const data, i64 const length)
+  {
+    for(i64 i = 0; i < length; ++i) {
+      char16 const code_unit = data[i];
+      if(code_unit >= 0xD800 && code_unit <= 0xDBFF) {
+        if(i + 1 >= length || data[i + 1] < 0xDC00 || data[i + 1] > 0xDFFF) {
+          return false;
+        }
+        i += 1;
+      } else if(code_unit >= 0xDC00 && code_unit <= 0xDFFF) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool validate_utf32(char32 const* const data, i64 const length)
+  {
+    for(i64 i = 0; i < length; ++i) {
+      char32 const codepoint = data[i];
+      if(codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool validate_ascii(char8 const* const data, i64 const size)
+  {
+#if ANTON_SIMD_X86
+    if(size >= 32 && simd::cpu_supports_avx2()) {
+      return simd::validate_ascii_avx2(data, size);
+    }
+#endif
+    i64 i = 0;
+    for(; i + ascii_word_size <= size; i += ascii_word_size) {
+      if(!is_ascii_word(data + i)) {
+        return false;
+      }
+    }
+
+    for(; i < size; ++i) {
+      if(static_cast<u8>(data[i]) >= 0x80) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // get_length_with_null_terminator
+  // The number of code units in a null-terminated string including the
+  // null-terminator.
+  //
+  template<typename T>
+  [[nodiscard]] static i64 get_length_with_null_terminator(T const* string)
+  {
+    i64 length = 1;
+    for(; *string != 0; ++string) {
+      length += 1;
+    }
+    return length;
+  }
+
   i64 get_byte_count_from_utf8_leading_byte(char8 const leading_byte)
   {
     u8 const leading_zeros = math::clz((u8)~leading_byte);
@@ -32,11 +180,9 @@ namespace anton::unicode {
   static char32 surrogate_pair_to_codepoint(char16 const high_surrogate,
                                             char16 const low_surrogate)
   {
-    // Subtract 0xD800 from high surrogate. Subtract 0xDC00 from low surrogate.
-    // Subtract 0x10000 from the merged surrogates.
-    // 0x35FDC00 = (0xD800 << 10) + 0xDC00 - 0x10000
+    // The surrogates carry 10 bits each of the code point less 0x10000.
     char32 const codepoint =
-      (((high_surrogate & 0x3FF) << 10) | (low_surrogate & 0x3FF)) - 0x35FDC00;
+      (((high_surrogate & 0x3FF) << 10) | (low_surrogate & 0x3FF)) + 0x10000;
     return codepoint;
   }
 
@@ -60,57 +206,501 @@ namespace anton::unicode {
     return {codepoint, byte_count};
   }
 
-  i64 convert_utf32_to_utf8(char32 const* buffer_utf32, i64 const count,
-                            char8* buffer_utf8)
+  // encode_utf8
+  // Writes the UTF-8 encoding of codepoint to out.
+  //
+  // Returns:
+  // The number of bytes written.
+  //
+  static i64 encode_utf8(char32 const codepoint, char8* const out)
   {
-    if constexpr(ANTON_UNICODE_VALIDATE_ENCODING) {
-      // TODO: Implement
+    if(codepoint <= 0x7F) {
+      out[0] = static_cast<char8>(codepoint);
+      return 1;
+    } else if(codepoint <= 0x7FF) {
+      out[0] = 0xC0 | (codepoint >> 6);
+      out[1] = 0x80 | (codepoint & 0x3F);
+      return 2;
+    } else if(codepoint <= 0xFFFF) {
+      out[0] = 0xE0 | (codepoint >> 12);
+      out[1] = 0x80 | ((codepoint >> 6) & 0x3F);
+      out[2] = 0x80 | (codepoint & 0x3F);
+      return 3;
+    } else {
+      out[0] = 0xF0 | (codepoint >> 18);
+      out[1] = 0x80 | ((codepoint >> 12) & 0x3F);
+      out[2] = 0x80 | ((codepoint >> 6) & 0x3F);
+      out[3] = 0x80 | (codepoint & 0x3F);
+      return 4;
     }
+  }
 
-    if(buffer_utf8 == nullptr) {
-      i64 bytes_read = 0;
-      i64 bytes = 0;
-      while(true) {
-        char32 const codepoint = *buffer_utf32;
-        i64 const byte_count =
-          get_utf8_bytes_count_in_utf32_codepoint(codepoint);
-        bytes_read += 4;
-        bytes += byte_count;
-        buffer_utf32 += 1;
-        if((count == -1 && codepoint == U'\0') ||
-           (count != -1 && bytes_read >= count)) {
-          return bytes;
+  // The ASCII kernels convert the longest prefix of source that consists of
+  // ASCII characters and return its length. On x86 the prefix is converted
+  // 16 or 32 characters at a time with SSE2, which is a part of the x86-64
+  // baseline. The remainder is converted by the scalar loops.
+
+  [[nodiscard]] static i64 ascii_utf8_to_utf16(char8 const* const source,
+                                               i64 const length,
+                                               char16* const destination)
+  {
+    i64 i = 0;
+#if ANTON_SIMD_X86
+    __m128i const zero = _mm_setzero_si128();
+    for(; i + 32 <= length; i += 32) {
+      __m128i const v0 = simd::SSE2::load(source + i);
+      __m128i const v1 = simd::SSE2::load(source + i + 16);
+      if(_mm_movemask_epi8(_mm_or_si128(v0, v1)) != 0) {
+        break;
+      }
+
+      simd::SSE2::store(destination + i, _mm_unpacklo_epi8(v0, zero));
+      simd::SSE2::store(destination + i + 8, _mm_unpackhi_epi8(v0, zero));
+      simd::SSE2::store(destination + i + 16, _mm_unpacklo_epi8(v1, zero));
+      simd::SSE2::store(destination + i + 24, _mm_unpackhi_epi8(v1, zero));
+    }
+#else
+    for(; i + ascii_word_size <= length && is_ascii_word(source + i);
+        i += ascii_word_size) {
+      for(i64 j = 0; j < ascii_word_size; ++j) {
+        destination[i + j] = static_cast<u8>(source[i + j]);
+      }
+    }
+#endif
+    for(; i < length && static_cast<u8>(source[i]) < 0x80; ++i) {
+      destination[i] = static_cast<u8>(source[i]);
+    }
+    return i;
+  }
+
+  [[nodiscard]] static i64 ascii_utf8_to_utf32(char8 const* const source,
+                                               i64 const length,
+                                               char32* const destination)
+  {
+    i64 i = 0;
+#if ANTON_SIMD_X86
+    __m128i const zero = _mm_setzero_si128();
+    for(; i + 16 <= length; i += 16) {
+      __m128i const v = simd::SSE2::load(source + i);
+      if(_mm_movemask_epi8(v) != 0) {
+        break;
+      }
+
+      __m128i const low = _mm_unpacklo_epi8(v, zero);
+      __m128i const high = _mm_unpackhi_epi8(v, zero);
+      simd::SSE2::store(destination + i, _mm_unpacklo_epi16(low, zero));
+      simd::SSE2::store(destination + i + 4, _mm_unpackhi_epi16(low, zero));
+      simd::SSE2::store(destination + i + 8, _mm_unpacklo_epi16(high, zero));
+      simd::SSE2::store(destination + i + 12, _mm_unpackhi_epi16(high, zero));
+    }
+#else
+    for(; i + ascii_word_size <= length && is_ascii_word(source + i);
+        i += ascii_word_size) {
+      for(i64 j = 0; j < ascii_word_size; ++j) {
+        destination[i + j] = static_cast<u8>(source[i + j]);
+      }
+    }
+#endif
+    for(; i < length && static_cast<u8>(source[i]) < 0x80; ++i) {
+      destination[i] = static_cast<u8>(source[i]);
+    }
+    return i;
+  }
+
+  [[nodiscard]] static i64 ascii_utf16_to_utf8(char16 const* const source,
+                                               i64 const length,
+                                               char8* const destination)
+  {
+    i64 i = 0;
+#if ANTON_SIMD_X86
+    __m128i const zero = _mm_setzero_si128();
+    __m128i const non_ascii = _mm_set1_epi16(static_cast<short>(0xFF80));
+    for(; i + 16 <= length; i += 16) {
+      __m128i const v0 = simd::SSE2::load(source + i);
+      __m128i const v1 = simd::SSE2::load(source + i + 8);
+      __m128i const bits = _mm_and_si128(_mm_or_si128(v0, v1), non_ascii);
+      if(_mm_movemask_epi8(_mm_cmpeq_epi16(bits, zero)) != 0xFFFF) {
+        break;
+      }
+
+      simd::SSE2::store(destination + i, _mm_packus_epi16(v0, v1));
+    }
+#endif
+    for(; i < length && source[i] < 0x80; ++i) {
+      destination[i] = static_cast<char8>(source[i]);
+    }
+    return i;
+  }
+
+  [[nodiscard]] static i64 ascii_utf32_to_utf8(char32 const* const source,
+                                               i64 const length,
+                                               char8* const destination)
+  {
+    i64 i = 0;
+#if ANTON_SIMD_X86
+    __m128i const zero = _mm_setzero_si128();
+    __m128i const non_ascii = _mm_set1_epi32(~0x7F);
+    for(; i + 16 <= length; i += 16) {
+      __m128i const v0 = simd::SSE2::load(source + i);
+      __m128i const v1 = simd::SSE2::load(source + i + 4);
+      __m128i const v2 = simd::SSE2::load(source + i + 8);
+      __m128i const v3 = simd::SSE2::load(source + i + 12);
+      __m128i const bits = _mm_and_si128(
+        _mm_or_si128(_mm_or_si128(v0, v1), _mm_or_si128(v2, v3)), non_ascii);
+      if(_mm_movemask_epi8(_mm_cmpeq_epi32(bits, zero)) != 0xFFFF) {
+        break;
+      }
+
+      // The values are below 0x80, therefore the saturating packs are exact.
+      simd::SSE2::store(destination + i,
+                        _mm_packus_epi16(_mm_packs_epi32(v0, v1),
+                                         _mm_packs_epi32(v2, v3)));
+    }
+#endif
+    for(; i < length && source[i] < 0x80; ++i) {
+      destination[i] = static_cast<char8>(source[i]);
+    }
+    return i;
+  }
+
+  // count_utf8_units
+  // Counts the code points in [data, data + size[, i.e. the bytes that are
+  // not continuation bytes. If Pairs is true, the code points encoded with 4
+  // bytes are counted twice because UTF-16 encodes them as surrogate pairs.
+  //
+  template<bool Pairs>
+  [[nodiscard]] static i64 count_utf8_units(char8 const* const data,
+                                            i64 const size)
+  {
+    i64 result = 0;
+    i64 i = 0;
+#if ANTON_SIMD_X86
+    __m128i const zero = _mm_setzero_si128();
+    // The continuation bytes are [0x80, 0xBF], i.e. [-128, -65] as signed.
+    __m128i const max_continuation = _mm_set1_epi8(-65);
+    __m128i const min_leading_4 = _mm_set1_epi8(static_cast<char>(0xF0));
+    while(i + 16 <= size) {
+      // Matching lanes are all ones, i.e. -1. Subtracting them increments the
+      // 8-bit counters, which are summed before they might overflow.
+      __m128i accumulator = zero;
+      for(i64 n = 0; n < 127 && i + 16 <= size; ++n, i += 16) {
+        __m128i const v = simd::SSE2::load(data + i);
+        accumulator =
+          _mm_sub_epi8(accumulator, _mm_cmpgt_epi8(v, max_continuation));
+        if constexpr(Pairs) {
+          __m128i const is_leading_4 =
+            _mm_cmpeq_epi8(_mm_max_epu8(v, min_leading_4), v);
+          accumulator = _mm_sub_epi8(accumulator, is_leading_4);
         }
       }
-    } else {
-      i64 bytes_read = 0;
-      i64 bytes_written = 0;
-      while(true) {
-        char32 const codepoint = *buffer_utf32;
-        i64 const byte_count =
-          get_utf8_bytes_count_in_utf32_codepoint(codepoint);
-        for(i64 i = 0; i < byte_count; ++i) {
-          char8 const mask = (0x7F & (!!i - 1)) | (0x3F & (!i - 1));
-          char8 const byte = (codepoint >> (6 * i)) & mask;
-          buffer_utf8[i] = byte;
+
+      __m128i const sums = _mm_sad_epu8(accumulator, zero);
+      result += _mm_cvtsi128_si64(sums) +
+                _mm_cvtsi128_si64(_mm_unpackhi_epi64(sums, sums));
+    }
+#endif
+    for(; i < size; ++i) {
+      u8 const byte = data[i];
+      result += (byte & 0xC0) != 0x80;
+      if constexpr(Pairs) {
+        result += byte >= 0xF0;
+      }
+    }
+    return result;
+  }
+
+  i64 get_utf16_length_from_utf8(char8 const* const data, i64 const size)
+  {
+    return count_utf8_units<true>(data, size);
+  }
+
+  i64 get_utf32_length_from_utf8(char8 const* const data, i64 const size)
+  {
+#if ANTON_SIMD_X86
+    if(size >= 128 && simd::cpu_supports_avx2()) {
+      return simd::count_utf8_code_points_avx2(data, size);
+    }
+#endif
+    return count_utf8_units<false>(data, size);
+  }
+
+  i64 get_utf8_size_from_utf16(char16 const* const data, i64 const length)
+  {
+    // Every code unit takes 1 byte, 1 more if it is at least 0x80 and yet 1
+    // more if it is at least 0x800. A surrogate pair takes 4 bytes instead of
+    // 6, hence every high surrogate followed by a low surrogate subtracts 2.
+    // Unpaired surrogates are converted to U+FFFD, which takes 3 bytes.
+    i64 result = length;
+    i64 i = 0;
+#if ANTON_SIMD_X86
+    // Only signed comparisons are available. Flipping the sign bit maps the
+    // unsigned order onto the signed order.
+    __m128i const bias = _mm_set1_epi16(static_cast<short>(0x8000));
+    __m128i const max_1 = _mm_set1_epi16(static_cast<short>(0x7F ^ 0x8000));
+    __m128i const max_2 = _mm_set1_epi16(static_cast<short>(0x7FF ^ 0x8000));
+    __m128i const surrogate_mask = _mm_set1_epi16(static_cast<short>(0xFC00));
+    __m128i const high_surrogate = _mm_set1_epi16(static_cast<short>(0xD800));
+    __m128i const low_surrogate = _mm_set1_epi16(static_cast<short>(0xDC00));
+    // The pairs are detected by comparing every code unit with its successor,
+    // which must be inside the string.
+    while(i + 9 <= length) {
+      // Each iteration changes the 16-bit counters by at most 2.
+      __m128i accumulator = _mm_setzero_si128();
+      for(i64 n = 0; n < 16383 && i + 9 <= length; ++n, i += 8) {
+        __m128i const v = simd::SSE2::load(data + i);
+        __m128i const next = simd::SSE2::load(data + i + 1);
+        __m128i const biased = _mm_xor_si128(v, bias);
+        accumulator =
+          _mm_sub_epi16(accumulator, _mm_cmpgt_epi16(biased, max_1));
+        accumulator =
+          _mm_sub_epi16(accumulator, _mm_cmpgt_epi16(biased, max_2));
+        __m128i const pair = _mm_and_si128(
+          _mm_cmpeq_epi16(_mm_and_si128(v, surrogate_mask), high_surrogate),
+          _mm_cmpeq_epi16(_mm_and_si128(next, surrogate_mask), low_surrogate));
+        accumulator = _mm_add_epi16(accumulator, _mm_add_epi16(pair, pair));
+      }
+
+      i32 sums[4];
+      simd::SSE2::store(sums, _mm_madd_epi16(accumulator, _mm_set1_epi16(1)));
+      result += static_cast<i64>(sums[0]) + sums[1] + sums[2] + sums[3];
+    }
+#endif
+    for(; i < length; ++i) {
+      char16 const code_unit = data[i];
+      result += (code_unit >= 0x80) + (code_unit >= 0x800);
+      if((code_unit & 0xFC00) == 0xD800 && i + 1 < length &&
+         (data[i + 1] & 0xFC00) == 0xDC00) {
+        result -= 2;
+      }
+    }
+    return result;
+  }
+
+  i64 get_utf8_size_from_utf32(char32 const* const data, i64 const length)
+  {
+    i64 result = length;
+    i64 i = 0;
+#if ANTON_SIMD_X86
+    // The code points do not exceed 0x10FFFF, hence the signed comparisons
+    // are exact.
+    __m128i const max_1 = _mm_set1_epi32(0x7F);
+    __m128i const max_2 = _mm_set1_epi32(0x7FF);
+    __m128i const max_3 = _mm_set1_epi32(0xFFFF);
+    while(i + 4 <= length) {
+      // Each iteration adds at most 3 to the 32-bit counters.
+      __m128i accumulator = _mm_setzero_si128();
+      for(i64 n = 0; n < 0x10000000 && i + 4 <= length; ++n, i += 4) {
+        __m128i const v = simd::SSE2::load(data + i);
+        accumulator = _mm_sub_epi32(accumulator, _mm_cmpgt_epi32(v, max_1));
+        accumulator = _mm_sub_epi32(accumulator, _mm_cmpgt_epi32(v, max_2));
+        accumulator = _mm_sub_epi32(accumulator, _mm_cmpgt_epi32(v, max_3));
+      }
+
+      u32 sums[4];
+      simd::SSE2::store(sums, accumulator);
+      result += static_cast<i64>(sums[0]) + sums[1] + sums[2] + sums[3];
+    }
+#endif
+    for(; i < length; ++i) {
+      char32 const codepoint = data[i];
+      result += (codepoint > 0x7F) + (codepoint > 0x7FF) + (codepoint > 0xFFFF);
+    }
+    return result;
+  }
+
+  Transcode_Result transcode_utf8_to_utf16(char8 const* const source,
+                                           i64 const size,
+                                           char16* const destination,
+                                           i64 const capacity)
+  {
+    i64 read = 0;
+    i64 written = 0;
+    while(read < size) {
+      if(static_cast<u8>(source[read]) < 0x80) {
+        i64 const limit = math::min(size - read, capacity - written);
+        if(limit <= 0) {
+          break;
+        }
+
+        i64 const n =
+          ascii_utf8_to_utf16(source + read, limit, destination + written);
+        read += n;
+        written += n;
+        continue;
+      }
+
+      i64 const byte_count =
+        get_byte_count_from_utf8_leading_byte(source[read]);
+      if(read + byte_count > size) {
+        break;
+      }
+
+      char32 const codepoint = utf8_bytes_to_codepoint(source + read).codepoint;
+      if(codepoint <= 0xFFFF) {
+        if(written + 1 > capacity) {
+          break;
         }
-        bytes_read += 4;
-        bytes_written += byte_count;
-        buffer_utf32 += 1;
-        buffer_utf8 += byte_count;
-        if((count == -1 && codepoint == U'\0') ||
-           (count != -1 && bytes_read >= count)) {
-          return bytes_written;
+
+        destination[written] = static_cast<char16>(codepoint);
+        written += 1;
+      } else {
+        if(written + 2 > capacity) {
+          break;
         }
+
+        char32 const offset = codepoint - 0x10000;
+        destination[written] = static_cast<char16>(0xD800 + (offset >> 10));
+        destination[written + 1] =
+          static_cast<char16>(0xDC00 + (offset & 0x3FF));
+        written += 2;
+      }
+      read += byte_count;
+    }
+    return {read, written};
+  }
+
+  Transcode_Result transcode_utf8_to_utf32(char8 const* const source,
+                                           i64 const size,
+                                           char32* const destination,
+                                           i64 const capacity)
+  {
+    i64 read = 0;
+    i64 written = 0;
+    while(read < size && written < capacity) {
+      if(static_cast<u8>(source[read]) < 0x80) {
+        i64 const limit = math::min(size - read, capacity - written);
+        i64 const n =
+          ascii_utf8_to_utf32(source + read, limit, destination + written);
+        read += n;
+        written += n;
+        continue;
+      }
+
+      i64 const byte_count =
+        get_byte_count_from_utf8_leading_byte(source[read]);
+      if(read + byte_count > size) {
+        break;
       }
+
+      destination[written] = utf8_bytes_to_codepoint(source + read).codepoint;
+      written += 1;
+      read += byte_count;
     }
+    return {read, written};
+  }
+
+  Transcode_Result transcode_utf16_to_utf8(char16 const* const source,
+                                           i64 const length,
+                                           char8* const destination,
+                                           i64 const capacity)
+  {
+    i64 read = 0;
+    i64 written = 0;
+    while(read < length) {
+      char16 const code_unit = source[read];
+      if(code_unit < 0x80) {
+        i64 const limit = math::min(length - read, capacity - written);
+        if(limit <= 0) {
+          break;
+        }
+
+        i64 const n =
+          ascii_utf16_to_utf8(source + read, limit, destination + written);
+        read += n;
+        written += n;
+        continue;
+      }
+
+      char32 codepoint = code_unit;
+      i64 units = 1;
+      if((code_unit & 0xF800) == 0xD800) {
+        // Unpaired surrogates, including a high surrogate at the end of the
+        // source, are replaced with U+FFFD.
+        if(code_unit <= 0xDBFF && read + 1 < length &&
+           (source[read + 1] & 0xFC00) == 0xDC00) {
+          codepoint = surrogate_pair_to_codepoint(code_unit, source[read + 1]);
+          units = 2;
+        } else {
+          codepoint = 0xFFFD;
+        }
+      }
+
+      i64 const byte_count = get_utf8_bytes_count_in_utf32_codepoint(codepoint);
+      if(written + byte_count > capacity) {
+        break;
+      }
+
+      encode_utf8(codepoint, destination + written);
+      written += byte_count;
+      read += units;
+    }
+    return {read, written};
+  }
+
+  Transcode_Result transcode_utf32_to_utf8(char32 const* const source,
+                                           i64 const length,
+                                           char8* const destination,
+                                           i64 const capacity)
+  {
+    i64 read = 0;
+    i64 written = 0;
+    while(read < length) {
+      char32 const codepoint = source[read];
+      if(codepoint < 0x80) {
+        i64 const limit = math::min(length - read, capacity - written);
+        if(limit <= 0) {
+          break;
+        }
+
+        i64 const n =
+          ascii_utf32_to_utf8(source + read, limit, destination + written);
+        read += n;
+        written += n;
+        continue;
+      }
+
+      i64 const byte_count = get_utf8_bytes_count_in_utf32_codepoint(codepoint);
+      if(written + byte_count > capacity) {
+        break;
+      }
+
+      encode_utf8(codepoint, destination + written);
+      written += byte_count;
+      read += 1;
+    }
+    return {read, written};
+  }
+
+  // The conversions below size the output with the vectorized length
+  // functions or convert in a single pass with the transcode functions. The
+  // capacities passed to the transcode functions are the largest sizes the
+  // output may have, which the buffers provided by the callers fit.
+
+  i64 convert_utf32_to_utf8(char32 const* const buffer_utf32, i64 const count,
+                            char8* const buffer_utf8)
+  {
+    i64 const length =
+      count != -1 ? count / 4 : get_length_with_null_terminator(buffer_utf32);
+    if constexpr(ANTON_UNICODE_VALIDATE_ENCODING) {
+      ANTON_FAIL(validate_utf32(buffer_utf32, length), u8"invalid UTF-32");
+    }
+
+    if(buffer_utf8 == nullptr) {
+      return get_utf8_size_from_utf32(buffer_utf32, length);
+    }
+
+    return transcode_utf32_to_utf8(buffer_utf32, length, buffer_utf8,
+                                   4 * length)
+      .written;
   }
 
   i64 convert_codepoint_utf16_to_utf8(char16 const* buffer_utf16,
                                       char8* buffer_utf8)
   {
     if constexpr(ANTON_UNICODE_VALIDATE_ENCODING) {
-      // TODO: Implement
+      char16 const code_unit = *buffer_utf16;
+      i64 const length = code_unit >= 0xD800 && code_unit <= 0xDBFF ? 2 : 1;
+      ANTON_FAIL(validate_utf16(buffer_utf16, length), u8"invalid UTF-16");
     }
 
     // U+0000 to U+D7FF and U+E000 to U+FFFF are encoded as single 16bit chars,
@@ -143,145 +733,39 @@ namespace anton::unicode {
     }
   }
 
-  i64 convert_utf16_to_utf8(char16 const* buffer_utf16, i64 const count,
-                            char8* buffer_utf8)
+  i64 convert_utf16_to_utf8(char16 const* const buffer_utf16, i64 const count,
+                            char8* const buffer_utf8)
   {
+    i64 const length =
+      count != -1 ? count / 2 : get_length_with_null_terminator(buffer_utf16);
     if constexpr(ANTON_UNICODE_VALIDATE_ENCODING) {
-      // TODO: Implement
+      ANTON_FAIL(validate_utf16(buffer_utf16, length), u8"invalid UTF-16");
     }
 
     if(buffer_utf8 == nullptr) {
-      i64 bytes = 0;
-      i64 bytes_read = 0;
-      while(true) {
-        // U+0000 to U+D7FF and U+E000 to U+FFFF are encoded as single 16bit
-        // chars, which we expect to be the more common case.
-        char16 const high_surrogate = *buffer_utf16;
-        if(high_surrogate <= 0xD7FF || high_surrogate >= 0xE000) {
-          char16 const codepoint = high_surrogate;
-          // If codepoint is less than 0x7FF, it's 2 bytes in UTF-8. If it's
-          // less than 0x7F, it's 1 byte in UTF-8. Otherwise it's 3 bytes.
-          bytes += 3 - (codepoint <= 0x7FF) - (codepoint <= 0x7F);
-          bytes_read += 2;
-          buffer_utf16 += 1;
-          if((count == -1 && codepoint == u'\0') ||
-             (count != -1 && bytes_read >= count)) {
-            return bytes;
-          }
-        } else {
-          bytes += 4;
-          bytes_read += 4;
-          buffer_utf16 += 2;
-          if(count != -1 && bytes_read >= count) {
-            return bytes;
-          }
-        }
-      }
-    } else {
-      i64 bytes_written = 0;
-      i64 bytes_read = 0;
-      while(true) {
-        // U+0000 to U+D7FF and U+E000 to U+FFFF are encoded as single 16bit
-        // chars, which we expect to be the more common case.
-        char16 const high_surrogate = *buffer_utf16;
-        if(high_surrogate <= 0xD7FF || high_surrogate >= 0xE000) {
-          char32 const codepoint = high_surrogate;
-          if(codepoint <= 0x7F) {
-            *buffer_utf8 = static_cast<char8>(codepoint);
-            buffer_utf8 += 1;
-            bytes_written += 1;
-          } else if(codepoint <= 0x7FF) {
-            buffer_utf8[0] = 0xC0 | ((codepoint & 0x7C0) >> 6);
-            buffer_utf8[1] = 0x80 | (codepoint & 0x3F);
-            buffer_utf8 += 2;
-            bytes_written += 2;
-          } else {
-            buffer_utf8[0] = 0xE0 | ((codepoint & 0xF000) >> 12);
-            buffer_utf8[1] = 0x80 | ((codepoint & 0xFC0) >> 6);
-            buffer_utf8[2] = 0x80 | (codepoint & 0x3F);
-            buffer_utf8 += 3;
-            bytes_written += 3;
-          }
-          bytes_read += 2;
-          buffer_utf16 += 1;
-          if((count == -1 && codepoint == u'\0') ||
-             (count != -1 && bytes_read >= count)) {
-            return bytes_written;
-          }
-        } else {
-          char16 const low_surrogate = buffer_utf16[1];
-          char32 const codepoint =
-            surrogate_pair_to_codepoint(high_surrogate, low_surrogate);
-          buffer_utf8[0] = 0xF0 | ((codepoint & 0x1C0000) >> 18);
-          buffer_utf8[1] = 0x80 | ((codepoint & 0x3F000) >> 12);
-          buffer_utf8[2] = 0x80 | ((codepoint & 0xFC0) >> 6);
-          buffer_utf8[3] = 0x80 | (codepoint & 0x3F);
-          buffer_utf8 += 4;
-          bytes_written += 4;
-          bytes_read += 4;
-          buffer_utf16 += 2;
-          if(count != -1 && bytes_read >= count) {
-            return bytes_written;
-          }
-        }
-      }
+      return get_utf8_size_from_utf16(buffer_utf16, length);
     }
+
+    return transcode_utf16_to_utf8(buffer_utf16, length, buffer_utf8,
+                                   3 * length)
+      .written;
   }
 
-  i64 convert_utf8_to_utf16(char8 const* buffer_utf8, i64 const count,
-                            char16* buffer_utf16)
+  i64 convert_utf8_to_utf16(char8 const* const buffer_utf8, i64 const count,
+                            char16* const buffer_utf16)
   {
+    i64 const size =
+      count != -1 ? count : get_length_with_null_terminator(buffer_utf8);
     if constexpr(ANTON_UNICODE_VALIDATE_ENCODING) {
-      // TODO: Implement
+      ANTON_FAIL(validate_utf8(buffer_utf8, size), u8"invalid UTF-8");
     }
 
-    i64 bytes = 0;
-    i64 bytes_read = 0;
     if(buffer_utf16 == nullptr) {
-      while(true) {
-        auto const [codepoint, byte_count] =
-          utf8_bytes_to_codepoint(buffer_utf8);
-        buffer_utf8 += byte_count;
-        bytes_read += byte_count;
-        // U+0000 to U+D7FF and U+E000 to U+FFFF are encoded as single 16bit
-        // chars.
-        bool const is_surrogate_pair = !(
-          codepoint <= 0xD7FF || (codepoint >= 0xE000 && codepoint <= 0xFFFF));
-        bytes += 2 * (is_surrogate_pair + 1);
-        if((count == -1 && codepoint == U'\0') ||
-           (count != -1 && bytes_read >= count)) {
-          return bytes;
-        }
-      }
-    } else {
-      while(true) {
-        auto const [codepoint, byte_count] =
-          utf8_bytes_to_codepoint(buffer_utf8);
-        buffer_utf8 += byte_count;
-        bytes_read += byte_count;
-        // U+0000 to U+D7FF and U+E000 to U+FFFF are encoded as single 16bit
-        // chars, which we expect to be the more common case.
-        if(codepoint <= 0xD7FF ||
-           (codepoint >= 0xE000 && codepoint <= 0xFFFF)) {
-          *buffer_utf16 = codepoint;
-          buffer_utf16 += 1;
-          bytes += 2;
-        } else {
-          char16 const high_surrogate =
-            0xD800 + ((codepoint - 0x10000) >> 10 & 0x3FF);
-          char16 const low_surrogate = 0xDC00 + ((codepoint - 0x10000) & 0x3FF);
-          buffer_utf16[0] = high_surrogate;
-          buffer_utf16[1] = low_surrogate;
-          buffer_utf16 += 2;
-          bytes += 4;
-        }
-
-        if((count == -1 && codepoint == U'\0') ||
-           (count != -1 && bytes_read >= count)) {
-          return bytes;
-        }
-      }
+      return 2 * get_utf16_length_from_utf8(buffer_utf8, size);
     }
+
+    return 2 * transcode_utf8_to_utf16(buffer_utf8, size, buffer_utf16, size)
+                 .written;
   }
 
   char32 convert_codepoint_utf8_to_utf32(char8 const* buffer_utf8)
@@ -290,43 +774,20 @@ namespace anton::unicode {
     return codepoint;
   }
 
-  i64 convert_utf8_to_utf32(char8 const* buffer_utf8, i64 const count,
-                            char32* buffer_utf32)
+  i64 convert_utf8_to_utf32(char8 const* const buffer_utf8, i64 const count,
+                            char32* const buffer_utf32)
   {
+    i64 const size =
+      count != -1 ? count : get_length_with_null_terminator(buffer_utf8);
     if constexpr(ANTON_UNICODE_VALIDATE_ENCODING) {
-      // TODO: Implement
+      ANTON_FAIL(validate_utf8(buffer_utf8, size), u8"invalid UTF-8");
     }
 
-    i64 bytes = 0;
-    i64 bytes_read = 0;
     if(buffer_utf32 == nullptr) {
-      while(true) {
-        u8 const leading_byte = *buffer_utf8;
-        u32 const byte_count =
-          get_byte_count_from_utf8_leading_byte(leading_byte);
-        bytes += 4;
-        bytes_read += byte_count;
-        buffer_utf8 += byte_count;
-        if((count == -1 && leading_byte == u8'\0') ||
-           (count != -1 && bytes_read >= count)) {
-          return bytes;
-        }
-      }
-    } else {
-      while(true) {
-        u8 const leading_byte = *buffer_utf8;
-        auto const [codepoint, byte_count] =
-          utf8_bytes_to_codepoint(buffer_utf8);
-        *buffer_utf32 = codepoint;
-        bytes += 4;
-        bytes_read += byte_count;
-        buffer_utf8 += byte_count;
-        buffer_utf32 += 1;
-        if((count == -1 && leading_byte == u8'\0') ||
-           (count != -1 && bytes_read >= count)) {
-          return bytes;
-        }
-      }
+      return 4 * get_utf32_length_from_utf8(buffer_utf8, size);
     }
+
+    return 4 * transcode_utf8_to_utf32(buffer_utf8, size, buffer_utf32, size)
+                 .written;
   }
 } // namespace anton::unicode
@@ -0,0 +1,133 @@
+#include <anton/utf8_index.hpp>
+
+#include <anton/assert.hpp>
+#include <anton/detail/crt.hpp>
+#include <anton/swap.hpp>
+#include <anton/unicode/common.hpp>
+
+namespace anton {
+  UTF8_Index::UTF8_Index(): _checkpoints() {}
+
+  UTF8_Index::UTF8_Index(allocator_type const& allocator)
+    : _checkpoints(allocator)
+  {
+  }
+
+  UTF8_Index::UTF8_Index(String_View const string, i64 const stride)
+    : _string(string), _checkpoints(), _stride(stride)
+  {
+    build();
+  }
+
+  UTF8_Index::UTF8_Index(allocator_type const& allocator,
+                         String_View const string, i64 const stride)
+    : _string(string), _checkpoints(allocator), _stride(stride)
+  {
+    build();
+  }
+
+  void UTF8_Index::build()
+  {
+    ANTON_ASSERT(_stride > 0, u8"stride must be greater than 0");
+    char8 const* const data = _string.data();
+    i64 const size = _string.size_bytes();
+    _size_utf8 = unicode::get_utf32_length_from_utf8(data, size);
+    _checkpoints.ensure_capacity(_size_utf8 / _stride + 1);
+    // The position of the next code point to record and the number of code
+    // points preceding the byte i.
+    i64 next = 0;
+    i64 count = 0;
+    i64 i = 0;
+    while(i < size) {
+      if(i + 8 <= size) {
+        // Skip the words that do not contain the next code point to record.
+        // The continuation bytes have the most significant bit set and the
+        // next bit clear.
+        u64 word;
+        memcpy(&word, data + i, 8);
+        u64 const continuation = word & ~(word << 1) & 0x8080808080808080;
+        u64 const continuation_count =
+          ((continuation >> 7) * 0x0101010101010101) >> 56;
+        i64 const code_points = 8 - static_cast<i64>(continuation_count);
+        if(count + code_points <= next) {
+          count += code_points;
+          i += 8;
+          continue;
+        }
+      }
+
+      if((data[i] & 0xC0) != 0x80) {
+        if(count == next) {
+          _checkpoints.push_back(i);
+          next += _stride;
+        }
+        count += 1;
+      }
+      i += 1;
+    }
+  }
+
+  auto UTF8_Index::size_utf8() const -> size_type
+  {
+    return _size_utf8;
+  }
+
+  String_View UTF8_Index::get_string() const
+  {
+    return _string;
+  }
+
+  i64 UTF8_Index::get_byte_offset(i64 const index) const
+  {
+    ANTON_ASSERT(index >= 0 && index <= _size_utf8, u8"index out of bounds");
+    if(index == _size_utf8) {
+      return _string.size_bytes();
+    }
+
+    char8 const* const data = _string.data();
+    i64 offset = _checkpoints[index / _stride];
+    for(i64 i = index % _stride; i > 0; --i) {
+      offset += unicode::get_byte_count_from_utf8_leading_byte(data[offset]);
+    }
+    return offset;
+  }
+
+  UTF8_Char_Iterator UTF8_Index::get_char_iterator(i64 const index) const
+  {
+    i64 const offset = get_byte_offset(index);
+    return UTF8_Char_Iterator{_string.data() + offset, offset};
+  }
+
+  char32 UTF8_Index::char_at(i64 const index) const
+  {
+    ANTON_ASSERT(index >= 0 && index < _size_utf8, u8"index out of bounds");
+    return unicode::convert_codepoint_utf8_to_utf32(_string.data() +
+                                                    get_byte_offset(index));
+  }
+
+  String_View UTF8_Index::substring(i64 const first, i64 const last) const
+  {
+    ANTON_ASSERT(first <= last, u8"first must not be greater than last");
+    char8 const* const data = _string.data();
+    return String_View{data + get_byte_offset(first),
+                       data + get_byte_offset(last)};
+  }
+
+  auto UTF8_Index::get_allocator() -> allocator_type&
+  {
+    return _checkpoints.get_allocator();
+  }
+
+  auto UTF8_Index::get_allocator() const -> allocator_type const&
+  {
+    return _checkpoints.get_allocator();
+  }
+
+  void swap(UTF8_Index& lhs, UTF8_Index& rhs)
+  {
+    swap(lhs._string, rhs._string);
+    swap(lhs._checkpoints, rhs._checkpoints);
+    swap(lhs._size_utf8, rhs._size_utf8);
+    swap(lhs._stride, rhs._stride);
+  }
+} // namespace anton
@@ -15,12 +15,15 @@ namespace anton::fs {
   [[nodiscard]] static Array<char16>
   string8_to_string16(String_View const string8)
   {
-    i64 const string16_bytes = unicode::convert_utf8_to_utf16(
-      string8.data(), string8.size_bytes(), nullptr);
-    // Add 1 to the length for null-terminator.
-    Array<char16> string16(1 + string16_bytes / sizeof(char16), 0);
-    unicode::convert_utf8_to_utf16(string8.data(), string8.size_bytes(),
-                                   string16.data());
+    // UTF-8 never needs more UTF-16 code units than it has bytes, hence the
+    // string converts in a single pass. Add 1 for the null-terminator.
+    i64 const size = string8.size_bytes();
+    Array<char16> string16(anton::reserve, size + 1);
+    i64 const length = unicode::transcode_utf8_to_utf16(string8.data(), size,
+                                                        string16.data(), size)
+                         .written;
+    string16.force_size(length);
+    string16.push_back(0);
     return string16;
   }
 
@@ -0,0 +1,67 @@
+#include <anton/thread.hpp>
+
+#include <anton/assert.hpp>
+#include <anton/memory.hpp>
+
+#include <Windows.h>
+
+namespace anton {
+  namespace {
+    struct Thread_Start {
+      Thread_Function function;
+      void* data;
+    };
+  } // namespace
+
+  static DWORD WINAPI thread_trampoline(LPVOID const data)
+  {
+    Thread_Start* const start = static_cast<Thread_Start*>(data);
+    Thread_Start const copy = *start;
+    delete_obj(start);
+    copy.function(copy.data);
+    return 0;
+  }
+
+  Thread create_thread(Thread_Function const function, void* const data)
+  {
+    Thread_Start* const start = new_obj<Thread_Start>(function, data);
+    HANDLE const handle =
+      CreateThread(nullptr, 0, thread_trampoline, start, 0, nullptr);
+    ANTON_VERIFY(handle != nullptr, "failed to create thread");
+    return Thread{reinterpret_cast<u64>(handle)};
+  }
+
+  void join_thread(Thread const thread)
+  {
+    HANDLE const handle = reinterpret_cast<HANDLE>(thread.native_handle);
+    WaitForSingleObject(handle, INFINITE);
+    CloseHandle(handle);
+  }
+
+  void yield_thread()
+  {
+    SwitchToThread();
+  }
+
+  i64 get_hardware_concurrency()
+  {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? info.dwNumberOfProcessors : 1;
+  }
+
+  void wait_on_address(Atomic<i32>& address, i32 expected)
+  {
+    WaitOnAddress(&address, &expected, sizeof(i32), INFINITE);
+  }
+
+  void wake_one_on_address(Atomic<i32>& address)
+  {
+    WakeByAddressSingle(&address);
+  }
+
+  void wake_all_on_address(Atomic<i32>& address)
+  {
+    WakeByAddressAll(&address);
+  }
+} // namespace anton
@@ -1,11 +1,17 @@
 #pragma once
 
 #include <anton/array.hpp>
+#include <anton/detail/crt.hpp>
+#include <anton/intrinsics.hpp>
 #include <anton/iterators.hpp>
 #include <anton/math/math.hpp>
 #include <anton/memory.hpp>
 #include <anton/pair.hpp>
 #include <anton/swap.hpp>
+#include <anton/type_traits/base.hpp>
+#include <anton/type_traits/common.hpp>
+#include <anton/type_traits/properties.hpp>
+#include <anton/type_traits/transformations.hpp>
 
 namespace anton {
   // fill_with_consecutive
@@ -20,6 +26,155 @@ namespace anton {
     }
   }
 
+  namespace detail {
+    template<i64 Size>
+    struct Simd_Lane;
+
+    template<>
+    struct Simd_Lane<1> {
+      using unsigned_type = u8;
+      using signed_type = i8;
+    };
+
+    template<>
+    struct Simd_Lane<2> {
+      using unsigned_type = u16;
+      using signed_type = i16;
+    };
+
+    template<>
+    struct Simd_Lane<4> {
+      using unsigned_type = u32;
+      using signed_type = i32;
+    };
+
+    template<>
+    struct Simd_Lane<8> {
+      using unsigned_type = u64;
+      using signed_type = i64;
+    };
+
+    // is_simd_comparable
+    // Whether two objects of type T are equal exactly when their object
+    // representations are equal, which allows the vectorized kernels to
+    // compare them as integers.
+    //
+    template<typename T>
+    constexpr bool is_simd_comparable =
+      (is_integral<T> || is_enum<T> || is_pointer<T>) &&
+      (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+    template<typename Iterator>
+    using simd_element = remove_const<remove_pointer<Iterator>>;
+
+    // use_simd_search
+    // Whether searching the range [Iterator, Iterator[ for a value of type T
+    // may be vectorized. Integral values of other types are converted to the
+    // element type.
+    //
+    template<typename Iterator, typename T>
+    constexpr bool use_simd_search =
+      is_pointer<Iterator> && is_simd_comparable<simd_element<Iterator>> &&
+      (is_same<simd_element<Iterator>, T> ||
+       (is_integral<simd_element<Iterator>> && is_integral<T>));
+
+    // use_simd_compare
+    // Whether the ranges of Iterator1 and Iterator2 may be compared with the
+    // vectorized kernels.
+    //
+    template<typename Iterator1, typename Iterator2>
+    constexpr bool use_simd_compare =
+      is_pointer<Iterator1> && is_pointer<Iterator2> &&
+      is_same<simd_element<Iterator1>, simd_element<Iterator2>> &&
+      is_simd_comparable<simd_element<Iterator1>>;
+
+    // use_simd_order
+    // Whether the extremes of the range [Iterator, Iterator[ may be found with
+    // the vectorized kernels.
+    //
+    template<typename Iterator>
+    constexpr bool use_simd_order =
+      is_pointer<Iterator> && is_integral<simd_element<Iterator>> &&
+      is_simd_comparable<simd_element<Iterator>>;
+
+    template<typename T>
+    [[nodiscard]] typename Simd_Lane<sizeof(T)>::unsigned_type
+    simd_lane_bits(T const value)
+    {
+      typename Simd_Lane<sizeof(T)>::unsigned_type bits;
+      memcpy(&bits, &value, sizeof(T));
+      return bits;
+    }
+
+    // Vectorized kernels defined in private/algorithm.cpp. The kernels use
+    // AVX2 when the processor supports it and SSE2 otherwise.
+
+    // simd_find
+    // Returns: The index of the first element equal to value or length.
+    //
+    [[nodiscard]] i64 simd_find(u8 const* data, i64 length, u8 value);
+    [[nodiscard]] i64 simd_find(u16 const* data, i64 length, u16 value);
+    [[nodiscard]] i64 simd_find(u32 const* data, i64 length, u32 value);
+    [[nodiscard]] i64 simd_find(u64 const* data, i64 length, u64 value);
+
+    // simd_count
+    // Returns: The number of elements equal to value.
+    //
+    [[nodiscard]] i64 simd_count(u8 const* data, i64 length, u8 value);
+    [[nodiscard]] i64 simd_count(u16 const* data, i64 length, u16 value);
+    [[nodiscard]] i64 simd_count(u32 const* data, i64 length, u32 value);
+    [[nodiscard]] i64 simd_count(u64 const* data, i64 length, u64 value);
+
+    // simd_mismatch
+    // Returns: The index of the first byte that differs between lhs and rhs or
+    // size if the ranges are equal.
+    //
+    [[nodiscard]] i64 simd_mismatch(void const* lhs, void const* rhs, i64 size);
+
+    // simd_min_element
+    // Returns: The index of the first smallest element or 0 if length is 0.
+    //
+    [[nodiscard]] i64 simd_min_element(i8 const* data, i64 length);
+    [[nodiscard]] i64 simd_min_element(i16 const* data, i64 length);
+    [[nodiscard]] i64 simd_min_element(i32 const* data, i64 length);
+    [[nodiscard]] i64 simd_min_element(i64 const* data, i64 length);
+    [[nodiscard]] i64 simd_min_element(u8 const* data, i64 length);
+    [[nodiscard]] i64 simd_min_element(u16 const* data, i64 length);
+    [[nodiscard]] i64 simd_min_element(u32 const* data, i64 length);
+    [[nodiscard]] i64 simd_min_element(u64 const* data, i64 length);
+
+    // simd_max_element
+    // Returns: The index of the first largest element or 0 if length is 0.
+    //
+    [[nodiscard]] i64 simd_max_element(i8 const* data, i64 length);
+    [[nodiscard]] i64 simd_max_element(i16 const* data, i64 length);
+    [[nodiscard]] i64 simd_max_element(i32 const* data, i64 length);
+    [[nodiscard]] i64 simd_max_element(i64 const* data, i64 length);
+    [[nodiscard]] i64 simd_max_element(u8 const* data, i64 length);
+    [[nodiscard]] i64 simd_max_element(u16 const* data, i64 length);
+    [[nodiscard]] i64 simd_max_element(u32 const* data, i64 length);
+    [[nodiscard]] i64 simd_max_element(u64 const* data, i64 length);
+
+    // simd_set_intersection
+    // Writes the elements of the sorted range [first1, first1 + length1[ that
+    // are also present in the sorted range [first2, first2 + length2[ to out.
+    //
+    // Returns: The number of elements written.
+    //
+    [[nodiscard]] i64 simd_set_intersection(i32 const* first1, i64 length1,
+                                            i32 const* first2, i64 length2,
+                                            i32* out);
+    [[nodiscard]] i64 simd_set_intersection(i64 const* first1, i64 length1,
+                                            i64 const* first2, i64 length2,
+                                            i64* out);
+    [[nodiscard]] i64 simd_set_intersection(u32 const* first1, i64 length1,
+                                            u32 const* first2, i64 length2,
+                                            u32* out);
+    [[nodiscard]] i64 simd_set_intersection(u64 const* first1, i64 length1,
+                                            u64 const* first2, i64 length2,
+                                            u64* out);
+  } // namespace detail
+
   // find
   // Linearily searches the range [first, last[.
   //
@@ -27,16 +182,70 @@ namespace anton {
   // satisfies the condition *iterator == value or last if no such iterator is
   // found.
   //
+  // Contiguous ranges of integers, enums and pointers given as pointers are
+  // searched with the vectorized kernels.
+  //
   // Complexity: At most 'last - first' comparisons.
   //
   template<typename Input_Iterator, typename T>
   [[nodiscard]] Input_Iterator find(Input_Iterator first, Input_Iterator last,
                                     T const& value)
   {
-    while(first != last && *first != value) {
-      ++first;
+    if constexpr(detail::use_simd_search<Input_Iterator, T>) {
+      using element_type = detail::simd_element<Input_Iterator>;
+      element_type const element = static_cast<element_type>(value);
+      if constexpr(is_integral<T>) {
+        // value is not representable by the element type, therefore no
+        // element may compare equal to it.
+        if(element != value) {
+          return last;
+        }
+      }
+      i64 const index = detail::simd_find(
+        reinterpret_cast<typename detail::Simd_Lane<sizeof(
+          element_type)>::unsigned_type const*>(first),
+        last - first, detail::simd_lane_bits(element));
+      return first + index;
+    } else {
+      while(first != last && *first != value) {
+        ++first;
+      }
+      return first;
+    }
+  }
+
+  // count
+  // Counts the elements in the range [first, last[ that satisfy the condition
+  // *iterator == value. Contiguous ranges of integers, enums and pointers given
+  // as pointers are counted with the vectorized kernels.
+  //
+  // Complexity: Exactly 'last - first' comparisons.
+  //
+  template<typename Input_Iterator, typename T>
+  [[nodiscard]] i64 count(Input_Iterator first, Input_Iterator last,
+                          T const& value)
+  {
+    if constexpr(detail::use_simd_search<Input_Iterator, T>) {
+      using element_type = detail::simd_element<Input_Iterator>;
+      element_type const element = static_cast<element_type>(value);
+      if constexpr(is_integral<T>) {
+        if(element != value) {
+          return 0;
+        }
+      }
+      return detail::simd_count(
+        reinterpret_cast<typename detail::Simd_Lane<sizeof(
+          element_type)>::unsigned_type const*>(first),
+        last - first, detail::simd_lane_bits(element));
+    } else {
+      i64 result = 0;
+      for(; first != last; ++first) {
+        if(*first == value) {
+          result += 1;
+        }
+      }
+      return result;
     }
-    return first;
   }
 
   // find_if
@@ -239,10 +448,551 @@ namespace anton {
     return dest;
   }
 
+  namespace detail {
+    template<typename Iterator>
+    constexpr bool is_random_access_iterator = is_iterator_category<
+      typename Iterator_Traits<Iterator>::iterator_category,
+      Random_Access_Iterator_Tag>;
+
+    // lower_bound_n
+    // Finds the first element of [first, first + length[ that is not ordered
+    // before value.
+    //
+    // The range is halved without branching on the outcome of the comparison,
+    // which the processor cannot predict, so that the compiler may select the
+    // next half with a conditional move. Contiguous ranges additionally
+    // prefetch both candidates for the next comparison.
+    //
+    template<typename Random_Access_Iterator, typename T, typename Predicate>
+    [[nodiscard]] Random_Access_Iterator
+    lower_bound_n(Random_Access_Iterator first, i64 length, T const& value,
+                  Predicate& predicate)
+    {
+      if(length == 0) {
+        return first;
+      }
+
+      while(length > 1) {
+        i64 const half = length / 2;
+        if constexpr(is_pointer<Random_Access_Iterator>) {
+          i64 const next_half = (length - half) / 2;
+          ANTON_PREFETCH(first + next_half);
+          ANTON_PREFETCH(first + half + next_half);
+        }
+        first += predicate(*(first + half), value) ? half : 0;
+        length -= half;
+      }
+      return first + (predicate(*first, value) ? 1 : 0);
+    }
+
+    // upper_bound_n
+    // Finds the first element of [first, first + length[ that is ordered after
+    // value. Branchless in the same way as lower_bound_n.
+    //
+    template<typename Random_Access_Iterator, typename T, typename Predicate>
+    [[nodiscard]] Random_Access_Iterator
+    upper_bound_n(Random_Access_Iterator first, i64 length, T const& value,
+                  Predicate& predicate)
+    {
+      if(length == 0) {
+        return first;
+      }
+
+      while(length > 1) {
+        i64 const half = length / 2;
+        if constexpr(is_pointer<Random_Access_Iterator>) {
+          i64 const next_half = (length - half) / 2;
+          ANTON_PREFETCH(first + next_half);
+          ANTON_PREFETCH(first + half + next_half);
+        }
+        first += predicate(value, *(first + half)) ? 0 : half;
+        length -= half;
+      }
+      return first + (predicate(value, *first) ? 0 : 1);
+    }
+
+    // gallop_lower_bound
+    // Finds the first element of [first, last[ that is not ordered before
+    // value using exponential search. The positions first + 1, first + 3,
+    // first + 7, ... are probed until an element not ordered before value is
+    // found, and the last bracket is searched with binary search.
+    //
+    // Complexity: O(log d) comparisons where d is the distance from first to
+    // the result.
+    //
+    template<typename Random_Access_Iterator, typename T, typename Predicate>
+    [[nodiscard]] Random_Access_Iterator
+    gallop_lower_bound(Random_Access_Iterator const first,
+                       Random_Access_Iterator const last, T const& value,
+                       Predicate& predicate)
+    {
+      i64 const length = last - first;
+      if(length == 0 || !predicate(*first, value)) {
+        return first;
+      }
+
+      // Invariant: the element at low is ordered before value.
+      i64 low = 0;
+      i64 step = 1;
+      while(low + step < length && predicate(*(first + (low + step)), value)) {
+        low += step;
+        step *= 2;
+      }
+      i64 const high = math::min(low + step, length);
+      return lower_bound_n(first + (low + 1), high - (low + 1), value,
+                           predicate);
+    }
+
+    // The size ratio of the ranges above which set_intersection iterates the
+    // smaller range and gallops through the larger one.
+    constexpr i64 set_intersection_gallop_ratio = 32;
+
+    template<typename Random_Access_Iterator1, typename Random_Access_Iterator2,
+             typename Output_Iterator, typename Compare>
+    Output_Iterator gallop_set_intersection(Random_Access_Iterator1 first1,
+                                            Random_Access_Iterator1 last1,
+                                            Random_Access_Iterator2 first2,
+                                            Random_Access_Iterator2 last2,
+                                            Output_Iterator dest,
+                                            Compare& compare)
+    {
+      if(last1 - first1 <= last2 - first2) {
+        while(first1 != last1) {
+          first2 = gallop_lower_bound(first2, last2, *first1, compare);
+          if(first2 == last2) {
+            break;
+          }
+
+          if(!compare(*first1, *first2)) {
+            *dest = *first1;
+            ++dest;
+            ++first2;
+          }
+          ++first1;
+        }
+      } else {
+        while(first2 != last2) {
+          first1 = gallop_lower_bound(first1, last1, *first2, compare);
+          if(first1 == last1) {
+            break;
+          }
+
+          if(!compare(*first2, *first1)) {
+            *dest = *first1;
+            ++dest;
+            ++first1;
+          }
+          ++first2;
+        }
+      }
+      return dest;
+    }
+
+    // use_simd_set_intersection
+    // Whether the intersection of the ranges of Iterator1 and Iterator2 written
+    // to Output_Iterator may be computed by the vectorized kernels.
+    //
+    template<typename Iterator1, typename Iterator2, typename Output_Iterator>
+    constexpr bool use_simd_set_intersection =
+      use_simd_order<Iterator1> &&
+      is_same<simd_element<Iterator1>, simd_element<Iterator2>> &&
+      is_pointer<Output_Iterator> &&
+      is_same<remove_pointer<Output_Iterator>, simd_element<Iterator1>> &&
+      (sizeof(simd_element<Iterator1>) == 4 ||
+       sizeof(simd_element<Iterator1>) == 8);
+  } // namespace detail
+
+  // lower_bound
+  // Finds the first element in the sorted range [first, last[ that is not
+  // ordered before value.
+  //
+  // Parameters:
+  // first, last - the range to search. Must be sorted with respect to
+  //               predicate.
+  //       value - the value to compare the elements to.
+  //   predicate - comparison function. Returns true when the first argument is
+  //               less than (i.e. ordered before) the second argument.
+  //
+  // Returns: The iterator to the first element not ordered before value or
+  // last if no such element exists.
+  //
+  // The search is branchless and prefetches the next candidates on contiguous
+  // ranges. For read-only lookups into large arrays see Eytzinger_Array.
+  //
+  // Complexity: Exactly ceil(log2(last - first)) + 1 comparisons if the range
+  // is not empty.
+  //
+  template<typename Random_Access_Iterator, typename T, typename Predicate>
+  [[nodiscard]] Random_Access_Iterator
+  lower_bound(Random_Access_Iterator first, Random_Access_Iterator last,
+              T const& value, Predicate predicate)
+  {
+    return detail::lower_bound_n(first, last - first, value, predicate);
+  }
+
+  template<typename Random_Access_Iterator, typename T>
+  [[nodiscard]] Random_Access_Iterator
+  lower_bound(Random_Access_Iterator first, Random_Access_Iterator last,
+              T const& value)
+  {
+    return anton::lower_bound(
+      first, last, value,
+      [](auto const& lhs, auto const& rhs) { return lhs < rhs; });
+  }
+
+  // upper_bound
+  // Finds the first element in the sorted range [first, last[ that is ordered
+  // after value.
+  //
+  // Parameters:
+  // first, last - the range to search. Must be sorted with respect to
+  //               predicate.
+  //       value - the value to compare the elements to.
+  //   predicate - comparison function. Returns true when the first argument is
+  //               less than (i.e. ordered before) the second argument.
+  //
+  // Returns: The iterator to the first element ordered after value or last if
+  // no such element exists.
+  //
+  // Complexity: Exactly ceil(log2(last - first)) + 1 comparisons if the range
+  // is not empty.
+  //
+  template<typename Random_Access_Iterator, typename T, typename Predicate>
+  [[nodiscard]] Random_Access_Iterator
+  upper_bound(Random_Access_Iterator first, Random_Access_Iterator last,
+              T const& value, Predicate predicate)
+  {
+    return detail::upper_bound_n(first, last - first, value, predicate);
+  }
+
+  template<typename Random_Access_Iterator, typename T>
+  [[nodiscard]] Random_Access_Iterator
+  upper_bound(Random_Access_Iterator first, Random_Access_Iterator last,
+              T const& value)
+  {
+    return anton::upper_bound(
+      first, last, value,
+      [](auto const& lhs, auto const& rhs) { return lhs < rhs; });
+  }
+
+  // equal_range
+  // Finds the range of elements equivalent to value in the sorted range
+  // [first, last[.
+  //
+  // Parameters:
+  // first, last - the range to search. Must be sorted with respect to
+  //               predicate.
+  //       value - the value to compare the elements to.
+  //   predicate - comparison function. Returns true when the first argument is
+  //               less than (i.e. ordered before) the second argument.
+  //
+  // Returns: The pair of lower_bound and upper_bound of value.
+  //
+  // Complexity: O(log(last - first)) comparisons.
+  //
+  template<typename Random_Access_Iterator, typename T, typename Predicate>
+  [[nodiscard]] Pair<Random_Access_Iterator, Random_Access_Iterator>
+  equal_range(Random_Access_Iterator first, Random_Access_Iterator last,
+              T const& value, Predicate predicate)
+  {
+    // Narrow the range until an equivalent element is found. The bounds are
+    // then searched for only on the respective sides of it.
+    i64 length = last - first;
+    while(length > 0) {
+      i64 const half = length / 2;
+      Random_Access_Iterator const middle = first + half;
+      if(predicate(*middle, value)) {
+        first = middle + 1;
+        length -= half + 1;
+      } else if(predicate(value, *middle)) {
+        length = half;
+      } else {
+        Random_Access_Iterator const lower =
+          detail::lower_bound_n(first, half, value, predicate);
+        Random_Access_Iterator const upper = detail::upper_bound_n(
+          middle + 1, length - half - 1, value, predicate);
+        return {lower, upper};
+      }
+    }
+    return {first, first};
+  }
+
+  template<typename Random_Access_Iterator, typename T>
+  [[nodiscard]] Pair<Random_Access_Iterator, Random_Access_Iterator>
+  equal_range(Random_Access_Iterator first, Random_Access_Iterator last,
+              T const& value)
+  {
+    return anton::equal_range(
+      first, last, value,
+      [](auto const& lhs, auto const& rhs) { return lhs < rhs; });
+  }
+
+  // set_intersection
+  // Copies the elements of [first1, last1[ that are also present in
+  // [first2, last2[ to the destination range starting at dest. If an element
+  // is present m times in the first range and n times in the second, the
+  // first min(m, n) of them are copied.
+  //
+  // When one of the ranges is more than 32 times larger than the other and
+  // both are random access, the smaller range is iterated and the position of
+  // every element in the larger range is found with galloping search.
+  //
+  // Requires:
+  // Both input ranges must be sorted with respect to compare and neither must
+  // overlap with the destination range.
+  //
+  // Returns: The end of the destination range.
+  //
+  // Complexity: O(n + m) comparisons, O(k log(n / k)) when galloping where k
+  // is the length of the smaller range.
+  //
+  template<typename Input_Iterator1, typename Input_Iterator2,
+           typename Output_Iterator, typename Compare>
+  Output_Iterator set_intersection(Input_Iterator1 first1,
+                                   Input_Iterator1 last1,
+                                   Input_Iterator2 first2,
+                                   Input_Iterator2 last2, Output_Iterator dest,
+                                   Compare compare)
+  {
+    if constexpr(detail::is_random_access_iterator<Input_Iterator1> &&
+                 detail::is_random_access_iterator<Input_Iterator2>) {
+      i64 const length1 = last1 - first1;
+      i64 const length2 = last2 - first2;
+      if(length1 > length2 * detail::set_intersection_gallop_ratio ||
+         length2 > length1 * detail::set_intersection_gallop_ratio) {
+        return detail::gallop_set_intersection(first1, last1, first2, last2,
+                                               dest, compare);
+      }
+    }
+
+    while(first1 != last1 && first2 != last2) {
+      if(compare(*first1, *first2)) {
+        ++first1;
+      } else if(compare(*first2, *first1)) {
+        ++first2;
+      } else {
+        *dest = *first1;
+        ++dest;
+        ++first1;
+        ++first2;
+      }
+    }
+    return dest;
+  }
+
+  // set_intersection
+  // Compares the elements using operator<. Contiguous ranges of 32-bit and
+  // 64-bit integers given as pointers and written to a pointer are intersected
+  // with the vectorized kernels unless their sizes are skewed.
+  //
+  template<typename Input_Iterator1, typename Input_Iterator2,
+           typename Output_Iterator>
+  Output_Iterator set_intersection(Input_Iterator1 first1,
+                                   Input_Iterator1 last1,
+                                   Input_Iterator2 first2,
+                                   Input_Iterator2 last2, Output_Iterator dest)
+  {
+    if constexpr(detail::use_simd_set_intersection<
+                   Input_Iterator1, Input_Iterator2, Output_Iterator>) {
+      using element_type = detail::simd_element<Input_Iterator1>;
+      using lane_type = conditional<
+        is_signed<element_type>,
+        typename detail::Simd_Lane<sizeof(element_type)>::signed_type,
+        typename detail::Simd_Lane<sizeof(element_type)>::unsigned_type>;
+      i64 const length1 = last1 - first1;
+      i64 const length2 = last2 - first2;
+      if(length1 <= length2 * detail::set_intersection_gallop_ratio &&
+         length2 <= length1 * detail::set_intersection_gallop_ratio) {
+        i64 const count = detail::simd_set_intersection(
+          reinterpret_cast<lane_type const*>(first1), length1,
+          reinterpret_cast<lane_type const*>(first2), length2,
+          reinterpret_cast<lane_type*>(dest));
+        return dest + count;
+      }
+    }
+
+    return anton::set_intersection(
+      first1, last1, first2, last2, dest,
+      [](auto const& lhs, auto const& rhs) { return lhs < rhs; });
+  }
+
+  // set_union
+  // Copies the elements present in either of [first1, last1[ and
+  // [first2, last2[ to the destination range starting at dest. If an element
+  // is present m times in the first range and n times in the second, it is
+  // copied max(m, n) times. Equivalent elements are copied from the first
+  // range.
+  //
+  // Requires:
+  // Both input ranges must be sorted with respect to compare and neither must
+  // overlap with the destination range.
+  //
+  // Returns: The end of the destination range.
+  //
+  // Complexity: At most 2 * (n + m) comparisons.
+  //
+  template<typename Input_Iterator1, typename Input_Iterator2,
+           typename Output_Iterator, typename Compare>
+  Output_Iterator set_union(Input_Iterator1 first1, Input_Iterator1 last1,
+                            Input_Iterator2 first2, Input_Iterator2 last2,
+                            Output_Iterator dest, Compare compare)
+  {
+    while(first1 != last1 && first2 != last2) {
+      if(compare(*first2, *first1)) {
+        *dest = *first2;
+        ++first2;
+      } else {
+        if(!compare(*first1, *first2)) {
+          ++first2;
+        }
+        *dest = *first1;
+        ++first1;
+      }
+      ++dest;
+    }
+
+    for(; first1 != last1; ++first1, ++dest) {
+      *dest = *first1;
+    }
+
+    for(; first2 != last2; ++first2, ++dest) {
+      *dest = *first2;
+    }
+
+    return dest;
+  }
+
+  template<typename Input_Iterator1, typename Input_Iterator2,
+           typename Output_Iterator>
+  Output_Iterator set_union(Input_Iterator1 first1, Input_Iterator1 last1,
+                            Input_Iterator2 first2, Input_Iterator2 last2,
+                            Output_Iterator dest)
+  {
+    return anton::set_union(
+      first1, last1, first2, last2, dest,
+      [](auto const& lhs, auto const& rhs) { return lhs < rhs; });
+  }
+
+  // set_symmetric_difference
+  // Copies the elements present in exactly one of [first1, last1[ and
+  // [first2, last2[ to the destination range starting at dest. If an element
+  // is present m times in the first range and n times in the second, it is
+  // copied |m - n| times.
+  //
+  // Requires:
+  // Both input ranges must be sorted with respect to compare and neither must
+  // overlap with the destination range.
+  //
+  // Returns: The end of the destination range.
+  //
+  // Complexity: At most 2 * (n + m) comparisons.
+  //
+  template<typename Input_Iterator1, typename Input_Iterator2,
+           typename Output_Iterator, typename Compare>
+  Output_Iterator set_symmetric_difference(Input_Iterator1 first1,
+                                           Input_Iterator1 last1,
+                                           Input_Iterator2 first2,
+                                           Input_Iterator2 last2,
+                                           Output_Iterator dest,
+                                           Compare compare)
+  {
+    while(first1 != last1 && first2 != last2) {
+      if(compare(*first1, *first2)) {
+        *dest = *first1;
+        ++dest;
+        ++first1;
+      } else if(compare(*first2, *first1)) {
+        *dest = *first2;
+        ++dest;
+        ++first2;
+      } else {
+        ++first1;
+        ++first2;
+      }
+    }
+
+    for(; first1 != last1; ++first1, ++dest) {
+      *dest = *first1;
+    }
+
+    for(; first2 != last2; ++first2, ++dest) {
+      *dest = *first2;
+    }
+
+    return dest;
+  }
+
+  template<typename Input_Iterator1, typename Input_Iterator2,
+           typename Output_Iterator>
+  Output_Iterator set_symmetric_difference(Input_Iterator1 first1,
+                                           Input_Iterator1 last1,
+                                           Input_Iterator2 first2,
+                                           Input_Iterator2 last2,
+                                           Output_Iterator dest)
+  {
+    return anton::set_symmetric_difference(
+      first1, last1, first2, last2, dest,
+      [](auto const& lhs, auto const& rhs) { return lhs < rhs; });
+  }
+
+  // merge
+  // Merges the sorted ranges [first1, last1[ and [first2, last2[ into the
+  // destination range starting at dest. The merge is stable, i.e. equivalent
+  // elements of the first range precede those of the second.
+  //
+  // Requires:
+  // Both input ranges must be sorted with respect to compare and neither must
+  // overlap with the destination range.
+  //
+  // Returns: The end of the destination range.
+  //
+  // Complexity: At most n + m - 1 comparisons.
+  //
+  template<typename Input_Iterator1, typename Input_Iterator2,
+           typename Output_Iterator, typename Compare>
+  Output_Iterator merge(Input_Iterator1 first1, Input_Iterator1 last1,
+                        Input_Iterator2 first2, Input_Iterator2 last2,
+                        Output_Iterator dest, Compare compare)
+  {
+    while(first1 != last1 && first2 != last2) {
+      if(compare(*first2, *first1)) {
+        *dest = *first2;
+        ++first2;
+      } else {
+        *dest = *first1;
+        ++first1;
+      }
+      ++dest;
+    }
+
+    for(; first1 != last1; ++first1, ++dest) {
+      *dest = *first1;
+    }
+
+    for(; first2 != last2; ++first2, ++dest) {
+      *dest = *first2;
+    }
+
+    return dest;
+  }
+
+  template<typename Input_Iterator1, typename Input_Iterator2,
+           typename Output_Iterator>
+  Output_Iterator merge(Input_Iterator1 first1, Input_Iterator1 last1,
+                        Input_Iterator2 first2, Input_Iterator2 last2,
+                        Output_Iterator dest)
+  {
+    return anton::merge(
+      first1, last1, first2, last2, dest,
+      [](auto const& lhs, auto const& rhs) { return lhs < rhs; });
+  }
+
   // mismatch
   // Finds the first mismatching pair of elements in the two ranges
   // defined by [first1, last1[ and [first2, first2 + (last1 - first1)[.
-  // The elements are compared using operator==.
+  // The elements are compared using operator==. Contiguous ranges of integers,
+  // enums and pointers given as pointers are compared with the vectorized
+  // kernels.
   //
   // Parameters:
   // first1, last1 - first range of elements.
@@ -260,12 +1010,21 @@ namespace anton {
                                                   Input_Iterator1 last1,
                                                   Input_Iterator2 first2)
   {
-    while(first1 != last1 && *first1 == *first2) {
-      ++first1;
-      ++first2;
-    }
+    if constexpr(detail::use_simd_compare<Input_Iterator1, Input_Iterator2>) {
+      constexpr i64 element_size =
+        sizeof(detail::simd_element<Input_Iterator1>);
+      i64 const index =
+        detail::simd_mismatch(first1, first2, (last1 - first1) * element_size) /
+        element_size;
+      return {first1 + index, first2 + index};
+    } else {
+      while(first1 != last1 && *first1 == *first2) {
+        ++first1;
+        ++first2;
+      }
 
-    return {first1, first2};
+      return {first1, first2};
+    }
   }
 
   // mismatch
@@ -301,7 +1060,8 @@ namespace anton {
   // mismatch
   // Finds the first mismatching pair of elements in the two ranges defined by
   // [first1, last1[ and [first2, last2[. The elements are compared using
-  // operator==.
+  // operator==. Contiguous ranges of integers, enums and pointers given as
+  // pointers are compared with the vectorized kernels.
   //
   // Parameters:
   // first1, last1 - first range of elements.
@@ -316,12 +1076,22 @@ namespace anton {
   mismatch(Input_Iterator1 first1, Input_Iterator1 last1,
            Input_Iterator2 first2, Input_Iterator2 last2)
   {
-    while(first1 != last1 && first2 != last2 && *first1 == *first2) {
-      ++first1;
-      ++first2;
-    }
+    if constexpr(detail::use_simd_compare<Input_Iterator1, Input_Iterator2>) {
+      constexpr i64 element_size =
+        sizeof(detail::simd_element<Input_Iterator1>);
+      i64 const length = math::min(last1 - first1, last2 - first2);
+      i64 const index =
+        detail::simd_mismatch(first1, first2, length * element_size) /
+        element_size;
+      return {first1 + index, first2 + index};
+    } else {
+      while(first1 != last1 && first2 != last2 && *first1 == *first2) {
+        ++first1;
+        ++first2;
+      }
 
-    return {first1, first2};
+      return {first1, first2};
+    }
   }
 
   // mismatch
@@ -353,4 +1123,427 @@ namespace anton {
 
     return {first1, first2};
   }
+
+  // equal
+  // Checks whether the ranges [first1, last1[ and
+  // [first2, first2 + (last1 - first1)[ are equal. The elements are compared
+  // using operator==. Contiguous ranges of integers, enums and pointers given
+  // as pointers are compared with the vectorized kernels.
+  //
+  // Complexity: At most 'last1 - first1' comparisons.
+  //
+  template<typename Input_Iterator1, typename Input_Iterator2>
+  [[nodiscard]] bool equal(Input_Iterator1 first1, Input_Iterator1 last1,
+                           Input_Iterator2 first2)
+  {
+    if constexpr(detail::use_simd_compare<Input_Iterator1, Input_Iterator2>) {
+      i64 const size =
+        (last1 - first1) *
+        static_cast<i64>(sizeof(detail::simd_element<Input_Iterator1>));
+      return detail::simd_mismatch(first1, first2, size) == size;
+    } else {
+      for(; first1 != last1; ++first1, ++first2) {
+        if(!(*first1 == *first2)) {
+          return false;
+        }
+      }
+      return true;
+    }
+  }
+
+  // equal
+  // Checks whether the ranges [first1, last1[ and
+  // [first2, first2 + (last1 - first1)[ are equal. The elements are compared
+  // using the predicate p.
+  //
+  // Complexity: At most 'last1 - first1' applications of the predicate.
+  //
+  template<typename Input_Iterator1, typename Input_Iterator2,
+           typename Predicate>
+  [[nodiscard]] bool equal(Input_Iterator1 first1, Input_Iterator1 last1,
+                           Input_Iterator2 first2, Predicate p)
+  {
+    for(; first1 != last1; ++first1, ++first2) {
+      if(!p(*first1, *first2)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // equal
+  // Checks whether the ranges [first1, last1[ and [first2, last2[ are equal,
+  // i.e. have the same length and equal elements. The elements are compared
+  // using operator==. Contiguous ranges of integers, enums and pointers given
+  // as pointers are compared with the vectorized kernels.
+  //
+  // Complexity: At most min(last1 - first1, last2 - first2) comparisons.
+  //
+  template<typename Input_Iterator1, typename Input_Iterator2>
+  [[nodiscard]] bool equal(Input_Iterator1 first1, Input_Iterator1 last1,
+                           Input_Iterator2 first2, Input_Iterator2 last2)
+  {
+    if constexpr(detail::use_simd_compare<Input_Iterator1, Input_Iterator2>) {
+      if(last1 - first1 != last2 - first2) {
+        return false;
+      }
+      return anton::equal(first1, last1, first2);
+    } else {
+      for(; first1 != last1 && first2 != last2; ++first1, ++first2) {
+        if(!(*first1 == *first2)) {
+          return false;
+        }
+      }
+      return first1 == last1 && first2 == last2;
+    }
+  }
+
+  // equal
+  // Checks whether the ranges [first1, last1[ and [first2, last2[ are equal,
+  // i.e. have the same length and equal elements. The elements are compared
+  // using the predicate p.
+  //
+  // Complexity: At most min(last1 - first1, last2 - first2) applications of
+  // the predicate.
+  //
+  template<typename Input_Iterator1, typename Input_Iterator2,
+           typename Predicate>
+  [[nodiscard]] bool equal(Input_Iterator1 first1, Input_Iterator1 last1,
+                           Input_Iterator2 first2, Input_Iterator2 last2,
+                           Predicate p)
+  {
+    for(; first1 != last1 && first2 != last2; ++first1, ++first2) {
+      if(!p(*first1, *first2)) {
+        return false;
+      }
+    }
+    return first1 == last1 && first2 == last2;
+  }
+
+  // min_element
+  // Finds the smallest element in the range [first, last[. Contiguous ranges
+  // of integers given as pointers are searched with the vectorized kernels.
+  //
+  // Returns: The iterator to the first smallest element or last if the range
+  // is empty.
+  //
+  // Complexity: Exactly max(last - first - 1, 0) comparisons in the scalar
+  // case.
+  //
+  template<typename Forward_Iterator>
+  [[nodiscard]] Forward_Iterator min_element(Forward_Iterator first,
+                                             Forward_Iterator last)
+  {
+    if constexpr(detail::use_simd_order<Forward_Iterator>) {
+      using element_type = detail::simd_element<Forward_Iterator>;
+      using lane_type = conditional<
+        is_signed<element_type>,
+        typename detail::Simd_Lane<sizeof(element_type)>::signed_type,
+        typename detail::Simd_Lane<sizeof(element_type)>::unsigned_type>;
+      if(first == last) {
+        return last;
+      }
+      return first + detail::simd_min_element(
+                       reinterpret_cast<lane_type const*>(first), last - first);
+    } else {
+      if(first == last) {
+        return last;
+      }
+
+      Forward_Iterator smallest = first;
+      for(++first; first != last; ++first) {
+        if(*first < *smallest) {
+          smallest = first;
+        }
+      }
+      return smallest;
+    }
+  }
+
+  // min_element
+  // Finds the smallest element in the range [first, last[. The elements are
+  // compared using the predicate.
+  //
+  // Parameters:
+  // first, last - the range to search.
+  //   predicate - comparison function. Returns true when the first argument is
+  //               less than (i.e. ordered before) the second argument.
+  //
+  // Returns: The iterator to the first smallest element or last if the range
+  // is empty.
+  //
+  template<typename Forward_Iterator, typename Predicate>
+  [[nodiscard]] Forward_Iterator min_element(Forward_Iterator first,
+                                             Forward_Iterator last,
+                                             Predicate predicate)
+  {
+    if(first == last) {
+      return last;
+    }
+
+    Forward_Iterator smallest = first;
+    for(++first; first != last; ++first) {
+      if(predicate(*first, *smallest)) {
+        smallest = first;
+      }
+    }
+    return smallest;
+  }
+
+  // max_element
+  // Finds the largest element in the range [first, last[. Contiguous ranges
+  // of integers given as pointers are searched with the vectorized kernels.
+  //
+  // Returns: The iterator to the first largest element or last if the range
+  // is empty.
+  //
+  // Complexity: Exactly max(last - first - 1, 0) comparisons in the scalar
+  // case.
+  //
+  template<typename Forward_Iterator>
+  [[nodiscard]] Forward_Iterator max_element(Forward_Iterator first,
+                                             Forward_Iterator last)
+  {
+    if constexpr(detail::use_simd_order<Forward_Iterator>) {
+      using element_type = detail::simd_element<Forward_Iterator>;
+      using lane_type = conditional<
+        is_signed<element_type>,
+        typename detail::Simd_Lane<sizeof(element_type)>::signed_type,
+        typename detail::Simd_Lane<sizeof(element_type)>::unsigned_type>;
+      if(first == last) {
+        return last;
+      }
+      return first + detail::simd_max_element(
+                       reinterpret_cast<lane_type const*>(first), last - first);
+    } else {
+      if(first == last) {
+        return last;
+      }
+
+      Forward_Iterator largest = first;
+      for(++first; first != last; ++first) {
+        if(*largest < *first) {
+          largest = first;
+        }
+      }
+      return largest;
+    }
+  }
+
+  // max_element
+  // Finds the largest element in the range [first, last[. The elements are
+  // compared using the predicate.
+  //
+  // Parameters:
+  // first, last - the range to search.
+  //   predicate - comparison function. Returns true when the first argument is
+  //               less than (i.e. ordered before) the second argument.
+  //
+  // Returns: The iterator to the first largest element or last if the range is
+  // empty.
+  //
+  template<typename Forward_Iterator, typename Predicate>
+  [[nodiscard]] Forward_Iterator max_element(Forward_Iterator first,
+                                             Forward_Iterator last,
+                                             Predicate predicate)
+  {
+    if(first == last) {
+      return last;
+    }
+
+    Forward_Iterator largest = first;
+    for(++first; first != last; ++first) {
+      if(predicate(*largest, *first)) {
+        largest = first;
+      }
+    }
+    return largest;
+  }
+
+  namespace detail {
+    // heap_sift_up
+    // Moves the element at index towards the root of the Arity-ary max-heap
+    // until its parent is not ordered before it.
+    //
+    template<i64 Arity, typename Random_Access_Iterator, typename Predicate>
+    void heap_sift_up(Random_Access_Iterator const first, i64 index,
+                      Predicate& predicate)
+    {
+      using value_type =
+        typename Iterator_Traits<Random_Access_Iterator>::value_type;
+      if(index == 0) {
+        return;
+      }
+
+      i64 parent = (index - 1) / Arity;
+      if(!predicate(*(first + parent), *(first + index))) {
+        return;
+      }
+
+      // Move the element through a hole instead of swapping.
+      value_type value = ANTON_MOV(*(first + index));
+      do {
+        *(first + index) = ANTON_MOV(*(first + parent));
+        index = parent;
+        if(index == 0) {
+          break;
+        }
+        parent = (index - 1) / Arity;
+      } while(predicate(*(first + parent), value));
+      *(first + index) = ANTON_MOV(value);
+    }
+
+    // heap_sift_down
+    // Moves the element at index towards the leaves of the Arity-ary max-heap
+    // [first, first + length) until none of its children is ordered after it.
+    //
+    template<i64 Arity, typename Random_Access_Iterator, typename Predicate>
+    void heap_sift_down(Random_Access_Iterator const first, i64 index,
+                        i64 const length, Predicate& predicate)
+    {
+      using value_type =
+        typename Iterator_Traits<Random_Access_Iterator>::value_type;
+      value_type value = ANTON_MOV(*(first + index));
+      while(true) {
+        i64 const first_child = Arity * index + 1;
+        if(first_child >= length) {
+          break;
+        }
+
+        // Find the largest child.
+        i64 const last_child = math::min(first_child + Arity, length);
+        i64 child = first_child;
+        for(i64 i = first_child + 1; i < last_child; ++i) {
+          if(predicate(*(first + child), *(first + i))) {
+            child = i;
+          }
+        }
+
+        if(!predicate(value, *(first + child))) {
+          break;
+        }
+
+        *(first + index) = ANTON_MOV(*(first + child));
+        index = child;
+      }
+      *(first + index) = ANTON_MOV(value);
+    }
+  } // namespace detail
+
+  // push_heap
+  // Inserts the element at last - 1 into the max-heap [first, last - 1[.
+  //
+  // Parameters:
+  // first, last - the heap including the element to insert.
+  //   predicate - comparison function. Returns true when the first argument is
+  //               less than (i.e. ordered before) the second argument.
+  //
+  // Complexity: O(log n) comparisons.
+  //
+  template<typename Random_Access_Iterator, typename Predicate>
+  void push_heap(Random_Access_Iterator first, Random_Access_Iterator last,
+                 Predicate predicate)
+  {
+    if(first != last) {
+      detail::heap_sift_up<2>(first, (last - first) - 1, predicate);
+    }
+  }
+
+  template<typename Random_Access_Iterator>
+  void push_heap(Random_Access_Iterator first, Random_Access_Iterator last)
+  {
+    using value_type =
+      typename Iterator_Traits<Random_Access_Iterator>::value_type;
+    anton::push_heap(
+      first, last,
+      [](value_type const& lhs, value_type const& rhs) { return lhs < rhs; });
+  }
+
+  // pop_heap
+  // Moves the largest element of the max-heap [first, last[ to last - 1 and
+  // makes [first, last - 1[ a max-heap.
+  //
+  // Parameters:
+  // first, last - the heap. Must not be empty.
+  //   predicate - comparison function. Returns true when the first argument is
+  //               less than (i.e. ordered before) the second argument.
+  //
+  // Complexity: O(log n) comparisons.
+  //
+  template<typename Random_Access_Iterator, typename Predicate>
+  void pop_heap(Random_Access_Iterator first, Random_Access_Iterator last,
+                Predicate predicate)
+  {
+    i64 const length = (last - first) - 1;
+    if(length > 0) {
+      swap(*first, *(first + length));
+      detail::heap_sift_down<2>(first, 0, length, predicate);
+    }
+  }
+
+  template<typename Random_Access_Iterator>
+  void pop_heap(Random_Access_Iterator first, Random_Access_Iterator last)
+  {
+    using value_type =
+      typename Iterator_Traits<Random_Access_Iterator>::value_type;
+    anton::pop_heap(
+      first, last,
+      [](value_type const& lhs, value_type const& rhs) { return lhs < rhs; });
+  }
+
+  // make_heap
+  // Arranges the range [first, last[ into a max-heap.
+  //
+  // Parameters:
+  // first, last - the range to arrange.
+  //   predicate - comparison function. Returns true when the first argument is
+  //               less than (i.e. ordered before) the second argument.
+  //
+  // Complexity: O(n) comparisons.
+  //
+  template<typename Random_Access_Iterator, typename Predicate>
+  void make_heap(Random_Access_Iterator first, Random_Access_Iterator last,
+                 Predicate predicate)
+  {
+    i64 const length = last - first;
+    for(i64 i = length / 2; i > 0;) {
+      --i;
+      detail::heap_sift_down<2>(first, i, length, predicate);
+    }
+  }
+
+  template<typename Random_Access_Iterator>
+  void make_heap(Random_Access_Iterator first, Random_Access_Iterator last)
+  {
+    using value_type =
+      typename Iterator_Traits<Random_Access_Iterator>::value_type;
+    anton::make_heap(
+      first, last,
+      [](value_type const& lhs, value_type const& rhs) { return lhs < rhs; });
+  }
+
+  // sort_heap
+  // Sorts the max-heap [first, last[ in ascending order.
+  //
+  // Complexity: O(n log n) comparisons.
+  //
+  template<typename Random_Access_Iterator, typename Predicate>
+  void sort_heap(Random_Access_Iterator first, Random_Access_Iterator last,
+                 Predicate predicate)
+  {
+    for(i64 length = (last - first) - 1; length > 0; --length) {
+      swap(*first, *(first + length));
+      detail::heap_sift_down<2>(first, 0, length, predicate);
+    }
+  }
+
+  template<typename Random_Access_Iterator>
+  void sort_heap(Random_Access_Iterator first, Random_Access_Iterator last)
+  {
+    using value_type =
+      typename Iterator_Traits<Random_Access_Iterator>::value_type;
+    anton::sort_heap(
+      first, last,
+      [](value_type const& lhs, value_type const& rhs) { return lhs < rhs; });
+  }
 } // namespace anton
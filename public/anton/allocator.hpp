@@ -48,10 +48,18 @@ namespace anton {
   [[nodiscard]] bool operator!=(Allocator const& lhs, Allocator const& rhs);
 
   // Arena_Allocator
+  // Allocates blocks of memory from an upstream allocator and suballocates
+  // them. The blocks are released only by reset or the destructor.
   //
   struct Arena_Allocator: public Allocator {
     Arena_Allocator(i64 default_block_size = 65536,
                     i64 default_block_alignment = 8);
+    // Arena_Allocator
+    // Creates an arena that allocates its blocks from upstream.
+    //
+    explicit Arena_Allocator(Memory_Allocator* upstream,
+                             i64 default_block_size = 65536,
+                             i64 default_block_alignment = 8);
     Arena_Allocator(Arena_Allocator const& allocator) = delete;
     Arena_Allocator(Arena_Allocator&& allocator);
     ~Arena_Allocator() override;
@@ -101,8 +109,11 @@ namespace anton {
       void* free = nullptr;
       // Pointer to the end of the block.
       void* end = nullptr;
+      // The alignment the block has been allocated with.
+      i64 alignment = 0;
     };
 
+    Memory_Allocator* upstream;
     Block* first = nullptr;
     Block* last = nullptr;
     i64 default_block_size;
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <anton/type_traits.hpp>
+#include <anton/types.hpp>
+
+// We implement the atomics on top of the __atomic builtins provided by GCC and
+// Clang (including clang-cl) to avoid depending on the <atomic> header.
+
+namespace anton {
+  // cache_line_size
+  // The assumed size of a cache line. Used to pad data structures shared
+  // between threads in order to avoid false sharing.
+  //
+  constexpr i64 cache_line_size = 64;
+
+  enum struct Memory_Order : i32 {
+    relaxed = __ATOMIC_RELAXED,
+    acquire = __ATOMIC_ACQUIRE,
+    release = __ATOMIC_RELEASE,
+    acq_rel = __ATOMIC_ACQ_REL,
+    seq_cst = __ATOMIC_SEQ_CST,
+  };
+
+  // Atomic
+  // Wrapper providing atomic access to a trivially copyable object.
+  //
+  // The compare_exchange functions update expected with the current value on
+  // failure. The failure order must not be release or acq_rel.
+  //
+  template<typename T>
+  struct Atomic {
+    static_assert(is_trivially_copyable<T>,
+                  "Atomic requires a trivially copyable type");
+
+  public:
+    using value_type = T;
+
+    Atomic() = default;
+    constexpr Atomic(T const value): _value(value) {}
+    Atomic(Atomic const&) = delete;
+    Atomic& operator=(Atomic const&) = delete;
+
+    [[nodiscard]] T load(Memory_Order const order = Memory_Order::seq_cst) const
+    {
+      return __atomic_load_n(&_value, static_cast<i32>(order));
+    }
+
+    void store(T const value, Memory_Order const order = Memory_Order::seq_cst)
+    {
+      __atomic_store_n(&_value, value, static_cast<i32>(order));
+    }
+
+    T exchange(T const value, Memory_Order const order = Memory_Order::seq_cst)
+    {
+      return __atomic_exchange_n(&_value, value, static_cast<i32>(order));
+    }
+
+    bool compare_exchange_weak(
+      T& expected, T const desired,
+      Memory_Order const success = Memory_Order::seq_cst,
+      Memory_Order const failure = Memory_Order::seq_cst)
+    {
+      return __atomic_compare_exchange_n(&_value, &expected, desired, true,
+                                         static_cast<i32>(success),
+                                         static_cast<i32>(failure));
+    }
+
+    bool compare_exchange_strong(
+      T& expected, T const desired,
+      Memory_Order const success = Memory_Order::seq_cst,
+      Memory_Order const failure = Memory_Order::seq_cst)
+    {
+      return __atomic_compare_exchange_n(&_value, &expected, desired, false,
+                                         static_cast<i32>(success),
+                                         static_cast<i32>(failure));
+    }
+
+    // fetch_add, fetch_sub, fetch_and, fetch_or
+    // Available only for integral types.
+    //
+    // Returns:
+    // The value preceding the modification.
+    //
+    T fetch_add(T const value,
+                Memory_Order const order = Memory_Order::seq_cst)
+    {
+      static_assert(is_integral<T>, "fetch_add requires an integral type");
+      return __atomic_fetch_add(&_value, value, static_cast<i32>(order));
+    }
+
+    T fetch_sub(T const value,
+                Memory_Order const order = Memory_Order::seq_cst)
+    {
+      static_assert(is_integral<T>, "fetch_sub requires an integral type");
+      return __atomic_fetch_sub(&_value, value, static_cast<i32>(order));
+    }
+
+    T fetch_and(T const value,
+                Memory_Order const order = Memory_Order::seq_cst)
+    {
+      static_assert(is_integral<T>, "fetch_and requires an integral type");
+      return __atomic_fetch_and(&_value, value, static_cast<i32>(order));
+    }
+
+    T fetch_or(T const value, Memory_Order const order = Memory_Order::seq_cst)
+    {
+      static_assert(is_integral<T>, "fetch_or requires an integral type");
+      return __atomic_fetch_or(&_value, value, static_cast<i32>(order));
+    }
+
+  private:
+    T _value;
+  };
+
+  // atomic_thread_fence
+  // Establishes memory synchronization ordering of non-atomic and relaxed
+  // atomic accesses.
+  //
+  inline void atomic_thread_fence(Memory_Order const order)
+  {
+    __atomic_thread_fence(static_cast<i32>(order));
+  }
+
+  // cpu_relax
+  // Hints the processor that the calling thread is in a spin-wait loop.
+  //
+  inline void cpu_relax()
+  {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+  }
+} // namespace anton
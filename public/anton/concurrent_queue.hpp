@@ -0,0 +1,551 @@
+#pragma once
+
+#include <anton/aligned_buffer.hpp>
+#include <anton/allocator.hpp>
+#include <anton/assert.hpp>
+#include <anton/atomic.hpp>
+#include <anton/math/math.hpp>
+#include <anton/memory.hpp>
+#include <anton/optional.hpp>
+#include <anton/slice.hpp>
+#include <anton/types.hpp>
+
+namespace anton {
+  namespace detail {
+    // round_up_to_power_of_2
+    // Rounds value up to the nearest power of 2 not less than minimum.
+    //
+    [[nodiscard]] constexpr i64 round_up_to_power_of_2(i64 const value,
+                                                       i64 const minimum)
+    {
+      i64 result = minimum;
+      while(result < value) {
+        result *= 2;
+      }
+      return result;
+    }
+  } // namespace detail
+
+  // SPSC_Queue
+  // A bounded lock-free queue for exactly one producer thread and exactly one
+  // consumer thread. The capacity is rounded up to a power of 2.
+  //
+  // The producer and the consumer indices are kept on separate cache lines
+  // and each side caches the last observed index of the other side, so that
+  // in the steady state an operation costs one release store and no shared
+  // cache line traffic besides the element itself.
+  //
+  // try_push, try_emplace and push_n may only be called by the producer.
+  // try_pop and pop_n may only be called by the consumer.
+  //
+  template<typename T>
+  struct SPSC_Queue {
+  public:
+    using value_type = T;
+    using allocator_type = Polymorphic_Allocator;
+    using size_type = i64;
+
+    explicit SPSC_Queue(size_type capacity);
+    SPSC_Queue(allocator_type const& allocator, size_type capacity);
+    SPSC_Queue(SPSC_Queue const&) = delete;
+    SPSC_Queue(SPSC_Queue&&) = delete;
+    ~SPSC_Queue();
+    SPSC_Queue& operator=(SPSC_Queue const&) = delete;
+    SPSC_Queue& operator=(SPSC_Queue&&) = delete;
+
+    // try_push
+    // Appends an element to the queue if it is not full.
+    //
+    // Returns:
+    // true if the element has been pushed, false if the queue is full.
+    //
+    [[nodiscard]] bool try_push(value_type const& value);
+    [[nodiscard]] bool try_push(value_type&& value);
+    template<typename... Args>
+    [[nodiscard]] bool try_emplace(Args&&... args);
+
+    // push_n
+    // Copies as many elements from the front of values as there is free space
+    // in the queue and publishes them at once.
+    //
+    // Returns:
+    // The number of elements pushed.
+    //
+    size_type push_n(Slice<T const> values);
+
+    // try_pop
+    // Removes the element at the front of the queue.
+    //
+    // Returns:
+    // The removed element or null_optional if the queue is empty.
+    //
+    [[nodiscard]] Optional<T> try_pop();
+
+    // pop_n
+    // Removes up to destination.size() elements from the front of the queue
+    // and move assigns them to destination.
+    //
+    // Returns:
+    // The number of elements popped.
+    //
+    size_type pop_n(Slice<T> destination);
+
+    [[nodiscard]] size_type capacity() const;
+
+    // size_approx
+    // The number of elements in the queue. The value may be outdated by the
+    // time it is returned if the other thread operates on the queue.
+    //
+    [[nodiscard]] size_type size_approx() const;
+
+  private:
+    // Index of the next element to be pushed. Written by the producer.
+    alignas(cache_line_size) Atomic<i64> _tail = 0;
+    // The producer's copy of _head.
+    i64 _cached_head = 0;
+    // Index of the next element to be popped. Written by the consumer.
+    alignas(cache_line_size) Atomic<i64> _head = 0;
+    // The consumer's copy of _tail.
+    i64 _cached_tail = 0;
+    alignas(cache_line_size) allocator_type _allocator;
+    T* _data = nullptr;
+    i64 _capacity = 0;
+  };
+
+  // MPMC_Queue
+  // A bounded lock-free queue for any number of producers and consumers based
+  // on Dmitry Vyukov's bounded MPMC queue. Every cell carries a sequence number
+  // that tells whether the cell is ready to be written or read at the given
+  // position, so that producers and consumers only contend on their own
+  // position counter. The capacity is rounded up to a power of 2.
+  //
+  // push_n and pop_n claim a run of consecutive cells with a single
+  // compare-and-swap.
+  //
+  template<typename T>
+  struct MPMC_Queue {
+  public:
+    using value_type = T;
+    using allocator_type = Polymorphic_Allocator;
+    using size_type = i64;
+
+    explicit MPMC_Queue(size_type capacity);
+    MPMC_Queue(allocator_type const& allocator, size_type capacity);
+    MPMC_Queue(MPMC_Queue const&) = delete;
+    MPMC_Queue(MPMC_Queue&&) = delete;
+    ~MPMC_Queue();
+    MPMC_Queue& operator=(MPMC_Queue const&) = delete;
+    MPMC_Queue& operator=(MPMC_Queue&&) = delete;
+
+    // try_push
+    // Appends an element to the queue if it is not full.
+    //
+    // Returns:
+    // true if the element has been pushed, false if the queue is full.
+    //
+    [[nodiscard]] bool try_push(value_type const& value);
+    [[nodiscard]] bool try_push(value_type&& value);
+    template<typename... Args>
+    [[nodiscard]] bool try_emplace(Args&&... args);
+
+    // push_n
+    // Copies as many elements from the front of values as there are
+    // consecutive free cells in the queue.
+    //
+    // Returns:
+    // The number of elements pushed.
+    //
+    size_type push_n(Slice<T const> values);
+
+    // try_pop
+    // Removes the element at the front of the queue.
+    //
+    // Returns:
+    // The removed element or null_optional if the queue is empty.
+    //
+    [[nodiscard]] Optional<T> try_pop();
+
+    // pop_n
+    // Removes up to destination.size() elements from the front of the queue
+    // and move assigns them to destination.
+    //
+    // Returns:
+    // The number of elements popped.
+    //
+    size_type pop_n(Slice<T> destination);
+
+    [[nodiscard]] size_type capacity() const;
+
+  private:
+    struct Cell {
+      Atomic<i64> sequence;
+      Aligned_Buffer<sizeof(T), alignof(T)> storage;
+
+      [[nodiscard]] T* get()
+      {
+        return reinterpret_cast<T*>(&storage);
+      }
+    };
+
+    alignas(cache_line_size) Atomic<i64> _enqueue_position = 0;
+    alignas(cache_line_size) Atomic<i64> _dequeue_position = 0;
+    alignas(cache_line_size) allocator_type _allocator;
+    Cell* _cells = nullptr;
+    i64 _capacity = 0;
+
+    // claim_push
+    // Claims up to n consecutive cells ready to be written.
+    //
+    // Returns:
+    // The number of claimed cells. position is set to the position of the
+    // first claimed cell.
+    //
+    [[nodiscard]] i64 claim_push(i64 n, i64& position);
+    // claim_pop
+    // Claims up to n consecutive cells ready to be read.
+    //
+    // Returns:
+    // The number of claimed cells. position is set to the position of the
+    // first claimed cell.
+    //
+    [[nodiscard]] i64 claim_pop(i64 n, i64& position);
+  };
+} // namespace anton
+
+namespace anton {
+  template<typename T>
+  SPSC_Queue<T>::SPSC_Queue(size_type const capacity)
+    : SPSC_Queue(allocator_type(), capacity)
+  {
+  }
+
+  template<typename T>
+  SPSC_Queue<T>::SPSC_Queue(allocator_type const& allocator,
+                            size_type const capacity)
+    : _allocator(allocator),
+      _capacity(detail::round_up_to_power_of_2(capacity, 1))
+  {
+    _data = static_cast<T*>(
+      _allocator.allocate(_capacity * static_cast<isize>(sizeof(T)),
+                          static_cast<isize>(alignof(T))));
+  }
+
+  template<typename T>
+  SPSC_Queue<T>::~SPSC_Queue()
+  {
+    i64 const head = _head.load(Memory_Order::relaxed);
+    i64 const tail = _tail.load(Memory_Order::relaxed);
+    for(i64 i = head; i != tail; ++i) {
+      anton::destruct(_data + (i & (_capacity - 1)));
+    }
+    _allocator.deallocate(_data, _capacity * static_cast<isize>(sizeof(T)),
+                          static_cast<isize>(alignof(T)));
+  }
+
+  template<typename T>
+  bool SPSC_Queue<T>::try_push(value_type const& value)
+  {
+    return try_emplace(value);
+  }
+
+  template<typename T>
+  bool SPSC_Queue<T>::try_push(value_type&& value)
+  {
+    return try_emplace(ANTON_MOV(value));
+  }
+
+  template<typename T>
+  template<typename... Args>
+  bool SPSC_Queue<T>::try_emplace(Args&&... args)
+  {
+    i64 const tail = _tail.load(Memory_Order::relaxed);
+    if(tail - _cached_head == _capacity) {
+      _cached_head = _head.load(Memory_Order::acquire);
+      if(tail - _cached_head == _capacity) {
+        return false;
+      }
+    }
+
+    anton::construct(_data + (tail & (_capacity - 1)), ANTON_FWD(args)...);
+    _tail.store(tail + 1, Memory_Order::release);
+    return true;
+  }
+
+  template<typename T>
+  auto SPSC_Queue<T>::push_n(Slice<T const> const values) -> size_type
+  {
+    i64 const tail = _tail.load(Memory_Order::relaxed);
+    i64 free = _capacity - (tail - _cached_head);
+    if(free < values.size()) {
+      _cached_head = _head.load(Memory_Order::acquire);
+      free = _capacity - (tail - _cached_head);
+    }
+
+    i64 const count = math::min(free, values.size());
+    if(count == 0) {
+      return 0;
+    }
+
+    // The free space may wrap around the end of the buffer.
+    i64 const offset = tail & (_capacity - 1);
+    i64 const first_count = math::min(count, _capacity - offset);
+    anton::uninitialized_copy_n(values.data(), first_count, _data + offset);
+    anton::uninitialized_copy_n(values.data() + first_count,
+                                count - first_count, _data);
+    _tail.store(tail + count, Memory_Order::release);
+    return count;
+  }
+
+  template<typename T>
+  Optional<T> SPSC_Queue<T>::try_pop()
+  {
+    i64 const head = _head.load(Memory_Order::relaxed);
+    if(head == _cached_tail) {
+      _cached_tail = _tail.load(Memory_Order::acquire);
+      if(head == _cached_tail) {
+        return null_optional;
+      }
+    }
+
+    T* const element = _data + (head & (_capacity - 1));
+    Optional<T> result(variadic_construct, ANTON_MOV(*element));
+    anton::destruct(element);
+    _head.store(head + 1, Memory_Order::release);
+    return result;
+  }
+
+  template<typename T>
+  auto SPSC_Queue<T>::pop_n(Slice<T> const destination) -> size_type
+  {
+    i64 const head = _head.load(Memory_Order::relaxed);
+    i64 available = _cached_tail - head;
+    if(available < destination.size()) {
+      _cached_tail = _tail.load(Memory_Order::acquire);
+      available = _cached_tail - head;
+    }
+
+    i64 const count = math::min(available, destination.size());
+    if(count == 0) {
+      return 0;
+    }
+
+    i64 const offset = head & (_capacity - 1);
+    i64 const first_count = math::min(count, _capacity - offset);
+    T* const first = _data + offset;
+    anton::move(first, first + first_count, destination.data());
+    anton::destruct_n(first, first_count);
+    anton::move(_data, _data + (count - first_count),
+                destination.data() + first_count);
+    anton::destruct_n(_data, count - first_count);
+    _head.store(head + count, Memory_Order::release);
+    return count;
+  }
+
+  template<typename T>
+  auto SPSC_Queue<T>::capacity() const -> size_type
+  {
+    return _capacity;
+  }
+
+  template<typename T>
+  auto SPSC_Queue<T>::size_approx() const -> size_type
+  {
+    i64 const head = _head.load(Memory_Order::acquire);
+    i64 const tail = _tail.load(Memory_Order::acquire);
+    return tail - head;
+  }
+
+  template<typename T>
+  MPMC_Queue<T>::MPMC_Queue(size_type const capacity)
+    : MPMC_Queue(allocator_type(), capacity)
+  {
+  }
+
+  template<typename T>
+  MPMC_Queue<T>::MPMC_Queue(allocator_type const& allocator,
+                            size_type const capacity)
+    : _allocator(allocator),
+      _capacity(detail::round_up_to_power_of_2(capacity, 2))
+  {
+    _cells = static_cast<Cell*>(
+      _allocator.allocate(_capacity * static_cast<isize>(sizeof(Cell)),
+                          static_cast<isize>(alignof(Cell))));
+    for(i64 i = 0; i < _capacity; ++i) {
+      anton::construct(_cells + i);
+      _cells[i].sequence.store(i, Memory_Order::relaxed);
+    }
+  }
+
+  template<typename T>
+  MPMC_Queue<T>::~MPMC_Queue()
+  {
+    i64 const first = _dequeue_position.load(Memory_Order::relaxed);
+    i64 const last = _enqueue_position.load(Memory_Order::relaxed);
+    for(i64 i = first; i != last; ++i) {
+      anton::destruct(_cells[i & (_capacity - 1)].get());
+    }
+    anton::destruct_n(_cells, _capacity);
+    _allocator.deallocate(_cells, _capacity * static_cast<isize>(sizeof(Cell)),
+                          static_cast<isize>(alignof(Cell)));
+  }
+
+  template<typename T>
+  bool MPMC_Queue<T>::try_push(value_type const& value)
+  {
+    return try_emplace(value);
+  }
+
+  template<typename T>
+  bool MPMC_Queue<T>::try_push(value_type&& value)
+  {
+    return try_emplace(ANTON_MOV(value));
+  }
+
+  template<typename T>
+  template<typename... Args>
+  bool MPMC_Queue<T>::try_emplace(Args&&... args)
+  {
+    i64 position;
+    if(claim_push(1, position) == 0) {
+      return false;
+    }
+
+    Cell& cell = _cells[position & (_capacity - 1)];
+    anton::construct(cell.get(), ANTON_FWD(args)...);
+    cell.sequence.store(position + 1, Memory_Order::release);
+    return true;
+  }
+
+  template<typename T>
+  auto MPMC_Queue<T>::push_n(Slice<T const> const values) -> size_type
+  {
+    i64 position;
+    i64 const count = claim_push(values.size(), position);
+    for(i64 i = 0; i < count; ++i) {
+      Cell& cell = _cells[(position + i) & (_capacity - 1)];
+      anton::construct(cell.get(), values[i]);
+      cell.sequence.store(position + i + 1, Memory_Order::release);
+    }
+    return count;
+  }
+
+  template<typename T>
+  Optional<T> MPMC_Queue<T>::try_pop()
+  {
+    i64 position;
+    if(claim_pop(1, position) == 0) {
+      return null_optional;
+    }
+
+    Cell& cell = _cells[position & (_capacity - 1)];
+    Optional<T> result(variadic_construct, ANTON_MOV(*cell.get()));
+    anton::destruct(cell.get());
+    cell.sequence.store(position + _capacity, Memory_Order::release);
+    return result;
+  }
+
+  template<typename T>
+  auto MPMC_Queue<T>::pop_n(Slice<T> const destination) -> size_type
+  {
+    i64 position;
+    i64 const count = claim_pop(destination.size(), position);
+    for(i64 i = 0; i < count; ++i) {
+      Cell& cell = _cells[(position + i) & (_capacity - 1)];
+      destination[i] = ANTON_MOV(*cell.get());
+      anton::destruct(cell.get());
+      cell.sequence.store(position + i + _capacity, Memory_Order::release);
+    }
+    return count;
+  }
+
+  template<typename T>
+  auto MPMC_Queue<T>::capacity() const -> size_type
+  {
+    return _capacity;
+  }
+
+  template<typename T>
+  i64 MPMC_Queue<T>::claim_push(i64 const n, i64& position)
+  {
+    i64 const limit = math::min(n, _capacity);
+    if(limit <= 0) {
+      return 0;
+    }
+
+    position = _enqueue_position.load(Memory_Order::relaxed);
+    while(true) {
+      // A cell at position p is ready to be written when its sequence equals
+      // p. Count the ready cells starting at position.
+      i64 count = 0;
+      i64 difference = 0;
+      for(; count < limit; ++count) {
+        i64 const expected = position + count;
+        i64 const sequence =
+          _cells[expected & (_capacity - 1)].sequence.load(
+            Memory_Order::acquire);
+        difference = sequence - expected;
+        if(difference != 0) {
+          break;
+        }
+      }
+
+      if(count > 0) {
+        if(_enqueue_position.compare_exchange_weak(position, position + count,
+                                                   Memory_Order::relaxed,
+                                                   Memory_Order::relaxed)) {
+          return count;
+        }
+        // position has been updated by the failed compare_exchange.
+      } else if(difference < 0) {
+        // The cell still holds an element from the previous lap. The queue
+        // is full.
+        return 0;
+      } else {
+        // Another producer has claimed the cell.
+        position = _enqueue_position.load(Memory_Order::relaxed);
+      }
+    }
+  }
+
+  template<typename T>
+  i64 MPMC_Queue<T>::claim_pop(i64 const n, i64& position)
+  {
+    i64 const limit = math::min(n, _capacity);
+    if(limit <= 0) {
+      return 0;
+    }
+
+    position = _dequeue_position.load(Memory_Order::relaxed);
+    while(true) {
+      // A cell at position p is ready to be read when its sequence equals
+      // p + 1. Count the ready cells starting at position.
+      i64 count = 0;
+      i64 difference = 0;
+      for(; count < limit; ++count) {
+        i64 const expected = position + count + 1;
+        i64 const sequence =
+          _cells[(expected - 1) & (_capacity - 1)].sequence.load(
+            Memory_Order::acquire);
+        difference = sequence - expected;
+        if(difference != 0) {
+          break;
+        }
+      }
+
+      if(count > 0) {
+        if(_dequeue_position.compare_exchange_weak(position, position + count,
+                                                   Memory_Order::relaxed,
+                                                   Memory_Order::relaxed)) {
+          return count;
+        }
+        // position has been updated by the failed compare_exchange.
+      } else if(difference < 0) {
+        // The cell has not been written yet. The queue is empty.
+        return 0;
+      } else {
+        // Another consumer has claimed the cell.
+        position = _dequeue_position.load(Memory_Order::relaxed);
+      }
+    }
+  }
+} // namespace anton
@@ -128,24 +128,10 @@ namespace anton {
   }
 
   // Computes the number of UTF-8 code points between lhs and rhs.
-  // This is a linear-time operation.
-  [[nodiscard]] inline UTF8_Char_Iterator::difference_type
-  operator-(UTF8_Char_Iterator const& lhs, UTF8_Char_Iterator rhs)
-  {
-    UTF8_Char_Iterator::difference_type difference = 0;
-    if(lhs < rhs) {
-      while(lhs != rhs) {
-        --rhs;
-        difference -= 1;
-      }
-    } else {
-      while(lhs != rhs) {
-        ++rhs;
-        difference += 1;
-      }
-    }
-    return difference;
-  }
+  // This is a linear-time operation, vectorized unless either iterator points
+  // before the beginning of the string.
+  [[nodiscard]] UTF8_Char_Iterator::difference_type
+  operator-(UTF8_Char_Iterator const& lhs, UTF8_Char_Iterator const& rhs);
 
   struct UTF8_Bytes {
   public:
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <anton/types.hpp>
+
+namespace anton::detail {
+  // Two_Way_Table
+  // The preprocessed substring used by the Two-Way string matching algorithm
+  // by Crochemore and Perrin, which finds a substring in linear time and
+  // constant space, extended with a shift table on the last byte of the
+  // window which skips most of the positions in typical text.
+  //
+  struct Two_Way_Table {
+    // The end of the left half of the critical factorization.
+    i64 suffix;
+    // The period of the substring or the shift used when the substring is
+    // not periodic.
+    i64 period;
+    // The length of the prefix known to match after shifting by the period.
+    // 0 when the substring is not periodic.
+    i64 memory;
+    // 1 + the position of the last occurrence of each byte in the substring
+    // or 0 if the byte does not occur.
+    i64 shift[256];
+  };
+
+  // build_two_way_table
+  // Preprocesses [substr, substr + substr_size[. substr_size must be greater
+  // than 0.
+  //
+  void build_two_way_table(Two_Way_Table& table, char8 const* substr,
+                           i64 substr_size);
+
+  // find_substring_bytes
+  // The runtime implementation of find_substring. Substrings of up to 32
+  // bytes are located with a vectorized filter on their first and last
+  // bytes. Longer substrings and strings on which the filter finds too many
+  // false candidates are searched with the Two-Way algorithm.
+  //
+  // Parameters:
+  //      string - the string to search.
+  //        size - the number of bytes in string.
+  //      substr - the substring to look for.
+  // substr_size - the number of bytes in substr.
+  //       table - the Two-Way table of substr or nullptr to build it on
+  //               demand.
+  //
+  // Returns:
+  // The position of the first occurrence of substr or npos.
+  //
+  [[nodiscard]] i64 find_substring_bytes(char8 const* string, i64 size,
+                                         char8 const* substr, i64 substr_size,
+                                         Two_Way_Table const* table = nullptr);
+
+  // find_last_substring_bytes
+  // The runtime implementation of find_last_substring. Mirrors
+  // find_substring_bytes.
+  //
+  // Returns:
+  // The position of the last occurrence of substr or npos.
+  //
+  [[nodiscard]] i64 find_last_substring_bytes(char8 const* string, i64 size,
+                                              char8 const* substr,
+                                              i64 substr_size);
+} // namespace anton::detail
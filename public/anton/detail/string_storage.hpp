@@ -0,0 +1,146 @@
+#pragma once
+
+#include <anton/allocator.hpp>
+#include <anton/types.hpp>
+
+namespace anton::detail {
+  // String_Storage
+  // Storage of the bytes of String and String7 with the small-string
+  // optimization. Strings shorter than inline_capacity bytes (the
+  // null-terminator included) are stored inside the object and do not
+  // allocate.
+  //
+  // The last byte of the storage is the tag. Inline strings store their size
+  // in it. Heap strings set its most significant bit, which on little-endian
+  // platforms is the most significant bit of the capacity. The bytes past the
+  // end of the string up to the capacity are always zero, hence the string is
+  // always null-terminated.
+  //
+  // The storage does not own an allocator. The functions that allocate or
+  // deallocate take the allocator of the string.
+  //
+  struct String_Storage {
+  public:
+    // The number of bytes available to inline strings including the
+    // null-terminator.
+    static constexpr i64 inline_capacity = 23;
+    // The smallest capacity of a heap allocated string.
+    static constexpr i64 min_allocation_size = 64;
+
+    // Constructs an empty inline string.
+    String_Storage();
+    // Takes over the contents of other and leaves it empty.
+    String_Storage(String_Storage&& other);
+    String_Storage(String_Storage const&) = delete;
+    String_Storage& operator=(String_Storage const&) = delete;
+    String_Storage& operator=(String_Storage&&) = delete;
+    // The storage must be released before it is destroyed.
+    ~String_Storage() = default;
+
+    [[nodiscard]] bool is_inline() const
+    {
+      return tag() < 0x80;
+    }
+
+    // The accessors select between the inline and the heap value with a mask
+    // instead of branching on the tag. The heap fields are always readable
+    // since they overlap the inline buffer.
+
+    [[nodiscard]] char8* data()
+    {
+      u64 const mask = static_cast<u64>(heap_mask());
+      u64 const address = (reinterpret_cast<u64>(_inline) & ~mask) |
+                          (reinterpret_cast<u64>(_heap.data) & mask);
+      return reinterpret_cast<char8*>(address);
+    }
+
+    [[nodiscard]] char8 const* data() const
+    {
+      u64 const mask = static_cast<u64>(heap_mask());
+      u64 const address = (reinterpret_cast<u64>(_inline) & ~mask) |
+                          (reinterpret_cast<u64>(_heap.data) & mask);
+      return reinterpret_cast<char8 const*>(address);
+    }
+
+    [[nodiscard]] i64 size() const
+    {
+      i64 const mask = heap_mask();
+      return (static_cast<i64>(tag()) & ~mask) | (_heap.size & mask);
+    }
+
+    [[nodiscard]] i64 capacity() const
+    {
+      i64 const mask = heap_mask();
+      i64 const heap_capacity = static_cast<i64>(_heap.capacity & ~heap_flag);
+      return (inline_capacity & ~mask) | (heap_capacity & mask);
+    }
+
+    // set_size
+    // Changes the size without touching the bytes. n must be less than
+    // capacity().
+    //
+    void set_size(i64 n);
+
+    // reserve
+    // Ensures that a string of size n and the null-terminator fit in the
+    // storage growing the capacity geometrically.
+    //
+    void reserve(Polymorphic_Allocator& allocator, i64 n);
+
+    // reserve_exact
+    // Ensures that the capacity is at least new_capacity bytes. Allocates
+    // exactly new_capacity bytes if the capacity is smaller.
+    //
+    void reserve_exact(Polymorphic_Allocator& allocator, i64 new_capacity);
+
+    // assign
+    // Replaces the contents with the bytes [first, first + n[. The bytes may
+    // be a part of the string.
+    //
+    void assign(Polymorphic_Allocator& allocator, char8 const* first, i64 n);
+
+    // clear
+    // Zeroes the bytes of the string and sets the size to 0. Does not
+    // deallocate.
+    //
+    void clear();
+
+    // release
+    // Deallocates the heap storage and leaves an empty inline string.
+    //
+    void release(Polymorphic_Allocator& allocator);
+
+    friend void swap(String_Storage& lhs, String_Storage& rhs);
+
+  private:
+    struct Heap {
+      char8* data;
+      i64 size;
+      u64 capacity;
+    };
+
+    union {
+      Heap _heap;
+      char8 _inline[sizeof(Heap)];
+    };
+
+    // Set in the capacity of heap strings. Lies in the tag byte.
+    static constexpr u64 heap_flag = static_cast<u64>(1) << 63;
+    static constexpr i64 tag_index = sizeof(Heap) - 1;
+
+    [[nodiscard]] u8 tag() const
+    {
+      return reinterpret_cast<u8 const*>(this)[tag_index];
+    }
+
+    // heap_mask
+    // All bits set if the string is stored on the heap, no bits otherwise.
+    //
+    [[nodiscard]] i64 heap_mask() const
+    {
+      return -static_cast<i64>(tag() >> 7);
+    }
+
+    void reallocate(Polymorphic_Allocator& allocator, i64 new_capacity);
+  };
+} // namespace anton::detail
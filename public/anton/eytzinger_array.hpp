@@ -0,0 +1,290 @@
+#pragma once
+
+#include <anton/allocator.hpp>
+#include <anton/array.hpp>
+#include <anton/functors.hpp>
+#include <anton/intrinsics.hpp>
+#include <anton/memory.hpp>
+#include <anton/swap.hpp>
+#include <anton/tags.hpp>
+#include <anton/types.hpp>
+
+namespace anton {
+  // Eytzinger_Array
+  // A read-only sorted array stored in the breadth-first order of a complete
+  // binary search tree (the Eytzinger layout). The element at 1-based
+  // position k has its children at 2k and 2k + 1.
+  //
+  // The first levels of the tree are packed together at the front of the
+  // array and stay in the cache, and the descendants of a node a few levels
+  // below it occupy consecutive memory, which allows the search to prefetch
+  // them several iterations ahead. Lookups into large arrays are considerably
+  // faster than binary search over the sorted order.
+  //
+  // The elements are compared with Compare. The array cannot be modified
+  // after construction.
+  //
+  template<typename T, typename Compare = Less_Compare<T>>
+  struct Eytzinger_Array {
+  public:
+    using value_type = T;
+    using allocator_type = Polymorphic_Allocator;
+    using size_type = i64;
+    using const_iterator = T const*;
+
+    Eytzinger_Array();
+    explicit Eytzinger_Array(allocator_type const& allocator);
+    // Eytzinger_Array
+    // Constructs the array from the elements of [first, last[ which must be
+    // sorted with respect to compare.
+    //
+    // Complexity: O(n).
+    //
+    template<typename Forward_Iterator>
+    Eytzinger_Array(Range_Construct_Tag, Forward_Iterator first,
+                    Forward_Iterator last, Compare const& compare = Compare());
+    template<typename Forward_Iterator>
+    Eytzinger_Array(allocator_type const& allocator, Range_Construct_Tag,
+                    Forward_Iterator first, Forward_Iterator last,
+                    Compare const& compare = Compare());
+
+    // size
+    // The number of elements contained in the array.
+    //
+    [[nodiscard]] size_type size() const;
+
+    // data
+    // The elements in the Eytzinger order.
+    //
+    [[nodiscard]] T const* data() const;
+
+    // begin, end
+    // Iterate the elements in the Eytzinger order.
+    //
+    [[nodiscard]] const_iterator begin() const;
+    [[nodiscard]] const_iterator end() const;
+
+    [[nodiscard]] allocator_type& get_allocator();
+    [[nodiscard]] allocator_type const& get_allocator() const;
+
+    // lower_bound
+    // Finds the smallest element that is not ordered before value.
+    //
+    // Returns:
+    // Pointer to the element or nullptr if all elements are ordered before
+    // value.
+    //
+    // Complexity: O(log n) comparisons.
+    //
+    template<typename Key>
+    [[nodiscard]] T const* lower_bound(Key const& value) const;
+
+    // find
+    //
+    // Returns:
+    // Pointer to an element equivalent to value or nullptr if there is none.
+    //
+    // Complexity: O(log n) comparisons.
+    //
+    template<typename Key>
+    [[nodiscard]] T const* find(Key const& value) const;
+
+    // contains
+    //
+    // Returns:
+    // true if an element equivalent to value is contained in the array.
+    //
+    template<typename Key>
+    [[nodiscard]] bool contains(Key const& value) const;
+
+    friend void swap(Eytzinger_Array& lhs, Eytzinger_Array& rhs)
+    {
+      using anton::swap;
+      swap(lhs._data, rhs._data);
+      swap(lhs._compare, rhs._compare);
+    }
+
+  private:
+    Array<T> _data;
+    Compare _compare;
+
+    template<typename Forward_Iterator>
+    void build(Forward_Iterator first, Forward_Iterator last);
+  };
+} // namespace anton
+
+namespace anton {
+  namespace detail {
+    // The descendants of the node at position k that are log2(stride) levels
+    // below it occupy the positions [k * stride, k * stride + stride[, which
+    // fit in a cache line. The search prefetches them while it descends the
+    // levels in between.
+    template<typename T>
+    constexpr i64 eytzinger_prefetch_stride =
+      sizeof(T) >= 64 ? 1 : (sizeof(T) >= 32 ? 2 : (sizeof(T) >= 16 ? 4 : 16));
+  } // namespace detail
+
+  template<typename T, typename Compare>
+  Eytzinger_Array<T, Compare>::Eytzinger_Array(): _data(), _compare()
+  {
+  }
+
+  template<typename T, typename Compare>
+  Eytzinger_Array<T, Compare>::Eytzinger_Array(allocator_type const& allocator)
+    : _data(allocator), _compare()
+  {
+  }
+
+  template<typename T, typename Compare>
+  template<typename Forward_Iterator>
+  Eytzinger_Array<T, Compare>::Eytzinger_Array(Range_Construct_Tag,
+                                               Forward_Iterator first,
+                                               Forward_Iterator last,
+                                               Compare const& compare)
+    : _data(), _compare(compare)
+  {
+    build(first, last);
+  }
+
+  template<typename T, typename Compare>
+  template<typename Forward_Iterator>
+  Eytzinger_Array<T, Compare>::Eytzinger_Array(allocator_type const& allocator,
+                                               Range_Construct_Tag,
+                                               Forward_Iterator first,
+                                               Forward_Iterator last,
+                                               Compare const& compare)
+    : _data(allocator), _compare(compare)
+  {
+    build(first, last);
+  }
+
+  template<typename T, typename Compare>
+  template<typename Forward_Iterator>
+  void Eytzinger_Array<T, Compare>::build(Forward_Iterator first,
+                                          Forward_Iterator const last)
+  {
+    size_type length = 0;
+    for(Forward_Iterator i = first; i != last; ++i) {
+      length += 1;
+    }
+
+    if(length == 0) {
+      return;
+    }
+
+    _data.ensure_capacity(length);
+    _data.force_size(length);
+    T* const data = _data.data();
+    // Visit the nodes of the tree in order and assign the sorted elements to
+    // them. k is the 1-based position of the current node.
+    size_type k = 1;
+    while(2 * k <= length) {
+      k = 2 * k;
+    }
+
+    while(k != 0) {
+      construct(data + (k - 1), *first);
+      ++first;
+      if(2 * k + 1 <= length) {
+        // The successor is the leftmost node of the right subtree.
+        k = 2 * k + 1;
+        while(2 * k <= length) {
+          k = 2 * k;
+        }
+      } else {
+        // The successor is the first ancestor whose left subtree contains the
+        // node, i.e. strip the trailing right turns and one left turn.
+        while(k & 1) {
+          k >>= 1;
+        }
+        k >>= 1;
+      }
+    }
+  }
+
+  template<typename T, typename Compare>
+  auto Eytzinger_Array<T, Compare>::size() const -> size_type
+  {
+    return _data.size();
+  }
+
+  template<typename T, typename Compare>
+  auto Eytzinger_Array<T, Compare>::data() const -> T const*
+  {
+    return _data.data();
+  }
+
+  template<typename T, typename Compare>
+  auto Eytzinger_Array<T, Compare>::begin() const -> const_iterator
+  {
+    return _data.data();
+  }
+
+  template<typename T, typename Compare>
+  auto Eytzinger_Array<T, Compare>::end() const -> const_iterator
+  {
+    return _data.data() + _data.size();
+  }
+
+  template<typename T, typename Compare>
+  auto Eytzinger_Array<T, Compare>::get_allocator() -> allocator_type&
+  {
+    return _data.get_allocator();
+  }
+
+  template<typename T, typename Compare>
+  auto Eytzinger_Array<T, Compare>::get_allocator() const
+    -> allocator_type const&
+  {
+    return _data.get_allocator();
+  }
+
+  template<typename T, typename Compare>
+  template<typename Key>
+  auto Eytzinger_Array<T, Compare>::lower_bound(Key const& value) const
+    -> T const*
+  {
+    constexpr size_type stride = detail::eytzinger_prefetch_stride<T>;
+    T const* const data = _data.data();
+    size_type const length = _data.size();
+    // Descend to a leaf. Every step appends the outcome of the comparison to
+    // k as a bit, 1 meaning that we went right.
+    size_type k = 1;
+    while(k <= length) {
+      size_type const prefetch = k * stride;
+      if(prefetch <= length) {
+        ANTON_PREFETCH(data + (prefetch - 1));
+      }
+      k = 2 * k + (_compare(data[k - 1], value) ? 1 : 0);
+    }
+
+    // The result is the node where we last went left. Strip the trailing
+    // right turns and the left turn. k becomes 0 if we never went left.
+    while(k & 1) {
+      k >>= 1;
+    }
+    k >>= 1;
+    if(k == 0) {
+      return nullptr;
+    }
+    return data + (k - 1);
+  }
+
+  template<typename T, typename Compare>
+  template<typename Key>
+  auto Eytzinger_Array<T, Compare>::find(Key const& value) const -> T const*
+  {
+    T const* const element = lower_bound(value);
+    if(element != nullptr && !_compare(value, *element)) {
+      return element;
+    }
+    return nullptr;
+  }
+
+  template<typename T, typename Compare>
+  template<typename Key>
+  bool Eytzinger_Array<T, Compare>::contains(Key const& value) const
+  {
+    return find(value) != nullptr;
+  }
+} // namespace anton
@@ -8,14 +8,21 @@
 #include <anton/type_traits/utility.hpp>
 
 namespace anton {
+  struct String_Builder;
+
   struct Format_Buffer {
   public:
     Format_Buffer(Memory_Allocator* const allocator);
+    // Format_Buffer
+    // Appends the written text to builder instead of storing it.
+    //
+    explicit Format_Buffer(String_Builder& builder);
     void write(String_View string);
     String to_string();
 
   private:
     String _string;
+    String_Builder* _builder = nullptr;
   };
 
   namespace detail {
@@ -93,6 +100,10 @@ namespace anton {
                            String_View format_string,
                            Slice<Formatter_Base const* const> args);
 
+    void format_internal(Memory_Allocator* const allocator,
+                         Format_Buffer& buffer, String_View format_string,
+                         Slice<Formatter_Base const* const> args);
+
     template<typename... Args>
     String format(Memory_Allocator* const allocator,
                   String_View const format_string, Args&&... args)
@@ -104,6 +115,18 @@ namespace anton {
         return format_internal(allocator, format_string, {});
       }
     }
+
+    template<typename... Args>
+    void format_to(Memory_Allocator* const allocator, Format_Buffer& buffer,
+                   String_View const format_string, Args&&... args)
+    {
+      if constexpr(sizeof...(Args) > 0) {
+        Formatter_Base const* const arguments[sizeof...(Args)] = {&args...};
+        format_internal(allocator, buffer, format_string, arguments);
+      } else {
+        format_internal(allocator, buffer, format_string, {});
+      }
+    }
   } // namespace detail
 
   template<typename... Args>
@@ -120,4 +143,15 @@ namespace anton {
     return detail::format(get_default_allocator(), format_string,
                           Formatter<decay<Args>>(ANTON_FWD(args))...);
   }
+
+  // format_to
+  // Formats the arguments as format would and writes the result to buffer.
+  //
+  template<typename... Args>
+  void format_to(Memory_Allocator* const allocator, Format_Buffer& buffer,
+                 String_View const format_string, Args&&... args)
+  {
+    detail::format_to(allocator, buffer, format_string,
+                      Formatter<decay<Args>>(ANTON_FWD(args))...);
+  }
 } // namespace anton
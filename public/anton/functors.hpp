@@ -46,6 +46,16 @@ namespace anton {
     }
   };
 
+  // Less_Compare
+  //
+  template<typename T>
+  struct Less_Compare {
+    [[nodiscard]] constexpr bool operator()(T const& lhs, T const& rhs) const
+    {
+      return lhs < rhs;
+    }
+  };
+
   // Default_Deleter
   //
   template<typename T>
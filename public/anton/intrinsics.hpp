@@ -26,6 +26,8 @@ namespace anton {
   #define ANTON_LIKELY(x) __builtin_expect(!!(x), 1)
   #define ANTON_FORCEINLINE __attribute__((always_inline))
   #define ANTON_NOINLINE __attribute__((noinline))
+  #define ANTON_PREFETCH(address) __builtin_prefetch(address)
+  #define ANTON_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
 #elif ANTON_COMPILER_GPP
   #if ANTON_UNREACHABLE_ASSERTS
     #define ANTON_UNREACHABLE(msg)                    \
@@ -38,6 +40,8 @@ namespace anton {
   #define ANTON_LIKELY(x) __builtin_expect(!!(x), 1)
   #define ANTON_FORCEINLINE __attribute__((always_inline))
   #define ANTON_NOINLINE __attribute__((noinline))
+  #define ANTON_PREFETCH(address) __builtin_prefetch(address)
+  #define ANTON_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
 #elif ANTON_COMPILER_MSVC
   #if ANTON_UNREACHABLE_ASSERTS
     #define ANTON_UNREACHABLE(msg)                    \
@@ -50,6 +54,9 @@ namespace anton {
   #define ANTON_LIKELY(x) x
   #define ANTON_FORCEINLINE __forceinline
   #define ANTON_NOINLINE __declspec(noinline)
+  // _mm_prefetch would require the intrinsic headers.
+  #define ANTON_PREFETCH(address) ((void)(address))
+  #define ANTON_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
 #else
   #if ANTON_UNREACHABLE_ASSERTS
     #define ANTON_UNREACHABLE(msg) \
@@ -61,4 +68,8 @@ namespace anton {
   #define ANTON_LIKELY(x) x
   #define ANTON_FORCEINLINE
   #define ANTON_NOINLINE
+  #define ANTON_PREFETCH(address) ((void)(address))
+  // Without the builtin the runtime-only checks in constexpr functions are
+  // skipped.
+  #define ANTON_IS_CONSTANT_EVALUATED() true
 #endif
@@ -5,9 +5,62 @@
 #include <anton/memory/core.hpp>
 #include <anton/type_traits.hpp>
 
-// TODO: add constexpr if for trivial operations.
-
 namespace anton {
+  namespace detail {
+    // is_bitwise_copyable
+    // Whether the elements of a range denoted by Source may be copied to
+    // a range denoted by Dest as raw bytes. Both iterators must be pointers to
+    // the same trivially copyable type. Trait is the triviality of the
+    // operation the copy replaces, e.g. the copy assignment.
+    //
+    template<typename Source, typename Dest, bool Trait>
+    constexpr bool is_bitwise_copyable =
+      is_pointer<Source> && is_pointer<Dest> &&
+      is_same<remove_const<remove_pointer<Source>>, remove_pointer<Dest>> &&
+      is_trivially_copyable<remove_pointer<Dest>> && Trait;
+
+    // is_bitwise_fillable
+    // Whether the range denoted by Iterator may be filled with a value of type
+    // T by copying its bytes.
+    //
+    template<typename Iterator, typename T>
+    constexpr bool is_bitwise_fillable =
+      is_pointer<Iterator> && is_same<remove_pointer<Iterator>, T> &&
+      is_trivially_copyable<T> && is_trivially_copy_constructible<T>;
+
+    // bitwise_fill
+    // Fills [first, first + n[ with value. Bytes and values whose bytes are
+    // all zero are filled with memset.
+    //
+    template<typename T>
+    void bitwise_fill(T* first, i64 const n, T const& value)
+    {
+      if(n <= 0) {
+        return;
+      }
+
+      unsigned char bytes[sizeof(T)];
+      memcpy(bytes, ANTON_ADDRESSOF(value), sizeof(T));
+      if constexpr(sizeof(T) == 1) {
+        memset(first, bytes[0], (usize)n);
+        return;
+      } else {
+        bool zero = true;
+        for(unsigned char const byte: bytes) {
+          zero &= byte == 0;
+        }
+
+        if(zero) {
+          memset(first, 0, (usize)n * sizeof(T));
+        } else {
+          for(T* const last = first + n; first != last; ++first) {
+            anton::construct(first, value);
+          }
+        }
+      }
+    }
+  } // namespace detail
+
   template<typename Forward_Iterator>
   void destruct([[maybe_unused]] Forward_Iterator first,
                 [[maybe_unused]] Forward_Iterator last)
@@ -32,44 +85,106 @@ namespace anton {
     }
   }
 
+  // uninitialized_copy, uninitialized_copy_n
+  // Copy constructs the elements of [first, last[ or [first, first + n[ in
+  // the uninitialized storage starting at dest. Trivially copyable elements
+  // are copied with memcpy when both iterators are pointers. The ranges must
+  // not overlap.
+  //
+  // Returns:
+  // An iterator to the end of the dest range.
+  //
   template<typename Input_Iterator, typename Forward_Iterator>
   Forward_Iterator uninitialized_copy(Input_Iterator first, Input_Iterator last,
                                       Forward_Iterator dest)
   {
-    for(; first != last; ++first, ++dest) {
-      anton::construct(ANTON_ADDRESSOF(*dest), *first);
+    using value_type = typename Iterator_Traits<Input_Iterator>::value_type;
+    if constexpr(detail::is_bitwise_copyable<
+                   Input_Iterator, Forward_Iterator,
+                   is_trivially_copy_constructible<value_type>>) {
+      i64 const n = last - first;
+      if(n > 0) {
+        memcpy(dest, first, (usize)n * sizeof(value_type));
+      }
+      return dest + n;
+    } else {
+      for(; first != last; ++first, ++dest) {
+        anton::construct(ANTON_ADDRESSOF(*dest), *first);
+      }
+      return dest;
     }
-    return dest;
   }
 
   template<typename Input_Iterator, typename Count, typename Forward_Iterator>
   Forward_Iterator uninitialized_copy_n(Input_Iterator first, Count n,
                                         Forward_Iterator dest)
   {
-    for(; n > 0; --n, ++first, ++dest) {
-      anton::construct(ANTON_ADDRESSOF(*dest), *first);
+    using value_type = typename Iterator_Traits<Input_Iterator>::value_type;
+    if constexpr(detail::is_bitwise_copyable<
+                   Input_Iterator, Forward_Iterator,
+                   is_trivially_copy_constructible<value_type>>) {
+      if(n <= 0) {
+        return dest;
+      }
+      memcpy(dest, first, (usize)n * sizeof(value_type));
+      return dest + n;
+    } else {
+      for(; n > 0; --n, ++first, ++dest) {
+        anton::construct(ANTON_ADDRESSOF(*dest), *first);
+      }
+      return dest;
     }
-    return dest;
   }
 
+  // uninitialized_move, uninitialized_move_n
+  // Move constructs the elements of [first, last[ or [first, first + n[ in
+  // the uninitialized storage starting at dest. Trivially copyable elements
+  // are copied with memcpy when both iterators are pointers. The ranges must
+  // not overlap.
+  //
+  // Returns:
+  // An iterator to the end of the dest range.
+  //
   template<typename Input_Iterator, typename Forward_Iterator>
   Forward_Iterator uninitialized_move(Input_Iterator first, Input_Iterator last,
                                       Forward_Iterator dest)
   {
-    for(; first != last; ++first, ++dest) {
-      anton::construct(ANTON_ADDRESSOF(*dest), ANTON_MOV(*first));
+    using value_type = typename Iterator_Traits<Input_Iterator>::value_type;
+    if constexpr(detail::is_bitwise_copyable<
+                   Input_Iterator, Forward_Iterator,
+                   is_trivially_move_constructible<value_type>>) {
+      i64 const n = last - first;
+      if(n > 0) {
+        memcpy(dest, first, (usize)n * sizeof(value_type));
+      }
+      return dest + n;
+    } else {
+      for(; first != last; ++first, ++dest) {
+        anton::construct(ANTON_ADDRESSOF(*dest), ANTON_MOV(*first));
+      }
+      return dest;
     }
-    return dest;
   }
 
   template<typename Input_Iterator, typename Count, typename Forward_Iterator>
   Forward_Iterator uninitialized_move_n(Input_Iterator first, Count n,
                                         Forward_Iterator dest)
   {
-    for(; n > 0; --n, ++first, ++dest) {
-      anton::construct(ANTON_ADDRESSOF(*dest), ANTON_MOV(*first));
+    using value_type = typename Iterator_Traits<Input_Iterator>::value_type;
+    if constexpr(detail::is_bitwise_copyable<
+                   Input_Iterator, Forward_Iterator,
+                   is_trivially_move_constructible<value_type>>) {
+      if(n <= 0) {
+        return dest;
+      }
+      memcpy(dest, first, (usize)n * sizeof(value_type));
+      return dest + n;
+    } else {
+      for(; n > 0; --n, ++first, ++dest) {
+        anton::construct(ANTON_ADDRESSOF(*dest), ANTON_MOV(*first));
+      }
+      return dest;
     }
-    return dest;
   }
 
   template<typename Forward_Iterator>
@@ -103,20 +218,33 @@ namespace anton {
     }
   }
 
+  // uninitialized_fill, uninitialized_fill_n
+  // Copy constructs val in the uninitialized storage [first, last[ or
+  // [first, first + n[. Ranges of bytes and ranges of trivially copyable
+  // elements whose value has all bytes zero are filled with memset.
+  //
   template<typename Forward_Iterator, typename T>
   void uninitialized_fill(Forward_Iterator first, Forward_Iterator last,
                           T const& val)
   {
-    for(; first != last; ++first) {
-      anton::construct(ANTON_ADDRESSOF(*first), val);
+    if constexpr(detail::is_bitwise_fillable<Forward_Iterator, T>) {
+      detail::bitwise_fill(first, last - first, val);
+    } else {
+      for(; first != last; ++first) {
+        anton::construct(ANTON_ADDRESSOF(*first), val);
+      }
     }
   }
 
   template<typename Forward_Iterator, typename Count, typename T>
   void uninitialized_fill_n(Forward_Iterator first, Count n, T const& val)
   {
-    for(; n > 0; --n, ++first) {
-      anton::construct(ANTON_ADDRESSOF(*first), val);
+    if constexpr(detail::is_bitwise_fillable<Forward_Iterator, T>) {
+      detail::bitwise_fill(first, static_cast<i64>(n), val);
+    } else {
+      for(; n > 0; --n, ++first) {
+        anton::construct(ANTON_ADDRESSOF(*first), val);
+      }
     }
   }
 
@@ -139,24 +267,16 @@ namespace anton {
                               Output_Iterator dest)
   {
     // TODO: Iterator unwrapping
-    using input_iterator_cat =
-      typename Iterator_Traits<Input_Iterator>::iterator_category;
-    using output_iterator_cat =
-      typename Iterator_Traits<Output_Iterator>::iterator_category;
-    using input_value_type =
-      typename Iterator_Traits<Input_Iterator>::value_type;
-    using output_value_type =
-      typename Iterator_Traits<Output_Iterator>::value_type;
-
-    constexpr bool both_iterators_are_contiguous = conjunction<
-      Is_Iterator_Category<input_iterator_cat, Contiguous_Iterator_Tag>,
-      Is_Iterator_Category<output_iterator_cat, Contiguous_Iterator_Tag>>;
-    if constexpr(both_iterators_are_contiguous &&
-                 is_trivial<input_value_type> &&
-                 is_same<input_value_type, output_value_type>) {
-      // TODO: Assumes that contiguous iterators are pointers.
-      memmove(dest, first, (usize)(last - first) * sizeof(input_value_type));
-      return dest + (last - first);
+    using value_type = typename Iterator_Traits<Input_Iterator>::value_type;
+    if constexpr(detail::is_bitwise_copyable<
+                   Input_Iterator, Output_Iterator,
+                   is_trivially_copy_assignable<value_type>>) {
+      // The ranges may overlap.
+      i64 const n = last - first;
+      if(n > 0) {
+        memmove(dest, first, (usize)n * sizeof(value_type));
+      }
+      return dest + n;
     } else {
       for(; first != last; ++first, ++dest) {
         *dest = *first;
@@ -196,25 +316,16 @@ namespace anton {
                 Dest_Bidirectional_Iterator dest)
   {
     // TODO: Iterator unwrapping
-    using input_iterator_cat =
-      typename Iterator_Traits<Bidirectional_Iterator>::iterator_category;
-    using output_iterator_cat =
-      typename Iterator_Traits<Dest_Bidirectional_Iterator>::iterator_category;
-    using input_value_type =
+    using value_type =
       typename Iterator_Traits<Bidirectional_Iterator>::value_type;
-    using output_value_type =
-      typename Iterator_Traits<Dest_Bidirectional_Iterator>::value_type;
-
-    constexpr bool both_iterators_are_contiguous = conjunction<
-      Is_Iterator_Category<input_iterator_cat, Contiguous_Iterator_Tag>,
-      Is_Iterator_Category<output_iterator_cat, Contiguous_Iterator_Tag>>;
-    if constexpr(both_iterators_are_contiguous &&
-                 is_trivial<input_value_type> &&
-                 is_same<input_value_type, output_value_type>) {
-      // TODO: Assumes that contiguous iterators are pointers.
-      Dest_Bidirectional_Iterator const dest_begin = dest - (last - first);
-      memmove(dest_begin, first,
-              (usize)(last - first) * sizeof(input_value_type));
+    if constexpr(detail::is_bitwise_copyable<
+                   Bidirectional_Iterator, Dest_Bidirectional_Iterator,
+                   is_trivially_copy_assignable<value_type>>) {
+      i64 const n = last - first;
+      Dest_Bidirectional_Iterator const dest_begin = dest - n;
+      if(n > 0) {
+        memmove(dest_begin, first, (usize)n * sizeof(value_type));
+      }
       return dest_begin;
     } else {
       while(last != first) {
@@ -237,24 +348,16 @@ namespace anton {
                               Output_Iterator dest)
   {
     // TODO: Iterator unwrapping
-    using input_iterator_cat =
-      typename Iterator_Traits<Input_Iterator>::iterator_category;
-    using output_iterator_cat =
-      typename Iterator_Traits<Output_Iterator>::iterator_category;
-    using input_value_type =
-      typename Iterator_Traits<Input_Iterator>::value_type;
-    using output_value_type =
-      typename Iterator_Traits<Output_Iterator>::value_type;
-
-    constexpr bool both_iterators_are_contiguous =
-      conjunction<Is_Same<input_iterator_cat, Contiguous_Iterator_Tag>,
-                  Is_Same<output_iterator_cat, Contiguous_Iterator_Tag>>;
-    if constexpr(both_iterators_are_contiguous &&
-                 is_trivial<input_value_type> &&
-                 is_same<input_value_type, output_value_type>) {
-      // TODO: Assumes that contiguous iterators are pointers.
-      memmove(dest, first, (usize)(last - first) * sizeof(input_value_type));
-      return dest + (last - first);
+    using value_type = typename Iterator_Traits<Input_Iterator>::value_type;
+    if constexpr(detail::is_bitwise_copyable<
+                   Input_Iterator, Output_Iterator,
+                   is_trivially_move_assignable<value_type>>) {
+      // The ranges may overlap.
+      i64 const n = last - first;
+      if(n > 0) {
+        memmove(dest, first, (usize)n * sizeof(value_type));
+      }
+      return dest + n;
     } else {
       for(; first != last; ++first, ++dest) {
         *dest = ANTON_MOV(*first);
@@ -294,25 +397,16 @@ namespace anton {
                 Dest_Bidirectional_Iterator dest)
   {
     // TODO: Iterator unwrapping
-    using input_iterator_cat =
-      typename Iterator_Traits<Bidirectional_Iterator>::iterator_category;
-    using output_iterator_cat =
-      typename Iterator_Traits<Dest_Bidirectional_Iterator>::iterator_category;
-    using input_value_type =
+    using value_type =
       typename Iterator_Traits<Bidirectional_Iterator>::value_type;
-    using output_value_type =
-      typename Iterator_Traits<Dest_Bidirectional_Iterator>::value_type;
-
-    constexpr bool both_iterators_are_contiguous = conjunction<
-      Is_Iterator_Category<input_iterator_cat, Contiguous_Iterator_Tag>,
-      Is_Iterator_Category<output_iterator_cat, Contiguous_Iterator_Tag>>;
-    if constexpr(both_iterators_are_contiguous &&
-                 is_trivial<input_value_type> &&
-                 is_same<input_value_type, output_value_type>) {
-      // TODO: Assumes that contiguous iterators are pointers.
-      Dest_Bidirectional_Iterator const dest_begin = dest - (last - first);
-      memmove(dest_begin, first,
-              (usize)(last - first) * sizeof(input_value_type));
+    if constexpr(detail::is_bitwise_copyable<
+                   Bidirectional_Iterator, Dest_Bidirectional_Iterator,
+                   is_trivially_move_assignable<value_type>>) {
+      i64 const n = last - first;
+      Dest_Bidirectional_Iterator const dest_begin = dest - n;
+      if(n > 0) {
+        memmove(dest_begin, first, (usize)n * sizeof(value_type));
+      }
       return dest_begin;
     } else {
       while(last != first) {
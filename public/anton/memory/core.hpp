@@ -93,7 +93,7 @@ namespace anton {
   // Fill the memory range [first, last[ with value.
   //
   // Parameters:
-  // first - The beginning of the memory range to fill. May be nullptr;
+  // first - The beginning of the memory range to fill. May be nullptr.
   //  last - The end of the memory range to fill. If first is nullptr, must also
   //         be nullptr.
   // value - The value to fill the memory range with.
@@ -104,12 +104,24 @@ namespace anton {
   // Fill the memory range [first, last[ with zeros.
   //
   // Parameters:
-  // first - The beginning of the memory range to fill. May be nullptr;
+  // first - The beginning of the memory range to fill. May be nullptr.
   //  last - The end of the memory range to fill. If first is nullptr, must also
   //         be nullptr.
   //
   void zero_memory(void* first, void* last);
 
+  // copy_memory
+  // Copy the memory range [first, last[ to destination. The ranges must not
+  // overlap.
+  //
+  // Parameters:
+  //       first - The beginning of the memory range to copy. May be nullptr.
+  //        last - The end of the memory range to copy. If first is nullptr,
+  //               must also be nullptr.
+  // destination - The beginning of the memory range to copy to.
+  //
+  void copy_memory(void const* first, void const* last, void* destination);
+
   // construct
   // Construct an object of type T at pointer with args forwarded to the
   // constructor.
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <anton/allocator.hpp>
+#include <anton/array.hpp>
+#include <anton/optional.hpp>
+#include <anton/slice.hpp>
+#include <anton/string_view.hpp>
+#include <anton/types.hpp>
+
+namespace anton {
+  // Pattern_Match
+  // An occurrence of a pattern of a Multi_Pattern_Matcher.
+  //
+  struct Pattern_Match {
+    // The index of the pattern in the set the matcher has been built from.
+    i64 pattern;
+    // The position of the first byte of the occurrence.
+    i64 position;
+  };
+
+  // Multi_Pattern_Matcher
+  // Finds the occurrences of a set of patterns in a single pass over a string
+  // regardless of the number of patterns. The patterns are compiled into an
+  // Aho-Corasick automaton whose transitions are indexed by classes of bytes
+  // the patterns do not distinguish, which keeps the table small. Sets of up
+  // to 32 patterns are searched with the Teddy algorithm on processors
+  // supporting AVX2 instead. Teddy tests 32 positions at once against the
+  // first bytes of the patterns and verifies only the positions at which
+  // some pattern may begin.
+  //
+  // The patterns are copied into the matcher.
+  //
+  struct Multi_Pattern_Matcher {
+  public:
+    using allocator_type = Polymorphic_Allocator;
+
+    Multi_Pattern_Matcher();
+    explicit Multi_Pattern_Matcher(allocator_type const& allocator);
+    // Multi_Pattern_Matcher
+    // Compiles a set of patterns.
+    //
+    // Parameters:
+    // patterns - the patterns to look for. Must not be empty strings. The
+    //            same pattern may occur more than once.
+    //
+    // Complexity: O(n * k) where n is the total size of the patterns and k is
+    // the number of distinct bytes in them.
+    //
+    explicit Multi_Pattern_Matcher(Slice<String_View const> patterns);
+    Multi_Pattern_Matcher(allocator_type const& allocator,
+                          Slice<String_View const> patterns);
+
+    // get_pattern_count
+    //
+    [[nodiscard]] i64 get_pattern_count() const;
+
+    // get_pattern
+    //
+    // Returns:
+    // The pattern at position index in [0, get_pattern_count()[.
+    //
+    [[nodiscard]] String_View get_pattern(i64 index) const;
+
+    // find_first
+    // Finds the occurrence that begins first. Of the patterns that occur at
+    // the same position the one with the smallest index is reported.
+    //
+    // Returns:
+    // The occurrence or null_optional if none of the patterns occurs in
+    // string.
+    //
+    // Complexity: O(n) in the size of string.
+    //
+    [[nodiscard]] Optional<Pattern_Match> find_first(String_View string) const;
+
+    // find_all
+    // Finds all occurrences of all patterns including the overlapping ones.
+    //
+    // Returns:
+    // The occurrences ordered by position and then by pattern index.
+    //
+    // Complexity: O(n + m log m) where n is the size of string and m is the
+    // number of occurrences.
+    //
+    [[nodiscard]] Array<Pattern_Match> find_all(String_View string) const;
+
+    [[nodiscard]] allocator_type& get_allocator();
+    [[nodiscard]] allocator_type const& get_allocator() const;
+
+  private:
+    // The bytes of the patterns stored consecutively. Pattern i occupies
+    // [_offsets[i], _offsets[i + 1][.
+    Array<char8> _bytes;
+    Array<i64> _offsets;
+    i64 _max_pattern_size = 0;
+    bool _teddy = false;
+
+    // Teddy
+
+    i64 _fingerprint_size = 0;
+    // The buckets of the patterns by the low and the high nibble of each of
+    // the fingerprint bytes. Pattern i belongs to bucket i % 8.
+    u8 _teddy_masks[3 * 32] = {};
+
+    // Aho-Corasick
+
+    // Maps bytes to their classes.
+    u8 _classes[256] = {};
+    i64 _class_count = 0;
+    // The transitions of the complete automaton. The entry at
+    // state * _class_count + class is the next state multiplied by
+    // _class_count with the most significant bit set when an occurrence ends
+    // in that state.
+    Array<u32> _transitions;
+    // The pattern with the smallest index that ends in each state or -1.
+    Array<i32> _state_pattern;
+    // The closest state representing a proper suffix of each state in which a
+    // pattern ends or 0.
+    Array<i32> _output_link;
+    // The next pattern with the same bytes as each pattern or -1.
+    Array<i32> _next_equal;
+
+    void build(Slice<String_View const> patterns);
+    void build_teddy();
+    void build_automaton();
+    template<typename Callback>
+    void search_teddy(String_View string, Callback& callback) const;
+    template<typename Callback>
+    void search_automaton(String_View string, Callback& callback) const;
+  };
+} // namespace anton
@@ -0,0 +1,533 @@
+#pragma once
+
+#include <anton/array.hpp>
+#include <anton/iterators.hpp>
+#include <anton/math/math.hpp>
+#include <anton/memory.hpp>
+#include <anton/sort.hpp>
+#include <anton/thread_pool.hpp>
+
+namespace anton {
+  namespace detail {
+    // The minimal number of elements sorted or merged by a single task.
+    // Smaller ranges are not worth the overhead of scheduling.
+    constexpr i64 parallel_sort_grain = 8192;
+
+    // merge_path_search
+    // Finds the split of the merge of left and right at the diagonal, i.e. the
+    // number of elements of left among the first diagonal elements of the
+    // merged sequence. Ties are resolved in favour of left which keeps the merge
+    // stable.
+    //
+    template<typename Iterator, typename Predicate>
+    i64 merge_path_search(Iterator const left, i64 const left_length,
+                          Iterator const right, i64 const right_length,
+                          i64 const diagonal, Predicate& predicate)
+    {
+      i64 low = math::max(diagonal - right_length, (i64)0);
+      i64 high = math::min(diagonal, left_length);
+      while(low < high) {
+        i64 const middle = low + (high - low) / 2;
+        if(!predicate(*(right + (diagonal - middle - 1)), *(left + middle))) {
+          low = middle + 1;
+        } else {
+          high = middle;
+        }
+      }
+      return low;
+    }
+
+    // merge_path_segment
+    // Merges the elements [diagonal_begin, diagonal_end) of the merged sequence
+    // of left and right into out.
+    //
+    template<typename Source, typename Destination, typename Predicate>
+    void merge_path_segment(Source const left, i64 const left_length,
+                            Source const right, i64 const right_length,
+                            Destination const out, i64 const diagonal_begin,
+                            i64 const diagonal_end, Predicate& predicate)
+    {
+      i64 const left_begin = merge_path_search(
+        left, left_length, right, right_length, diagonal_begin, predicate);
+      i64 const left_end = merge_path_search(left, left_length, right,
+                                             right_length, diagonal_end, predicate);
+      Source l = left + left_begin;
+      Source const end_l = left + left_end;
+      Source r = right + (diagonal_begin - left_begin);
+      Source const end_r = right + (diagonal_end - left_end);
+      Destination o = out + diagonal_begin;
+      for(; l != end_l && r != end_r; ++o) {
+        if(!predicate(*r, *l)) {
+          *o = ANTON_MOV(*l);
+          ++l;
+        } else {
+          *o = ANTON_MOV(*r);
+          ++r;
+        }
+      }
+
+      o = anton::move(l, end_l, o);
+      anton::move(r, end_r, o);
+    }
+
+    // parallel_merge_round
+    // Merges pairs of adjacent sorted runs from source into destination. The
+    // runs are delimited by bounds. The merges are split into segments along
+    // the merge path so that a single large merge is executed by all workers.
+    //
+    template<typename Source, typename Destination, typename Predicate>
+    void parallel_merge_round(Thread_Pool& pool, Source const source,
+                              Destination const destination,
+                              Array<i64> const& bounds, i64 const segment,
+                              Predicate& predicate)
+    {
+      Task_Group group;
+      i64 const run_count = bounds.size() - 1;
+      for(i64 run = 0; run < run_count; run += 2) {
+        i64 const begin = bounds[run];
+        if(run + 1 == run_count) {
+          // The leftover run has no pair. Move it unchanged.
+          i64 const end = bounds[run + 1];
+          pool.spawn(group, [source, destination, begin, end]() {
+            anton::move(source + begin, source + end, destination + begin);
+          });
+          continue;
+        }
+
+        i64 const middle = bounds[run + 1];
+        i64 const end = bounds[run + 2];
+        for(i64 d = 0; d < end - begin; d += segment) {
+          i64 const d_end = math::min(d + segment, end - begin);
+          pool.spawn(group, [source, destination, begin, middle, end, d, d_end,
+                             &predicate]() {
+            merge_path_segment(source + begin, middle - begin, source + middle,
+                               end - middle, destination + begin, d, d_end,
+                               predicate);
+          });
+        }
+      }
+      pool.wait(group);
+    }
+
+    // partition_by
+    // Moves the elements for which is_left returns true before the others.
+    // Unlike partition_pivot it needs neither a pivot inside the range nor a
+    // guard element, hence it partitions arbitrary chunks of a range. Cheap
+    // comparisons are partitioned with partition_blocks.
+    //
+    // Returns:
+    // The number of elements for which is_left returned true.
+    //
+    template<typename Random_Access_Iterator, typename Unary_Predicate>
+    i64 partition_by(Random_Access_Iterator const begin,
+                     Random_Access_Iterator const end,
+                     Unary_Predicate& is_left)
+    {
+      using value_type =
+        typename Iterator_Traits<Random_Access_Iterator>::value_type;
+      if constexpr(use_branchless_partition<value_type>) {
+        return partition_blocks(begin, end, is_left) - begin;
+      } else {
+        Random_Access_Iterator first = begin;
+        Random_Access_Iterator last = end;
+        while(true) {
+          while(first != last && is_left(*first)) {
+            ++first;
+          }
+
+          while(first != last && !is_left(*(last - 1))) {
+            --last;
+          }
+
+          if(first == last) {
+            return first - begin;
+          }
+
+          --last;
+          swap(*first, *last);
+          ++first;
+        }
+      }
+    }
+
+    // parallel_partition
+    // Partitions the range so that the elements for which is_left returns
+    // true precede the others. The range is divided into chunk_count chunks
+    // which are partitioned concurrently. Afterwards, the elements of the
+    // right kind before the final boundary and the elements of the left kind
+    // past it come in equal numbers and are swapped pairwise, also in
+    // parallel.
+    //
+    // Returns:
+    // The number of elements for which is_left returned true.
+    //
+    template<typename Random_Access_Iterator, typename Unary_Predicate>
+    i64 parallel_partition(Thread_Pool& pool,
+                           Random_Access_Iterator const first,
+                           Random_Access_Iterator const last,
+                           i64 const chunk_count, Unary_Predicate& is_left)
+    {
+      i64 const size = last - first;
+      Array<i64> bounds{reserve, chunk_count + 1};
+      for(i64 i = 0; i <= chunk_count; ++i) {
+        bounds.push_back(size * i / chunk_count);
+      }
+
+      Array<i64> counts{reserve, chunk_count};
+      counts.force_size(chunk_count);
+      parallel_for(pool, irange(0, chunk_count), 1,
+                   [first, &bounds, &counts, &is_left](i64 const i) {
+                     counts[i] = partition_by(first + bounds[i],
+                                              first + bounds[i + 1], is_left);
+                   });
+
+      i64 boundary = 0;
+      for(i64 const count: counts) {
+        boundary += count;
+      }
+
+      // The misplaced elements of both kinds as [begin, end) pairs of
+      // offsets in increasing order.
+      Array<i64> misplaced_l{reserve, 2 * chunk_count};
+      Array<i64> misplaced_r{reserve, 2 * chunk_count};
+      i64 misplaced = 0;
+      for(i64 i = 0; i < chunk_count; ++i) {
+        i64 const split = bounds[i] + counts[i];
+        i64 const end_l = math::min(bounds[i + 1], boundary);
+        if(split < end_l) {
+          misplaced_l.push_back(split);
+          misplaced_l.push_back(end_l);
+          misplaced += end_l - split;
+        }
+
+        i64 const begin_r = math::max(bounds[i], boundary);
+        if(begin_r < split) {
+          misplaced_r.push_back(begin_r);
+          misplaced_r.push_back(split);
+        }
+      }
+
+      if(misplaced == 0) {
+        return boundary;
+      }
+
+      i64 const piece = math::max(misplaced / chunk_count, parallel_sort_grain);
+      parallel_for(
+        pool, irange(0, (misplaced + piece - 1) / piece), 1,
+        [first, &misplaced_l, &misplaced_r, misplaced, piece](i64 const p) {
+          i64 const begin = p * piece;
+          i64 const end = math::min(begin + piece, misplaced);
+          // Locate the begin-th misplaced element of both kinds.
+          i64 index_l = 0;
+          i64 skip_l = begin;
+          while(skip_l >= misplaced_l[index_l + 1] - misplaced_l[index_l]) {
+            skip_l -= misplaced_l[index_l + 1] - misplaced_l[index_l];
+            index_l += 2;
+          }
+
+          i64 index_r = 0;
+          i64 skip_r = begin;
+          while(skip_r >= misplaced_r[index_r + 1] - misplaced_r[index_r]) {
+            skip_r -= misplaced_r[index_r + 1] - misplaced_r[index_r];
+            index_r += 2;
+          }
+
+          i64 position_l = misplaced_l[index_l] + skip_l;
+          i64 position_r = misplaced_r[index_r] + skip_r;
+          for(i64 k = begin; k < end; ++k) {
+            swap(*(first + position_l), *(first + position_r));
+            position_l += 1;
+            if(position_l == misplaced_l[index_l + 1] && k + 1 < end) {
+              index_l += 2;
+              position_l = misplaced_l[index_l];
+            }
+
+            position_r += 1;
+            if(position_r == misplaced_r[index_r + 1] && k + 1 < end) {
+              index_r += 2;
+              position_r = misplaced_r[index_r];
+            }
+          }
+        });
+      return boundary;
+    }
+
+    // parallel_partition_pivot
+    // Partitions the range around the pivot *first with parallel_partition.
+    // Elements equal to the pivot are placed in the left partition if
+    // equal_left is true and in the right partition otherwise, which
+    // corresponds to partition_left and partition_right respectively.
+    //
+    // Returns:
+    // The position of the pivot.
+    //
+    template<typename Random_Access_Iterator, typename Predicate>
+    Random_Access_Iterator
+    parallel_partition_pivot(Thread_Pool& pool,
+                             Random_Access_Iterator const first,
+                             Random_Access_Iterator const last,
+                             i64 const chunk_count, Predicate& predicate,
+                             bool const equal_left)
+    {
+      // The pivot stays in place while the rest of the range is partitioned,
+      // hence it may be referenced by all tasks.
+      auto const& pivot = *first;
+      i64 count;
+      if(equal_left) {
+        auto is_left = [&pivot, &predicate](auto const& value) {
+          return !predicate(pivot, value);
+        };
+        count =
+          parallel_partition(pool, first + 1, last, chunk_count, is_left);
+      } else {
+        auto is_left = [&pivot, &predicate](auto const& value) {
+          return predicate(value, pivot);
+        };
+        count =
+          parallel_partition(pool, first + 1, last, chunk_count, is_left);
+      }
+
+      Random_Access_Iterator const pivot_position = first + count;
+      if(count > 0) {
+        swap(*first, *pivot_position);
+      }
+      return pivot_position;
+    }
+
+    template<typename Random_Access_Iterator, typename Predicate>
+    void parallel_sort_split(Thread_Pool& pool, Task_Group& group,
+                             Random_Access_Iterator first,
+                             Random_Access_Iterator last, Predicate& predicate,
+                             i64 bad_allowed, bool leftmost)
+    {
+      i64 const thread_count = pool.get_worker_count() + 1;
+      while(last - first > parallel_sort_grain) {
+        i64 const size = last - first;
+        // Ranges spanning several grains are partitioned by all threads.
+        i64 const chunk_count =
+          math::min(thread_count, size / parallel_sort_grain);
+        choose_pivot(first, last, predicate);
+        // Same as in pdq_sort. If the pivot is equal to the pivot of the
+        // parent partition, put the elements equal to it to the left and skip
+        // them.
+        if(!leftmost && !predicate(*(first - 1), *first)) {
+          if(chunk_count > 1) {
+            first = parallel_partition_pivot(pool, first, last, chunk_count,
+                                             predicate, true) +
+                    1;
+          } else {
+            first = partition_left(first, last, predicate) + 1;
+          }
+          continue;
+        }
+
+        Random_Access_Iterator pivot_position;
+        if(chunk_count > 1) {
+          pivot_position = parallel_partition_pivot(
+            pool, first, last, chunk_count, predicate, false);
+        } else {
+          pivot_position = partition_pivot(first, last, predicate).first;
+        }
+
+        i64 const size_l = pivot_position - first;
+        i64 const size_r = last - (pivot_position + 1);
+        if(size_l < size / 8 || size_r < size / 8) {
+          // Too many bad partitions. Fall back to heap sort to guarantee
+          // O(n log n).
+          bad_allowed -= 1;
+          if(bad_allowed == 0) {
+            heap_sort(first, last, predicate);
+            return;
+          }
+
+          break_patterns(first, pivot_position);
+          break_patterns(pivot_position + 1, last);
+        }
+
+        // Hand the larger part over to other workers and continue with the
+        // smaller one. Only the left part may be leftmost.
+        Random_Access_Iterator const middle = pivot_position + 1;
+        if(size_l < size_r) {
+          pool.spawn(group, [&pool, &group, middle, last, &predicate,
+                             bad_allowed]() {
+            parallel_sort_split(pool, group, middle, last, predicate,
+                                bad_allowed, false);
+          });
+          last = pivot_position;
+        } else {
+          pool.spawn(group, [&pool, &group, first, pivot_position, &predicate,
+                             bad_allowed, leftmost]() {
+            parallel_sort_split(pool, group, first, pivot_position, predicate,
+                                bad_allowed, leftmost);
+          });
+          first = middle;
+          leftmost = false;
+        }
+      }
+
+      pdq_sort(first, last, predicate, bad_allowed, leftmost);
+    }
+  } // namespace detail
+
+  // parallel_merge_sort
+  // Stable non-in-place sort executed in pool. The range is split into one run
+  // per thread, the runs are sorted concurrently with merge_sort and merged
+  // pairwise. Every merge is partitioned along the merge path into segments
+  // that are merged in parallel. Allocates additional memory proportional to
+  // last - first.
+  //
+  // Parameters:
+  //        pool - the pool to execute the sort in.
+  // first, last - the range to sort.
+  //   predicate - comparison function. Returns true when the first argument is
+  //               less than (i.e. ordered before) the second argument. The
+  //               function must not modify the objects passed to it and must be
+  //               safe to invoke concurrently.
+  //
+  template<typename Random_Access_Iterator, typename Predicate>
+  void parallel_merge_sort(Thread_Pool& pool, Random_Access_Iterator first,
+                           Random_Access_Iterator last, Predicate predicate)
+  {
+    i64 const length = last - first;
+    i64 const thread_count = pool.get_worker_count() + 1;
+    i64 const run_count = math::min(
+      thread_count, length / detail::parallel_sort_grain);
+    if(run_count < 2) {
+      merge_sort(first, last, predicate);
+      return;
+    }
+
+    using value_type =
+      typename Iterator_Traits<Random_Access_Iterator>::value_type;
+    Array<value_type> storage{reserve, length};
+    storage.force_size(length);
+    value_type* const storage_begin = storage.data();
+    Array<i64> bounds{reserve, run_count + 1};
+    for(i64 i = 0; i <= run_count; ++i) {
+      bounds.push_back(length * i / run_count);
+    }
+
+    // Move the runs to the storage and sort them there. The moved-from
+    // elements of the input range are overwritten by the merges.
+    {
+      Task_Group group;
+      for(i64 i = 0; i < run_count; ++i) {
+        i64 const begin = bounds[i];
+        i64 const end = bounds[i + 1];
+        pool.spawn(group, [first, storage_begin, begin, end, &predicate]() {
+          anton::uninitialized_move(first + begin, first + end,
+                                    storage_begin + begin);
+          merge_sort(storage_begin + begin, storage_begin + end, predicate);
+        });
+      }
+      pool.wait(group);
+    }
+
+    i64 const segment =
+      math::max(length / thread_count, detail::parallel_sort_grain);
+    // Direction of the merges. If true, merge from the storage to the input
+    // range.
+    bool storage_to_range = true;
+    while(bounds.size() > 2) {
+      if(storage_to_range) {
+        detail::parallel_merge_round(pool, storage_begin, first, bounds,
+                                     segment, predicate);
+      } else {
+        detail::parallel_merge_round(pool, first, storage_begin, bounds,
+                                     segment, predicate);
+      }
+      storage_to_range = !storage_to_range;
+
+      // Every other bound disappears since the adjacent runs were merged.
+      i64 const bound_count = bounds.size();
+      i64 write = 0;
+      for(i64 read = 0; read < bound_count; read += 2) {
+        bounds[write] = bounds[read];
+        ++write;
+      }
+      if(bounds[write - 1] != length) {
+        bounds[write] = length;
+        ++write;
+      }
+      bounds.erase(bounds.begin() + write, bounds.end());
+    }
+
+    // Move the elements back into the input range.
+    if(storage_to_range) {
+      parallel_for(pool, irange(0, length / segment + 1), 1,
+                   [first, storage_begin, length, segment](i64 const chunk) {
+                     i64 const begin = chunk * segment;
+                     i64 const end = math::min(begin + segment, length);
+                     anton::move(storage_begin + begin, storage_begin + end,
+                                 first + begin);
+                   });
+    }
+  }
+
+  template<typename Random_Access_Iterator, typename Predicate>
+  void parallel_merge_sort(Random_Access_Iterator first,
+                           Random_Access_Iterator last, Predicate predicate)
+  {
+    parallel_merge_sort(get_default_thread_pool(), first, last, predicate);
+  }
+
+  template<typename Random_Access_Iterator>
+  void parallel_merge_sort(Random_Access_Iterator first,
+                           Random_Access_Iterator last)
+  {
+    using value_type =
+      typename Iterator_Traits<Random_Access_Iterator>::value_type;
+    parallel_merge_sort(
+      get_default_thread_pool(), first, last,
+      [](value_type const& lhs, value_type const& rhs) { return lhs < rhs; });
+  }
+
+  // parallel_sort
+  // Unstable in-place sort executed in pool. The range is recursively
+  // partitioned the same way quick_sort does. Ranges spanning several grains
+  // are partitioned by all threads: every thread partitions a chunk and the
+  // misplaced elements are swapped in parallel. The larger part of every
+  // partition is handed over to the pool while the smaller is partitioned
+  // further. Parts below the parallel grain are sorted serially.
+  //
+  // Parameters:
+  //        pool - the pool to execute the sort in.
+  // first, last - the range to sort.
+  //   predicate - comparison function. Returns true when the first argument is
+  //               less than (i.e. ordered before) the second argument. The
+  //               function must not modify the objects passed to it and must be
+  //               safe to invoke concurrently.
+  //
+  template<typename Random_Access_Iterator, typename Predicate>
+  void parallel_sort(Thread_Pool& pool, Random_Access_Iterator first,
+                     Random_Access_Iterator last, Predicate predicate)
+  {
+    if(pool.get_worker_count() == 0 ||
+       last - first <= detail::parallel_sort_grain) {
+      quick_sort(first, last, predicate);
+      return;
+    }
+
+    Task_Group group;
+    detail::parallel_sort_split(pool, group, first, last, predicate,
+                                detail::sort_log2(last - first), true);
+    pool.wait(group);
+  }
+
+  template<typename Random_Access_Iterator, typename Predicate>
+  void parallel_sort(Random_Access_Iterator first, Random_Access_Iterator last,
+                     Predicate predicate)
+  {
+    parallel_sort(get_default_thread_pool(), first, last, predicate);
+  }
+
+  template<typename Random_Access_Iterator>
+  void parallel_sort(Random_Access_Iterator first, Random_Access_Iterator last)
+  {
+    using value_type =
+      typename Iterator_Traits<Random_Access_Iterator>::value_type;
+    parallel_sort(
+      get_default_thread_pool(), first, last,
+      [](value_type const& lhs, value_type const& rhs) { return lhs < rhs; });
+  }
+} // namespace anton
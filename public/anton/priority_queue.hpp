@@ -0,0 +1,628 @@
+#pragma once
+
+#include <anton/algorithm.hpp>
+#include <anton/allocator.hpp>
+#include <anton/array.hpp>
+#include <anton/assert.hpp>
+#include <anton/functors.hpp>
+#include <anton/swap.hpp>
+#include <anton/tags.hpp>
+#include <anton/type_traits.hpp>
+
+namespace anton {
+  namespace detail {
+    // Reverse_Compare
+    // Swaps the arguments of the wrapped comparison, which turns the max-heap
+    // algorithms into min-heap ones.
+    //
+    template<typename Compare>
+    struct Reverse_Compare {
+      Compare* compare;
+
+      template<typename T>
+      [[nodiscard]] bool operator()(T const& lhs, T const& rhs) const
+      {
+        return (*compare)(rhs, lhs);
+      }
+    };
+  } // namespace detail
+
+  // Priority_Queue
+  // A heap stored in an Array. The top of the queue is the element ordered
+  // before all other elements by Compare, i.e. the smallest element with the
+  // default Less_Compare.
+  //
+  // Arity is the number of children of every node of the heap. Heaps with 4
+  // or 8 children are shallower and keep the children of a node in a single
+  // cache line at the cost of more comparisons per level, which makes them
+  // faster than binary heaps when the elements are small.
+  //
+  template<typename T, typename Compare = Less_Compare<T>, i64 Arity = 2>
+  struct Priority_Queue {
+  public:
+    static_assert(Arity >= 2, "the arity of the heap must be at least 2");
+
+    using value_type = T;
+    using allocator_type = Polymorphic_Allocator;
+    using size_type = i64;
+
+    Priority_Queue();
+    explicit Priority_Queue(allocator_type const& allocator);
+    explicit Priority_Queue(Compare const& compare);
+    Priority_Queue(allocator_type const& allocator, Compare const& compare);
+    // Construct a priority queue with capacity to fit at least n elements.
+    Priority_Queue(allocator_type const& allocator, Reserve_Tag, size_type n);
+    // Priority_Queue
+    // Constructs the queue from the elements of [first, last[ in O(n).
+    //
+    template<typename Input_Iterator>
+    Priority_Queue(allocator_type const& allocator, Range_Construct_Tag,
+                   Input_Iterator first, Input_Iterator last);
+
+    // top
+    // Accesses the element ordered before all other elements. The behaviour is
+    // undefined when the queue is empty.
+    //
+    [[nodiscard]] T const& top() const;
+
+    // size
+    // The number of elements contained in the queue.
+    //
+    [[nodiscard]] size_type size() const;
+
+    [[nodiscard]] allocator_type& get_allocator();
+    [[nodiscard]] allocator_type const& get_allocator() const;
+
+    // ensure_capacity
+    // Allocates enough memory to fit requested_capacity elements.
+    //
+    void ensure_capacity(size_type requested_capacity);
+
+    // push
+    // Inserts value into the queue.
+    //
+    // Complexity: O(log n) comparisons.
+    //
+    void push(value_type const& value);
+    void push(value_type&& value);
+    template<typename... Args>
+    void emplace(Args&&... args);
+
+    // pop
+    // Removes the top element from the queue. The queue must not be empty.
+    //
+    // Complexity: O(Arity * log n) comparisons.
+    //
+    void pop();
+
+    // pop_top
+    // Removes the top element from the queue and returns it. The queue must
+    // not be empty.
+    //
+    [[nodiscard]] T pop_top();
+
+    // clear
+    // Destruct all elements of the queue.
+    //
+    void clear();
+
+    friend void swap(Priority_Queue& lhs, Priority_Queue& rhs)
+    {
+      using anton::swap;
+      swap(lhs._data, rhs._data);
+      swap(lhs._compare, rhs._compare);
+    }
+
+  private:
+    Array<T> _data;
+    Compare _compare;
+
+    [[nodiscard]] detail::Reverse_Compare<Compare> get_heap_compare();
+  };
+
+  // Indexed_Priority_Queue
+  // A binary heap that identifies its elements with handles. The handle of an
+  // element is returned by push and remains valid until the element is
+  // removed from the queue. The handles allow the priority of an element to
+  // be changed or the element to be removed in O(log n), which is needed by
+  // timer queues and graph search algorithms.
+  //
+  // The top of the queue is the element ordered before all other elements by
+  // Compare.
+  //
+  template<typename T, typename Compare = Less_Compare<T>>
+  struct Indexed_Priority_Queue {
+  public:
+    using value_type = T;
+    using allocator_type = Polymorphic_Allocator;
+    using size_type = i64;
+    using handle_type = i64;
+
+    Indexed_Priority_Queue();
+    explicit Indexed_Priority_Queue(allocator_type const& allocator);
+    explicit Indexed_Priority_Queue(Compare const& compare);
+    Indexed_Priority_Queue(allocator_type const& allocator,
+                           Compare const& compare);
+
+    // top
+    // Accesses the element ordered before all other elements. The behaviour is
+    // undefined when the queue is empty.
+    //
+    [[nodiscard]] T const& top() const;
+
+    // top_handle
+    // Obtains the handle of the top element. The behaviour is undefined when
+    // the queue is empty.
+    //
+    [[nodiscard]] handle_type top_handle() const;
+
+    // get
+    // Accesses the element identified by handle. handle must be contained in
+    // the queue.
+    //
+    [[nodiscard]] T const& get(handle_type handle) const;
+
+    // contains
+    //
+    // Returns:
+    // true if the element identified by handle is contained in the queue.
+    //
+    [[nodiscard]] bool contains(handle_type handle) const;
+
+    // size
+    // The number of elements contained in the queue.
+    //
+    [[nodiscard]] size_type size() const;
+
+    // push
+    // Inserts value into the queue.
+    //
+    // Returns:
+    // The handle identifying the inserted element.
+    //
+    // Complexity: O(log n) comparisons.
+    //
+    handle_type push(value_type const& value);
+    handle_type push(value_type&& value);
+
+    // pop
+    // Removes the top element from the queue and releases its handle. The
+    // queue must not be empty.
+    //
+    // Complexity: O(log n) comparisons.
+    //
+    void pop();
+
+    // decrease_key
+    // Replaces the element identified by handle with value which must not be
+    // ordered after the current element.
+    //
+    // Complexity: O(log n) comparisons.
+    //
+    void decrease_key(handle_type handle, value_type value);
+
+    // update
+    // Replaces the element identified by handle with value.
+    //
+    // Complexity: O(log n) comparisons.
+    //
+    void update(handle_type handle, value_type value);
+
+    // erase
+    // Removes the element identified by handle from the queue and releases the
+    // handle.
+    //
+    // Complexity: O(log n) comparisons.
+    //
+    void erase(handle_type handle);
+
+    // clear
+    // Removes all elements from the queue and releases all handles.
+    //
+    void clear();
+
+  private:
+    struct Entry {
+      T value;
+      handle_type handle;
+    };
+
+    Array<Entry> _heap;
+    // Maps the handles to the positions of the entries in _heap. The released
+    // handles store -1.
+    Array<i64> _positions;
+    Array<handle_type> _free_handles;
+    Compare _compare;
+
+    [[nodiscard]] handle_type acquire_handle();
+    void place(i64 index, Entry&& entry);
+    void sift_up(i64 index);
+    void sift_down(i64 index);
+    void remove_at(i64 index);
+  };
+} // namespace anton
+
+namespace anton {
+  template<typename T, typename Compare, i64 Arity>
+  Priority_Queue<T, Compare, Arity>::Priority_Queue(): _data(), _compare()
+  {
+  }
+
+  template<typename T, typename Compare, i64 Arity>
+  Priority_Queue<T, Compare, Arity>::Priority_Queue(
+    allocator_type const& allocator)
+    : _data(allocator), _compare()
+  {
+  }
+
+  template<typename T, typename Compare, i64 Arity>
+  Priority_Queue<T, Compare, Arity>::Priority_Queue(Compare const& compare)
+    : _data(), _compare(compare)
+  {
+  }
+
+  template<typename T, typename Compare, i64 Arity>
+  Priority_Queue<T, Compare, Arity>::Priority_Queue(
+    allocator_type const& allocator, Compare const& compare)
+    : _data(allocator), _compare(compare)
+  {
+  }
+
+  template<typename T, typename Compare, i64 Arity>
+  Priority_Queue<T, Compare, Arity>::Priority_Queue(
+    allocator_type const& allocator, Reserve_Tag, size_type const n)
+    : _data(allocator, reserve, n), _compare()
+  {
+  }
+
+  template<typename T, typename Compare, i64 Arity>
+  template<typename Input_Iterator>
+  Priority_Queue<T, Compare, Arity>::Priority_Queue(
+    allocator_type const& allocator, Range_Construct_Tag,
+    Input_Iterator first, Input_Iterator last)
+    : _data(allocator, range_construct, first, last), _compare()
+  {
+    detail::Reverse_Compare<Compare> compare = get_heap_compare();
+    size_type const length = _data.size();
+    // Sift down every node that has children starting with the last one.
+    for(size_type i = length > 1 ? (length - 2) / Arity + 1 : 0; i > 0;) {
+      --i;
+      detail::heap_sift_down<Arity>(_data.begin(), i, length, compare);
+    }
+  }
+
+  template<typename T, typename Compare, i64 Arity>
+  auto Priority_Queue<T, Compare, Arity>::top() const -> T const&
+  {
+    if constexpr(ANTON_ITERATOR_DEBUG) {
+      ANTON_VERIFY(_data.size() > 0, "attempting to access empty queue");
+    }
+    return _data[0];
+  }
+
+  template<typename T, typename Compare, i64 Arity>
+  auto Priority_Queue<T, Compare, Arity>::size() const -> size_type
+  {
+    return _data.size();
+  }
+
+  template<typename T, typename Compare, i64 Arity>
+  auto Priority_Queue<T, Compare, Arity>::get_allocator() -> allocator_type&
+  {
+    return _data.get_allocator();
+  }
+
+  template<typename T, typename Compare, i64 Arity>
+  auto Priority_Queue<T, Compare, Arity>::get_allocator() const
+    -> allocator_type const&
+  {
+    return _data.get_allocator();
+  }
+
+  template<typename T, typename Compare, i64 Arity>
+  void Priority_Queue<T, Compare, Arity>::ensure_capacity(
+    size_type const requested_capacity)
+  {
+    _data.ensure_capacity(requested_capacity);
+  }
+
+  template<typename T, typename Compare, i64 Arity>
+  void Priority_Queue<T, Compare, Arity>::push(value_type const& value)
+  {
+    _data.push_back(value);
+    detail::Reverse_Compare<Compare> compare = get_heap_compare();
+    detail::heap_sift_up<Arity>(_data.begin(), _data.size() - 1, compare);
+  }
+
+  template<typename T, typename Compare, i64 Arity>
+  void Priority_Queue<T, Compare, Arity>::push(value_type&& value)
+  {
+    _data.push_back(ANTON_MOV(value));
+    detail::Reverse_Compare<Compare> compare = get_heap_compare();
+    detail::heap_sift_up<Arity>(_data.begin(), _data.size() - 1, compare);
+  }
+
+  template<typename T, typename Compare, i64 Arity>
+  template<typename... Args>
+  void Priority_Queue<T, Compare, Arity>::emplace(Args&&... args)
+  {
+    _data.emplace_back(ANTON_FWD(args)...);
+    detail::Reverse_Compare<Compare> compare = get_heap_compare();
+    detail::heap_sift_up<Arity>(_data.begin(), _data.size() - 1, compare);
+  }
+
+  template<typename T, typename Compare, i64 Arity>
+  void Priority_Queue<T, Compare, Arity>::pop()
+  {
+    if constexpr(ANTON_ITERATOR_DEBUG) {
+      ANTON_VERIFY(_data.size() > 0, "attempting to pop from empty queue");
+    }
+
+    size_type const last = _data.size() - 1;
+    if(last > 0) {
+      _data[0] = ANTON_MOV(_data[last]);
+      _data.pop_back();
+      detail::Reverse_Compare<Compare> compare = get_heap_compare();
+      detail::heap_sift_down<Arity>(_data.begin(), 0, last, compare);
+    } else {
+      _data.pop_back();
+    }
+  }
+
+  template<typename T, typename Compare, i64 Arity>
+  auto Priority_Queue<T, Compare, Arity>::pop_top() -> T
+  {
+    if constexpr(ANTON_ITERATOR_DEBUG) {
+      ANTON_VERIFY(_data.size() > 0, "attempting to pop from empty queue");
+    }
+
+    T value = ANTON_MOV(_data[0]);
+    pop();
+    return value;
+  }
+
+  template<typename T, typename Compare, i64 Arity>
+  void Priority_Queue<T, Compare, Arity>::clear()
+  {
+    _data.clear();
+  }
+
+  template<typename T, typename Compare, i64 Arity>
+  auto Priority_Queue<T, Compare, Arity>::get_heap_compare()
+    -> detail::Reverse_Compare<Compare>
+  {
+    return detail::Reverse_Compare<Compare>{&_compare};
+  }
+
+  template<typename T, typename Compare>
+  Indexed_Priority_Queue<T, Compare>::Indexed_Priority_Queue()
+    : _heap(), _positions(), _free_handles(), _compare()
+  {
+  }
+
+  template<typename T, typename Compare>
+  Indexed_Priority_Queue<T, Compare>::Indexed_Priority_Queue(
+    allocator_type const& allocator)
+    : _heap(allocator), _positions(allocator), _free_handles(allocator),
+      _compare()
+  {
+  }
+
+  template<typename T, typename Compare>
+  Indexed_Priority_Queue<T, Compare>::Indexed_Priority_Queue(
+    Compare const& compare)
+    : _heap(), _positions(), _free_handles(), _compare(compare)
+  {
+  }
+
+  template<typename T, typename Compare>
+  Indexed_Priority_Queue<T, Compare>::Indexed_Priority_Queue(
+    allocator_type const& allocator, Compare const& compare)
+    : _heap(allocator), _positions(allocator), _free_handles(allocator),
+      _compare(compare)
+  {
+  }
+
+  template<typename T, typename Compare>
+  auto Indexed_Priority_Queue<T, Compare>::top() const -> T const&
+  {
+    if constexpr(ANTON_ITERATOR_DEBUG) {
+      ANTON_VERIFY(_heap.size() > 0, "attempting to access empty queue");
+    }
+    return _heap[0].value;
+  }
+
+  template<typename T, typename Compare>
+  auto Indexed_Priority_Queue<T, Compare>::top_handle() const -> handle_type
+  {
+    if constexpr(ANTON_ITERATOR_DEBUG) {
+      ANTON_VERIFY(_heap.size() > 0, "attempting to access empty queue");
+    }
+    return _heap[0].handle;
+  }
+
+  template<typename T, typename Compare>
+  auto Indexed_Priority_Queue<T, Compare>::get(handle_type const handle) const
+    -> T const&
+  {
+    if constexpr(ANTON_ITERATOR_DEBUG) {
+      ANTON_VERIFY(contains(handle), "handle is not contained in the queue");
+    }
+    return _heap[_positions[handle]].value;
+  }
+
+  template<typename T, typename Compare>
+  bool
+  Indexed_Priority_Queue<T, Compare>::contains(handle_type const handle) const
+  {
+    return handle >= 0 && handle < _positions.size() && _positions[handle] >= 0;
+  }
+
+  template<typename T, typename Compare>
+  auto Indexed_Priority_Queue<T, Compare>::size() const -> size_type
+  {
+    return _heap.size();
+  }
+
+  template<typename T, typename Compare>
+  auto Indexed_Priority_Queue<T, Compare>::push(value_type const& value)
+    -> handle_type
+  {
+    return push(value_type(value));
+  }
+
+  template<typename T, typename Compare>
+  auto Indexed_Priority_Queue<T, Compare>::push(value_type&& value)
+    -> handle_type
+  {
+    handle_type const handle = acquire_handle();
+    i64 const index = _heap.size();
+    _heap.push_back(Entry{ANTON_MOV(value), handle});
+    _positions[handle] = index;
+    sift_up(index);
+    return handle;
+  }
+
+  template<typename T, typename Compare>
+  void Indexed_Priority_Queue<T, Compare>::pop()
+  {
+    if constexpr(ANTON_ITERATOR_DEBUG) {
+      ANTON_VERIFY(_heap.size() > 0, "attempting to pop from empty queue");
+    }
+    remove_at(0);
+  }
+
+  template<typename T, typename Compare>
+  void Indexed_Priority_Queue<T, Compare>::decrease_key(
+    handle_type const handle, value_type value)
+  {
+    if constexpr(ANTON_ITERATOR_DEBUG) {
+      ANTON_VERIFY(contains(handle), "handle is not contained in the queue");
+    }
+    i64 const index = _positions[handle];
+    ANTON_ASSERT(!_compare(_heap[index].value, value),
+                 "decrease_key must not order the element later");
+    _heap[index].value = ANTON_MOV(value);
+    sift_up(index);
+  }
+
+  template<typename T, typename Compare>
+  void Indexed_Priority_Queue<T, Compare>::update(handle_type const handle,
+                                                  value_type value)
+  {
+    if constexpr(ANTON_ITERATOR_DEBUG) {
+      ANTON_VERIFY(contains(handle), "handle is not contained in the queue");
+    }
+    i64 const index = _positions[handle];
+    bool const decreased = _compare(value, _heap[index].value);
+    _heap[index].value = ANTON_MOV(value);
+    if(decreased) {
+      sift_up(index);
+    } else {
+      sift_down(index);
+    }
+  }
+
+  template<typename T, typename Compare>
+  void Indexed_Priority_Queue<T, Compare>::erase(handle_type const handle)
+  {
+    if constexpr(ANTON_ITERATOR_DEBUG) {
+      ANTON_VERIFY(contains(handle), "handle is not contained in the queue");
+    }
+    remove_at(_positions[handle]);
+  }
+
+  template<typename T, typename Compare>
+  void Indexed_Priority_Queue<T, Compare>::clear()
+  {
+    _heap.clear();
+    _positions.clear();
+    _free_handles.clear();
+  }
+
+  template<typename T, typename Compare>
+  auto Indexed_Priority_Queue<T, Compare>::acquire_handle() -> handle_type
+  {
+    if(_free_handles.size() > 0) {
+      handle_type const handle = _free_handles.back();
+      _free_handles.pop_back();
+      return handle;
+    } else {
+      _positions.push_back(-1);
+      return _positions.size() - 1;
+    }
+  }
+
+  template<typename T, typename Compare>
+  void Indexed_Priority_Queue<T, Compare>::place(i64 const index, Entry&& entry)
+  {
+    _positions[entry.handle] = index;
+    _heap[index] = ANTON_MOV(entry);
+  }
+
+  template<typename T, typename Compare>
+  void Indexed_Priority_Queue<T, Compare>::sift_up(i64 index)
+  {
+    Entry entry = ANTON_MOV(_heap[index]);
+    while(index > 0) {
+      i64 const parent = (index - 1) / 2;
+      if(!_compare(entry.value, _heap[parent].value)) {
+        break;
+      }
+
+      place(index, ANTON_MOV(_heap[parent]));
+      index = parent;
+    }
+    place(index, ANTON_MOV(entry));
+  }
+
+  template<typename T, typename Compare>
+  void Indexed_Priority_Queue<T, Compare>::sift_down(i64 index)
+  {
+    i64 const length = _heap.size();
+    Entry entry = ANTON_MOV(_heap[index]);
+    while(true) {
+      i64 child = 2 * index + 1;
+      if(child >= length) {
+        break;
+      }
+
+      if(child + 1 < length &&
+         _compare(_heap[child + 1].value, _heap[child].value)) {
+        child += 1;
+      }
+
+      if(!_compare(_heap[child].value, entry.value)) {
+        break;
+      }
+
+      place(index, ANTON_MOV(_heap[child]));
+      index = child;
+    }
+    place(index, ANTON_MOV(entry));
+  }
+
+  template<typename T, typename Compare>
+  void Indexed_Priority_Queue<T, Compare>::remove_at(i64 const index)
+  {
+    handle_type const handle = _heap[index].handle;
+    _positions[handle] = -1;
+    _free_handles.push_back(handle);
+    i64 const last = _heap.size() - 1;
+    if(index != last) {
+      // Fill the hole with the last entry and restore the heap in whichever
+      // direction the entry has to move.
+      bool const decreased = _compare(_heap[last].value, _heap[index].value);
+      _heap[index] = ANTON_MOV(_heap[last]);
+      _heap.pop_back();
+      _positions[_heap[index].handle] = index;
+      if(decreased) {
+        sift_up(index);
+      } else {
+        sift_down(index);
+      }
+    } else {
+      _heap.pop_back();
+    }
+  }
+} // namespace anton
@@ -0,0 +1,385 @@
+#pragma once
+
+#include <anton/allocator.hpp>
+#include <anton/array.hpp>
+#include <anton/detail/crt.hpp>
+#include <anton/iterators.hpp>
+#include <anton/memory.hpp>
+#include <anton/sort.hpp>
+#include <anton/string_view.hpp>
+#include <anton/type_traits/properties.hpp>
+#include <anton/type_traits/transformations.hpp>
+#include <anton/type_traits/utility.hpp>
+
+namespace anton {
+  namespace detail {
+    // Ranges smaller than this are sorted with insertion sort since the
+    // histogram passes do not pay off.
+    constexpr i64 radix_sort_insertion_threshold = 64;
+
+    template<i64 Size>
+    struct Radix_Bits;
+
+    template<>
+    struct Radix_Bits<1> {
+      using type = u8;
+    };
+
+    template<>
+    struct Radix_Bits<2> {
+      using type = u16;
+    };
+
+    template<>
+    struct Radix_Bits<4> {
+      using type = u32;
+    };
+
+    template<>
+    struct Radix_Bits<8> {
+      using type = u64;
+    };
+
+    template<typename Key>
+    using radix_bits = typename Radix_Bits<sizeof(Key)>::type;
+
+    // radix_key_bits
+    // Maps key to an unsigned integer with the same ordering. The sign bit of
+    // signed integers is flipped. Negative floating point numbers have all bits
+    // flipped and positive have the sign bit flipped, which orders -0.0 before
+    // 0.0 and NaNs at the ends depending on their sign.
+    //
+    template<typename Key>
+    [[nodiscard]] radix_bits<Key> radix_key_bits(Key const key)
+    {
+      using bits_type = radix_bits<Key>;
+      constexpr bits_type sign_bit = static_cast<bits_type>(
+        static_cast<bits_type>(1) << (sizeof(Key) * 8 - 1));
+      if constexpr(is_floating_point<Key>) {
+        bits_type bits;
+        memcpy(&bits, &key, sizeof(Key));
+        if(bits & sign_bit) {
+          return static_cast<bits_type>(~bits);
+        } else {
+          return static_cast<bits_type>(bits | sign_bit);
+        }
+      } else if constexpr(is_signed<Key>) {
+        return static_cast<bits_type>(static_cast<bits_type>(key) ^ sign_bit);
+      } else {
+        return static_cast<bits_type>(key);
+      }
+    }
+
+    // allocate_radix_buffer
+    // Allocates the uninitialized scratch buffer of length elements.
+    //
+    // Returns:
+    // The buffer or nullptr if the allocation failed.
+    //
+    template<typename T>
+    [[nodiscard]] T* allocate_radix_buffer(Memory_Allocator* const allocator,
+                                           i64 const length)
+    {
+      return static_cast<T*>(allocator->allocate(
+        length * static_cast<i64>(sizeof(T)), alignof(T)));
+    }
+
+    template<typename Random_Access_Iterator, typename Key_Extractor>
+    void lsd_radix_sort(Random_Access_Iterator const first,
+                        Random_Access_Iterator const last,
+                        Key_Extractor& key_extractor,
+                        Memory_Allocator* const allocator)
+    {
+      using value_type =
+        typename Iterator_Traits<Random_Access_Iterator>::value_type;
+      using key_type = decay<decltype(key_extractor(*first))>;
+      constexpr i64 digit_count = sizeof(key_type);
+
+      auto predicate = [&key_extractor](value_type const& lhs,
+                                        value_type const& rhs) {
+        return radix_key_bits(key_extractor(lhs)) <
+               radix_key_bits(key_extractor(rhs));
+      };
+      i64 const length = last - first;
+      if(length < radix_sort_insertion_threshold) {
+        guarded_insertion_sort(first, last, predicate);
+        return;
+      }
+
+      // Build the histograms of all digits in a single pass.
+      i64 histograms[digit_count][256] = {};
+      for(Random_Access_Iterator i = first; i != last; ++i) {
+        auto const bits = radix_key_bits(key_extractor(*i));
+        for(i64 digit = 0; digit < digit_count; ++digit) {
+          histograms[digit][(bits >> (digit * 8)) & 0xFF] += 1;
+        }
+      }
+
+      value_type* buffer = nullptr;
+      // Whether the elements currently reside in the buffer.
+      bool in_buffer = false;
+      for(i64 digit = 0; digit < digit_count; ++digit) {
+        i64* const histogram = histograms[digit];
+        // Convert the histogram to offsets. Skip the digit if all elements
+        // fall into one bucket since the pass would not change the order.
+        bool constant = false;
+        for(i64 bucket = 0, offset = 0; bucket < 256; ++bucket) {
+          i64 const count = histogram[bucket];
+          constant |= count == length;
+          histogram[bucket] = offset;
+          offset += count;
+        }
+
+        if(constant) {
+          continue;
+        }
+
+        i64 const shift = digit * 8;
+        if(buffer == nullptr) {
+          // The first scatter always goes from the range to the buffer and
+          // constructs the elements in it.
+          buffer = allocate_radix_buffer<value_type>(allocator, length);
+          if(buffer == nullptr) {
+            // Nothing has been moved yet.
+            anton::merge_sort(first, last, nullptr, predicate);
+            return;
+          }
+
+          for(Random_Access_Iterator i = first; i != last; ++i) {
+            auto const bits = radix_key_bits(key_extractor(*i));
+            i64& offset = histogram[(bits >> shift) & 0xFF];
+            construct(buffer + offset, ANTON_MOV(*i));
+            offset += 1;
+          }
+        } else if(!in_buffer) {
+          for(Random_Access_Iterator i = first; i != last; ++i) {
+            auto const bits = radix_key_bits(key_extractor(*i));
+            i64& offset = histogram[(bits >> shift) & 0xFF];
+            buffer[offset] = ANTON_MOV(*i);
+            offset += 1;
+          }
+        } else {
+          for(value_type* i = buffer, *end = buffer + length; i != end; ++i) {
+            auto const bits = radix_key_bits(key_extractor(*i));
+            i64& offset = histogram[(bits >> shift) & 0xFF];
+            *(first + offset) = ANTON_MOV(*i);
+            offset += 1;
+          }
+        }
+        in_buffer = !in_buffer;
+      }
+
+      if(buffer != nullptr) {
+        if(in_buffer) {
+          anton::move(buffer, buffer + length, first);
+        }
+        destruct_n(buffer, length);
+        allocator->deallocate(buffer,
+                              length * static_cast<i64>(sizeof(value_type)),
+                              alignof(value_type));
+      }
+    }
+
+    // radix_byte
+    // Obtains the byte of key at depth offset by 1. Keys shorter than depth
+    // yield 0 which orders them before all keys that continue.
+    //
+    [[nodiscard]] inline i64 radix_byte(String_View const key, i64 const depth)
+    {
+      if(depth < key.size_bytes()) {
+        return static_cast<i64>(static_cast<u8>(key.data()[depth])) + 1;
+      } else {
+        return 0;
+      }
+    }
+
+    // compare_suffix
+    // Lexicographically compares the bytes of lhs and rhs starting at depth.
+    //
+    [[nodiscard]] inline i64 compare_suffix(String_View const lhs,
+                                            String_View const rhs,
+                                            i64 const depth)
+    {
+      i64 const lhs_size = lhs.size_bytes() - depth;
+      i64 const rhs_size = rhs.size_bytes() - depth;
+      i64 const size = lhs_size < rhs_size ? lhs_size : rhs_size;
+      if(size > 0) {
+        int const result =
+          memcmp(lhs.data() + depth, rhs.data() + depth, static_cast<u64>(size));
+        if(result != 0) {
+          return result;
+        }
+      }
+      return lhs_size - rhs_size;
+    }
+
+    template<typename Random_Access_Iterator, typename Key_Extractor>
+    void msd_radix_sort(Random_Access_Iterator const first,
+                        Random_Access_Iterator const last,
+                        Key_Extractor& key_extractor,
+                        Memory_Allocator* const allocator)
+    {
+      using value_type =
+        typename Iterator_Traits<Random_Access_Iterator>::value_type;
+      struct Bucket_Range {
+        i64 begin;
+        i64 end;
+        i64 depth;
+      };
+
+      i64 const length = last - first;
+      value_type* buffer = nullptr;
+      // Explicit stack instead of recursion since the depth is bounded only
+      // by the length of the longest key.
+      Array<Bucket_Range> stack{Polymorphic_Allocator(allocator)};
+      stack.push_back(Bucket_Range{0, length, 0});
+      while(stack.size() > 0) {
+        Bucket_Range const range = stack.back();
+        stack.pop_back();
+        Random_Access_Iterator const begin = first + range.begin;
+        Random_Access_Iterator const end = first + range.end;
+        i64 const count = range.end - range.begin;
+        i64 const depth = range.depth;
+        if(count < radix_sort_insertion_threshold) {
+          auto predicate = [&key_extractor, depth](value_type const& lhs,
+                                                   value_type const& rhs) {
+            return compare_suffix(key_extractor(lhs), key_extractor(rhs),
+                                  depth) < 0;
+          };
+          guarded_insertion_sort(begin, end, predicate);
+          continue;
+        }
+
+        i64 offsets[257] = {};
+        for(Random_Access_Iterator i = begin; i != end; ++i) {
+          offsets[radix_byte(key_extractor(*i), depth)] += 1;
+        }
+
+        // All keys share the byte at depth. Skip the scatter and proceed to
+        // the next byte unless all keys have ended.
+        bool constant = false;
+        for(i64 bucket = 0; bucket < 257; ++bucket) {
+          if(offsets[bucket] == count) {
+            constant = true;
+            if(bucket != 0) {
+              stack.push_back(Bucket_Range{range.begin, range.end, depth + 1});
+            }
+            break;
+          }
+        }
+
+        if(constant) {
+          continue;
+        }
+
+        i64 bucket_ends[257];
+        for(i64 bucket = 0, offset = 0; bucket < 257; ++bucket) {
+          i64 const bucket_count = offsets[bucket];
+          offsets[bucket] = offset;
+          offset += bucket_count;
+          bucket_ends[bucket] = offset;
+        }
+
+        if(buffer == nullptr) {
+          buffer = allocate_radix_buffer<value_type>(allocator, length);
+          if(buffer == nullptr) {
+            // The buckets sorted so far are still a permutation of the range,
+            // hence sorting the whole range from the first byte is correct.
+            auto predicate = [&key_extractor](value_type const& lhs,
+                                              value_type const& rhs) {
+              return compare_suffix(key_extractor(lhs), key_extractor(rhs),
+                                    0) < 0;
+            };
+            anton::merge_sort(first, last, nullptr, predicate);
+            return;
+          }
+        }
+
+        // Scatter into the buffer and move back. The scatter is stable.
+        for(Random_Access_Iterator i = begin; i != end; ++i) {
+          i64& offset = offsets[radix_byte(key_extractor(*i), depth)];
+          construct(buffer + offset, ANTON_MOV(*i));
+          offset += 1;
+        }
+        anton::move(buffer, buffer + count, begin);
+        destruct_n(buffer, count);
+
+        // Bucket 0 contains the keys that have ended. They are equal.
+        for(i64 bucket = 1, bucket_begin = bucket_ends[0]; bucket < 257;
+            ++bucket) {
+          i64 const bucket_end = bucket_ends[bucket];
+          if(bucket_end - bucket_begin > 1) {
+            stack.push_back(Bucket_Range{range.begin + bucket_begin,
+                                         range.begin + bucket_end, depth + 1});
+          }
+          bucket_begin = bucket_end;
+        }
+      }
+
+      if(buffer != nullptr) {
+        allocator->deallocate(buffer,
+                              length * static_cast<i64>(sizeof(value_type)),
+                              alignof(value_type));
+      }
+    }
+  } // namespace detail
+
+  // radix_sort
+  // Stable non-comparison sort. Sorts by the keys obtained with key_extractor.
+  //
+  // Integer and floating point keys are sorted with LSD radix sort with 8-bit
+  // digits. The histograms of all digits are built in a single pass and the
+  // digits that are equal in all keys are skipped. Floating point keys are
+  // ordered by their bit patterns, i.e. -0.0 is ordered before 0.0 and NaNs
+  // are placed at the ends.
+  //
+  // Keys convertible to String_View are sorted with MSD radix sort on bytes,
+  // which orders the keys lexicographically by their code units. Common
+  // prefixes are skipped without moving the elements.
+  //
+  // Parameters:
+  //         first, last - the range to sort.
+  //       key_extractor - function object with signature Key(value_type const&)
+  //                       where Key is an arithmetic type or a type
+  //                       convertible to String_View.
+  //           allocator - allocator used to allocate the scratch buffer.
+  //
+  // Complexity:
+  // O(n * k) where k is the number of bytes of the keys. Allocates additional
+  // memory proportional to last - first. If the allocation fails, falls back
+  // to merge_sort without a buffer.
+  //
+  template<typename Random_Access_Iterator, typename Key_Extractor>
+  void radix_sort(Random_Access_Iterator first, Random_Access_Iterator last,
+                  Key_Extractor key_extractor,
+                  Memory_Allocator* const allocator = get_default_allocator())
+  {
+    using key_type = decay<decltype(key_extractor(*first))>;
+    if(last - first < 2) {
+      return;
+    }
+
+    if constexpr(is_arithmetic<key_type>) {
+      detail::lsd_radix_sort(first, last, key_extractor, allocator);
+    } else {
+      detail::msd_radix_sort(first, last, key_extractor, allocator);
+    }
+  }
+
+  // radix_sort
+  // Sorts a range of arithmetic values or values convertible to String_View
+  // using the values themselves as keys.
+  //
+  template<typename Random_Access_Iterator>
+  void radix_sort(Random_Access_Iterator first, Random_Access_Iterator last)
+  {
+    using value_type =
+      typename Iterator_Traits<Random_Access_Iterator>::value_type;
+    if constexpr(is_arithmetic<value_type>) {
+      radix_sort(first, last, [](value_type const& v) { return v; });
+    } else {
+      radix_sort(first, last,
+                 [](value_type const& v) { return String_View(v); });
+    }
+  }
+} // namespace anton
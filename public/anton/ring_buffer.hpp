@@ -0,0 +1,679 @@
+#pragma once
+
+#include <anton/allocator.hpp>
+#include <anton/assert.hpp>
+#include <anton/iterators.hpp>
+#include <anton/math/math.hpp>
+#include <anton/memory.hpp>
+#include <anton/pair.hpp>
+#include <anton/slice.hpp>
+#include <anton/swap.hpp>
+#include <anton/tags.hpp>
+#include <anton/type_traits.hpp>
+
+namespace anton {
+// Must be a power of 2.
+#ifndef ANTON_RING_BUFFER_MIN_ALLOCATION_SIZE
+  #define ANTON_RING_BUFFER_MIN_ALLOCATION_SIZE (static_cast<i64>(8))
+#endif
+
+  // Ring_Buffer_Iterator
+  // Random access iterator over the elements of a Ring_Buffer. Stores the
+  // unmasked logical position of the element so that the iterators past the
+  // wrap-around point still compare and subtract correctly.
+  //
+  template<typename Value_Type>
+  struct Ring_Buffer_Iterator {
+  public:
+    using value_type = remove_const<Value_Type>;
+    using pointer = Value_Type*;
+    using reference = Value_Type&;
+    using difference_type = i64;
+    using iterator_category = Random_Access_Iterator_Tag;
+
+    Ring_Buffer_Iterator() = default;
+    Ring_Buffer_Iterator(Value_Type* data, i64 mask, i64 position)
+      : _data(data), _mask(mask), _position(position)
+    {
+    }
+
+    // Conversion operator to the const version of the iterator
+    [[nodiscard]] operator Ring_Buffer_Iterator<Value_Type const>() const
+    {
+      return {_data, _mask, _position};
+    }
+
+    [[nodiscard]] pointer operator->() const
+    {
+      return _data + (_position & _mask);
+    }
+
+    [[nodiscard]] reference operator*() const
+    {
+      return _data[_position & _mask];
+    }
+
+    [[nodiscard]] reference operator[](difference_type n) const
+    {
+      return _data[(_position + n) & _mask];
+    }
+
+    Ring_Buffer_Iterator& operator++()
+    {
+      ++_position;
+      return *this;
+    }
+
+    Ring_Buffer_Iterator& operator--()
+    {
+      --_position;
+      return *this;
+    }
+
+    [[nodiscard]] Ring_Buffer_Iterator operator++(int)
+    {
+      Ring_Buffer_Iterator copy = *this;
+      ++_position;
+      return copy;
+    }
+
+    [[nodiscard]] Ring_Buffer_Iterator operator--(int)
+    {
+      Ring_Buffer_Iterator copy = *this;
+      --_position;
+      return copy;
+    }
+
+    Ring_Buffer_Iterator& operator+=(difference_type n)
+    {
+      _position += n;
+      return *this;
+    }
+
+    Ring_Buffer_Iterator& operator-=(difference_type n)
+    {
+      _position -= n;
+      return *this;
+    }
+
+    [[nodiscard]] Ring_Buffer_Iterator operator+(difference_type n) const
+    {
+      return {_data, _mask, _position + n};
+    }
+
+    [[nodiscard]] friend Ring_Buffer_Iterator
+    operator+(difference_type n, Ring_Buffer_Iterator const& i)
+    {
+      return {i._data, i._mask, i._position + n};
+    }
+
+    [[nodiscard]] Ring_Buffer_Iterator operator-(difference_type n) const
+    {
+      return {_data, _mask, _position - n};
+    }
+
+    [[nodiscard]] difference_type
+    operator-(Ring_Buffer_Iterator const& other) const
+    {
+      return _position - other._position;
+    }
+
+    [[nodiscard]] bool operator==(Ring_Buffer_Iterator const& other) const
+    {
+      return _position == other._position;
+    }
+
+    [[nodiscard]] bool operator!=(Ring_Buffer_Iterator const& other) const
+    {
+      return _position != other._position;
+    }
+
+    [[nodiscard]] bool operator<(Ring_Buffer_Iterator const& other) const
+    {
+      return _position < other._position;
+    }
+
+    [[nodiscard]] bool operator>(Ring_Buffer_Iterator const& other) const
+    {
+      return _position > other._position;
+    }
+
+    [[nodiscard]] bool operator<=(Ring_Buffer_Iterator const& other) const
+    {
+      return _position <= other._position;
+    }
+
+    [[nodiscard]] bool operator>=(Ring_Buffer_Iterator const& other) const
+    {
+      return _position >= other._position;
+    }
+
+  private:
+    Value_Type* _data = nullptr;
+    i64 _mask = 0;
+    i64 _position = 0;
+  };
+
+  // Ring_Buffer
+  // A double-ended queue backed by a single circular buffer. The capacity is
+  // always a power of 2 so that the physical index of an element is obtained
+  // by masking instead of a division. Pushing and popping at both ends is
+  // amortized O(1) and does not allocate once the buffer has grown to fit the
+  // working set.
+  //
+  // The elements occupy at most two contiguous regions of the buffer. These
+  // may be obtained with as_slices for bulk processing.
+  //
+  template<typename T>
+  struct Ring_Buffer {
+  public:
+    using value_type = T;
+    using allocator_type = Polymorphic_Allocator;
+    using size_type = i64;
+    using difference_type = i64;
+    using iterator = Ring_Buffer_Iterator<T>;
+    using const_iterator = Ring_Buffer_Iterator<T const>;
+
+    Ring_Buffer();
+    explicit Ring_Buffer(allocator_type const& allocator);
+    // Construct a ring buffer with capacity to fit at least n elements.
+    explicit Ring_Buffer(Reserve_Tag, size_type n);
+    // Construct a ring buffer with capacity to fit at least n elements.
+    explicit Ring_Buffer(allocator_type const& allocator, Reserve_Tag,
+                         size_type n);
+    // Copies the allocator.
+    Ring_Buffer(Ring_Buffer const& other);
+    // Moves the allocator.
+    Ring_Buffer(Ring_Buffer&& other);
+    ~Ring_Buffer();
+
+    Ring_Buffer& operator=(Ring_Buffer const& other);
+    Ring_Buffer& operator=(Ring_Buffer&& other);
+
+    // operator[]
+    // Accesses the element at index counted from the front.
+    //
+    [[nodiscard]] T& operator[](size_type index);
+    [[nodiscard]] T const& operator[](size_type index) const;
+
+    // front, back
+    // Access the first and the last element respectively. The behaviour is
+    // undefined when the ring buffer is empty.
+    //
+    [[nodiscard]] T& front();
+    [[nodiscard]] T const& front() const;
+    [[nodiscard]] T& back();
+    [[nodiscard]] T const& back() const;
+
+    [[nodiscard]] iterator begin();
+    [[nodiscard]] iterator end();
+    [[nodiscard]] const_iterator begin() const;
+    [[nodiscard]] const_iterator end() const;
+    [[nodiscard]] const_iterator cbegin() const;
+    [[nodiscard]] const_iterator cend() const;
+
+    // as_slices
+    // Obtains views of the two contiguous regions occupied by the elements.
+    // The first slice starts at the front element, the second slice contains
+    // the elements that wrapped around to the beginning of the buffer and is
+    // empty if no elements wrapped around.
+    //
+    [[nodiscard]] Pair<Slice<T>, Slice<T>> as_slices();
+    [[nodiscard]] Pair<Slice<T const>, Slice<T const>> as_slices() const;
+
+    // size
+    // The number of elements contained in the ring buffer.
+    //
+    [[nodiscard]] size_type size() const;
+
+    // capacity
+    // The number of elements the ring buffer can hold without reallocating.
+    // Always 0 or a power of 2.
+    //
+    [[nodiscard]] size_type capacity() const;
+
+    [[nodiscard]] allocator_type& get_allocator();
+    [[nodiscard]] allocator_type const& get_allocator() const;
+
+    // ensure_capacity
+    // Allocates enough memory to fit requested_capacity elements. The capacity
+    // is rounded up to the next power of 2. Does nothing if
+    // requested_capacity is less than capacity().
+    //
+    void ensure_capacity(size_type requested_capacity);
+
+    T& push_back(value_type const& value);
+    T& push_back(value_type&& value);
+    template<typename... Args>
+    T& emplace_back(Args&&... args);
+
+    T& push_front(value_type const& value);
+    T& push_front(value_type&& value);
+    template<typename... Args>
+    T& emplace_front(Args&&... args);
+
+    void pop_back();
+    void pop_front();
+
+    // pop_front
+    // Destroys the first n elements of the ring buffer. n must not be greater
+    // than size().
+    //
+    void pop_front(size_type n);
+
+    // clear
+    // Destruct all objects contained in the ring buffer.
+    //
+    void clear();
+
+    // reset
+    // Destruct all objects contained in the ring buffer and free the memory,
+    // essentially resetting the state to initial empty state.
+    //
+    void reset();
+
+    friend void swap(Ring_Buffer& lhs, Ring_Buffer& rhs)
+    {
+      using anton::swap;
+      swap(lhs._allocator, rhs._allocator);
+      swap(lhs._capacity, rhs._capacity);
+      swap(lhs._head, rhs._head);
+      swap(lhs._size, rhs._size);
+      swap(lhs._data, rhs._data);
+    }
+
+  private:
+    allocator_type _allocator;
+    size_type _capacity = 0;
+    // Physical index of the front element.
+    size_type _head = 0;
+    size_type _size = 0;
+    T* _data = nullptr;
+
+    [[nodiscard]] T* get_ptr(size_type index) const;
+    // relocate_into
+    // Moves the elements in order into the beginning of new_data and destroys
+    // the old elements.
+    //
+    void relocate_into(T* new_data);
+    T* allocate(size_type);
+    void deallocate(void*, size_type);
+  };
+} // namespace anton
+
+namespace anton {
+  template<typename T>
+  Ring_Buffer<T>::Ring_Buffer(): _allocator()
+  {
+  }
+
+  template<typename T>
+  Ring_Buffer<T>::Ring_Buffer(allocator_type const& allocator)
+    : _allocator(allocator)
+  {
+  }
+
+  template<typename T>
+  Ring_Buffer<T>::Ring_Buffer(Reserve_Tag, size_type const n)
+    : Ring_Buffer(allocator_type(), reserve, n)
+  {
+  }
+
+  template<typename T>
+  Ring_Buffer<T>::Ring_Buffer(allocator_type const& allocator, Reserve_Tag,
+                              size_type const n)
+    : _allocator(allocator)
+  {
+    ensure_capacity(n);
+  }
+
+  template<typename T>
+  Ring_Buffer<T>::Ring_Buffer(Ring_Buffer const& other): _allocator()
+  {
+    ensure_capacity(other._size);
+    Pair<Slice<T const>, Slice<T const>> const slices = other.as_slices();
+    T* const end = anton::uninitialized_copy(
+      slices.first.begin(), slices.first.end(), _data);
+    anton::uninitialized_copy(slices.second.begin(), slices.second.end(), end);
+    _size = other._size;
+  }
+
+  template<typename T>
+  Ring_Buffer<T>::Ring_Buffer(Ring_Buffer&& other)
+    : _allocator(ANTON_MOV(other._allocator)), _capacity(other._capacity),
+      _head(other._head), _size(other._size), _data(other._data)
+  {
+    other._capacity = 0;
+    other._head = 0;
+    other._size = 0;
+    other._data = nullptr;
+  }
+
+  template<typename T>
+  Ring_Buffer<T>::~Ring_Buffer()
+  {
+    clear();
+    deallocate(_data, _capacity);
+  }
+
+  template<typename T>
+  Ring_Buffer<T>& Ring_Buffer<T>::operator=(Ring_Buffer const& other)
+  {
+    clear();
+    // We do not shrink the container to fit as it is faster that way - we avoid
+    // an allocation after all! Shrinking may be requested by the user
+    // explicitly.
+    ensure_capacity(other._size);
+    _head = 0;
+    Pair<Slice<T const>, Slice<T const>> const slices = other.as_slices();
+    T* const end = anton::uninitialized_copy(
+      slices.first.begin(), slices.first.end(), _data);
+    anton::uninitialized_copy(slices.second.begin(), slices.second.end(), end);
+    _size = other._size;
+    return *this;
+  }
+
+  template<typename T>
+  Ring_Buffer<T>& Ring_Buffer<T>::operator=(Ring_Buffer&& other)
+  {
+    swap(*this, other);
+    return *this;
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::operator[](size_type const index) -> T&
+  {
+    if constexpr(ANTON_ITERATOR_DEBUG) {
+      ANTON_FAIL(index < _size && index >= 0, "index out of bounds");
+    }
+
+    return *get_ptr(index);
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::operator[](size_type const index) const -> T const&
+  {
+    if constexpr(ANTON_ITERATOR_DEBUG) {
+      ANTON_FAIL(index < _size && index >= 0, "index out of bounds");
+    }
+
+    return *get_ptr(index);
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::front() -> T&
+  {
+    if constexpr(ANTON_ITERATOR_DEBUG) {
+      ANTON_FAIL(_size > 0, "attempting to call front() on empty Ring_Buffer");
+    }
+
+    return _data[_head];
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::front() const -> T const&
+  {
+    if constexpr(ANTON_ITERATOR_DEBUG) {
+      ANTON_FAIL(_size > 0, "attempting to call front() on empty Ring_Buffer");
+    }
+
+    return _data[_head];
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::back() -> T&
+  {
+    if constexpr(ANTON_ITERATOR_DEBUG) {
+      ANTON_FAIL(_size > 0, "attempting to call back() on empty Ring_Buffer");
+    }
+
+    return *get_ptr(_size - 1);
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::back() const -> T const&
+  {
+    if constexpr(ANTON_ITERATOR_DEBUG) {
+      ANTON_FAIL(_size > 0, "attempting to call back() on empty Ring_Buffer");
+    }
+
+    return *get_ptr(_size - 1);
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::begin() -> iterator
+  {
+    return iterator(_data, _capacity - 1, _head);
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::end() -> iterator
+  {
+    return iterator(_data, _capacity - 1, _head + _size);
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::begin() const -> const_iterator
+  {
+    return const_iterator(_data, _capacity - 1, _head);
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::end() const -> const_iterator
+  {
+    return const_iterator(_data, _capacity - 1, _head + _size);
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::cbegin() const -> const_iterator
+  {
+    return const_iterator(_data, _capacity - 1, _head);
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::cend() const -> const_iterator
+  {
+    return const_iterator(_data, _capacity - 1, _head + _size);
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::as_slices() -> Pair<Slice<T>, Slice<T>>
+  {
+    size_type const first_size = math::min(_size, _capacity - _head);
+    return {Slice<T>(_data + _head, first_size),
+            Slice<T>(_data, _size - first_size)};
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::as_slices() const
+    -> Pair<Slice<T const>, Slice<T const>>
+  {
+    size_type const first_size = math::min(_size, _capacity - _head);
+    return {Slice<T const>(_data + _head, first_size),
+            Slice<T const>(_data, _size - first_size)};
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::size() const -> size_type
+  {
+    return _size;
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::capacity() const -> size_type
+  {
+    return _capacity;
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::get_allocator() -> allocator_type&
+  {
+    return _allocator;
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::get_allocator() const -> allocator_type const&
+  {
+    return _allocator;
+  }
+
+  template<typename T>
+  void Ring_Buffer<T>::ensure_capacity(size_type const requested_capacity)
+  {
+    if(requested_capacity > _capacity) {
+      size_type new_capacity =
+        (_capacity > 0 ? _capacity : ANTON_RING_BUFFER_MIN_ALLOCATION_SIZE);
+      while(new_capacity < requested_capacity) {
+        new_capacity *= 2;
+      }
+
+      T* const new_data = allocate(new_capacity);
+      relocate_into(new_data);
+      deallocate(_data, _capacity);
+      _data = new_data;
+      _capacity = new_capacity;
+      _head = 0;
+    }
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::push_back(value_type const& value) -> T&
+  {
+    return emplace_back(value);
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::push_back(value_type&& value) -> T&
+  {
+    return emplace_back(ANTON_MOV(value));
+  }
+
+  template<typename T>
+  template<typename... Args>
+  auto Ring_Buffer<T>::emplace_back(Args&&... args) -> T&
+  {
+    ensure_capacity(_size + 1);
+    T* const element = get_ptr(_size);
+    anton::construct(element, ANTON_FWD(args)...);
+    ++_size;
+    return *element;
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::push_front(value_type const& value) -> T&
+  {
+    return emplace_front(value);
+  }
+
+  template<typename T>
+  auto Ring_Buffer<T>::push_front(value_type&& value) -> T&
+  {
+    return emplace_front(ANTON_MOV(value));
+  }
+
+  template<typename T>
+  template<typename... Args>
+  auto Ring_Buffer<T>::emplace_front(Args&&... args) -> T&
+  {
+    ensure_capacity(_size + 1);
+    size_type const new_head = (_head - 1) & (_capacity - 1);
+    T* const element = _data + new_head;
+    anton::construct(element, ANTON_FWD(args)...);
+    _head = new_head;
+    ++_size;
+    return *element;
+  }
+
+  template<typename T>
+  void Ring_Buffer<T>::pop_back()
+  {
+    ANTON_VERIFY(_size > 0, "pop_back called on an empty Ring_Buffer");
+    anton::destruct(get_ptr(_size - 1));
+    --_size;
+  }
+
+  template<typename T>
+  void Ring_Buffer<T>::pop_front()
+  {
+    ANTON_VERIFY(_size > 0, "pop_front called on an empty Ring_Buffer");
+    anton::destruct(_data + _head);
+    _head = (_head + 1) & (_capacity - 1);
+    --_size;
+  }
+
+  template<typename T>
+  void Ring_Buffer<T>::pop_front(size_type const n)
+  {
+    ANTON_VERIFY(n >= 0 && n <= _size,
+                 "pop_front called with n greater than size");
+    if constexpr(!is_trivially_destructible<T>) {
+      for(size_type i = 0; i < n; ++i) {
+        anton::destruct(get_ptr(i));
+      }
+    }
+    if(n > 0) {
+      _head = (_head + n) & (_capacity - 1);
+      _size -= n;
+    }
+  }
+
+  template<typename T>
+  void Ring_Buffer<T>::clear()
+  {
+    Pair<Slice<T>, Slice<T>> const slices = as_slices();
+    anton::destruct(slices.first.begin(), slices.first.end());
+    anton::destruct(slices.second.begin(), slices.second.end());
+    _head = 0;
+    _size = 0;
+  }
+
+  template<typename T>
+  void Ring_Buffer<T>::reset()
+  {
+    clear();
+    deallocate(_data, _capacity);
+    _capacity = 0;
+    _data = nullptr;
+  }
+
+  template<typename T>
+  T* Ring_Buffer<T>::get_ptr(size_type const index) const
+  {
+    return _data + ((_head + index) & (_capacity - 1));
+  }
+
+  template<typename T>
+  void Ring_Buffer<T>::relocate_into(T* const new_data)
+  {
+    Pair<Slice<T>, Slice<T>> const slices = as_slices();
+    T* end = new_data;
+    if constexpr(is_move_constructible<T>) {
+      end = anton::uninitialized_move(slices.first.begin(), slices.first.end(),
+                                      end);
+      anton::uninitialized_move(slices.second.begin(), slices.second.end(),
+                                end);
+    } else {
+      end = anton::uninitialized_copy(slices.first.begin(), slices.first.end(),
+                                      end);
+      anton::uninitialized_copy(slices.second.begin(), slices.second.end(),
+                                end);
+    }
+    anton::destruct(slices.first.begin(), slices.first.end());
+    anton::destruct(slices.second.begin(), slices.second.end());
+  }
+
+  template<typename T>
+  T* Ring_Buffer<T>::allocate(size_type const size)
+  {
+    void* mem = _allocator.allocate(size * static_cast<isize>(sizeof(T)),
+                                    static_cast<isize>(alignof(T)));
+    return static_cast<T*>(mem);
+  }
+
+  template<typename T>
+  void Ring_Buffer<T>::deallocate(void* mem, size_type const size)
+  {
+    _allocator.deallocate(mem, size * static_cast<isize>(sizeof(T)),
+                          static_cast<isize>(alignof(T)));
+  }
+} // namespace anton
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <anton/allocator.hpp>
+#include <anton/iterators/base.hpp>
+#include <anton/ranges.hpp>
+#include <anton/string.hpp>
+#include <anton/string_view.hpp>
+#include <anton/types.hpp>
+
+namespace anton {
+  namespace detail {
+    struct Rope_Node;
+  } // namespace detail
+
+  // Rope_Chunk_Iterator
+  // Iterates the chunks of a Rope in order. The chunks are contiguous,
+  // well-formed UTF-8 and never empty. The default constructed iterator is
+  // the end iterator.
+  //
+  struct Rope_Chunk_Iterator {
+  public:
+    using value_type = String_View;
+    using difference_type = isize;
+    using iterator_category = Forward_Iterator_Tag;
+
+    Rope_Chunk_Iterator() = default;
+    Rope_Chunk_Iterator(detail::Rope_Node const* root,
+                        detail::Rope_Node const* leaf, i64 offset);
+
+    // Complexity: O(log n) in the number of chunks.
+    //
+    Rope_Chunk_Iterator& operator++();
+    Rope_Chunk_Iterator operator++(int);
+
+    [[nodiscard]] value_type operator*() const;
+
+    // get_offset
+    // The offset of the first byte of the chunk from the beginning of the
+    // rope.
+    //
+    [[nodiscard]] i64 get_offset() const;
+
+    [[nodiscard]] bool operator==(Rope_Chunk_Iterator const& other) const
+    {
+      return _leaf == other._leaf;
+    }
+
+    [[nodiscard]] bool operator!=(Rope_Chunk_Iterator const& other) const
+    {
+      return _leaf != other._leaf;
+    }
+
+  private:
+    detail::Rope_Node const* _root = nullptr;
+    detail::Rope_Node const* _leaf = nullptr;
+    i64 _offset = 0;
+  };
+
+  // Rope
+  // A UTF-8 string for large editable text, stored as a balanced tree of
+  // chunks of at most max_chunk_size bytes. Every node records the number
+  // of bytes, code points and line feeds in its subtree, therefore
+  // inserting, erasing and locating positions by bytes, code points or
+  // lines take logarithmic time regardless of the size of the text.
+  //
+  // The positions are byte offsets which must lie on code point boundaries.
+  // The inserted text must be well-formed UTF-8.
+  //
+  struct Rope {
+  public:
+    using allocator_type = Polymorphic_Allocator;
+    using size_type = i64;
+
+    // The largest size of a chunk in bytes.
+    static constexpr i64 max_chunk_size = 1024;
+
+    Rope();
+    explicit Rope(allocator_type const& allocator);
+    // Rope
+    //
+    // Complexity: O(n) in the size of string.
+    //
+    explicit Rope(String_View string);
+    Rope(allocator_type const& allocator, String_View string);
+    Rope(Rope const& other);
+    Rope(Rope&& other);
+    ~Rope();
+    Rope& operator=(Rope const& other);
+    Rope& operator=(Rope&& other);
+
+    [[nodiscard]] allocator_type& get_allocator();
+    [[nodiscard]] allocator_type const& get_allocator() const;
+
+    // size_bytes
+    //
+    [[nodiscard]] size_type size_bytes() const;
+
+    // size_utf8
+    // The number of code points.
+    //
+    [[nodiscard]] size_type size_utf8() const;
+
+    // line_count
+    // The number of lines, which is the number of line feeds + 1.
+    //
+    [[nodiscard]] size_type line_count() const;
+
+    // chunks
+    //
+    // Returns:
+    // The chunks of the rope in order.
+    //
+    [[nodiscard]] Range<Rope_Chunk_Iterator> chunks() const;
+
+    // insert
+    // Inserts string at offset. Text inserted into a chunk with enough free
+    // space is stored in place.
+    //
+    // Parameters:
+    // offset - the byte offset in [0, size_bytes()] to insert at.
+    // string - well-formed UTF-8.
+    //
+    // Complexity: O(m + log n) where m is the size of string and n is the
+    // number of chunks.
+    //
+    void insert(i64 offset, String_View string);
+
+    // append
+    // Inserts string at the end of the rope.
+    //
+    // Complexity: O(m + log n) where m is the size of string and n is the
+    // number of chunks.
+    //
+    void append(String_View string);
+
+    // erase
+    // Removes the bytes [first, last[.
+    //
+    // Complexity: O(log n) in the number of chunks.
+    //
+    void erase(i64 first, i64 last);
+
+    // clear
+    // Removes all text.
+    //
+    void clear();
+
+    // get_byte_offset
+    //
+    // Returns:
+    // The byte offset of the code point at position index in
+    // [0, size_utf8()]. The position size_utf8() corresponds to the end of
+    // the rope.
+    //
+    // Complexity: O(log n) in the number of chunks.
+    //
+    [[nodiscard]] i64 get_byte_offset(i64 index) const;
+
+    // get_line_offset
+    //
+    // Returns:
+    // The byte offset of the first byte of the line in [0, line_count()[.
+    //
+    // Complexity: O(log n) in the number of chunks.
+    //
+    [[nodiscard]] i64 get_line_offset(i64 line) const;
+
+    // get_char_index
+    //
+    // Returns:
+    // The number of code points preceding the byte offset in
+    // [0, size_bytes()].
+    //
+    // Complexity: O(log n) in the number of chunks.
+    //
+    [[nodiscard]] i64 get_char_index(i64 offset) const;
+
+    // get_line_index
+    //
+    // Returns:
+    // The line containing the byte offset in [0, size_bytes()].
+    //
+    // Complexity: O(log n) in the number of chunks.
+    //
+    [[nodiscard]] i64 get_line_index(i64 offset) const;
+
+    // char_at
+    //
+    // Returns:
+    // The code point at position index in [0, size_utf8()[.
+    //
+    // Complexity: O(log n) in the number of chunks.
+    //
+    [[nodiscard]] char32 char_at(i64 index) const;
+
+    // to_string
+    // Copies the text into a contiguous string.
+    //
+    [[nodiscard]] String to_string() const;
+
+    friend void swap(Rope& lhs, Rope& rhs);
+
+  private:
+    allocator_type _allocator;
+    detail::Rope_Node* _root = nullptr;
+  };
+} // namespace anton
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <anton/detail/string_search.hpp>
+#include <anton/string7_view.hpp>
+#include <anton/string_view.hpp>
+#include <anton/types.hpp>
+
+namespace anton {
+  // Searcher
+  // A substring preprocessed for repeated searches. Looking for the same
+  // substring in many strings with a Searcher preprocesses the substring
+  // only once.
+  //
+  // The searcher refers to the bytes of the substring, which must outlive it.
+  //
+  struct Searcher {
+  public:
+    explicit Searcher(String_View substr);
+    explicit Searcher(String7_View substr);
+
+    // get_substring
+    // The substring looked for.
+    //
+    [[nodiscard]] String_View get_substring() const;
+
+    // find
+    // Finds the first occurrence of the substring within string.
+    //
+    // Returns:
+    // The start position of the substring within string or npos if the
+    // substring is not present.
+    //
+    // Complexity: Linear in the size of string.
+    //
+    [[nodiscard]] i64 find(String_View string) const;
+    [[nodiscard]] i64 find(String7_View string) const;
+
+  private:
+    char8 const* _data;
+    i64 _size;
+    detail::Two_Way_Table _table;
+  };
+} // namespace anton
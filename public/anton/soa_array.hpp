@@ -0,0 +1,583 @@
+#pragma once
+
+#include <anton/allocator.hpp>
+#include <anton/assert.hpp>
+#include <anton/iterators/zip.hpp>
+#include <anton/memory.hpp>
+#include <anton/slice.hpp>
+#include <anton/swap.hpp>
+#include <anton/tags.hpp>
+#include <anton/tuple.hpp>
+#include <anton/type_traits.hpp>
+
+namespace anton {
+#ifndef ANTON_SOA_ARRAY_MIN_ALLOCATION_SIZE
+  #define ANTON_SOA_ARRAY_MIN_ALLOCATION_SIZE (static_cast<i64>(8))
+#endif
+
+  namespace detail {
+    template<typename... Ts>
+    [[nodiscard]] constexpr i64 soa_block_alignment()
+    {
+      i64 alignment = 1;
+      ((alignment = (static_cast<i64>(alignof(Ts)) > alignment
+                       ? static_cast<i64>(alignof(Ts))
+                       : alignment)),
+       ...);
+      return alignment;
+    }
+
+    template<typename Callable, u64... Indices>
+    void soa_for_each_index(Callable&& callable,
+                            integer_sequence<u64, Indices...>)
+    {
+      (callable(Integral_Constant<u64, Indices>()), ...);
+    }
+  } // namespace detail
+
+  // SoA_Array
+  // A dynamic array of rows with fields Ts... stored as a structure of arrays.
+  // Every field is kept in its own contiguous column, so that scans over a
+  // subset of the fields touch only the memory of the columns they need. All
+  // columns live in a single allocation and share the size and the capacity.
+  //
+  // Rows are accessed as tuples of references to the fields. Iteration over
+  // the rows is done with Zip_Iterator over the column pointers.
+  //
+  template<typename... Ts>
+  struct SoA_Array {
+    static_assert(sizeof...(Ts) > 1,
+                  "SoA_Array requires at least 2 fields, use Array instead");
+
+  public:
+    using value_type = Tuple<Ts...>;
+    using reference = Tuple<Ts&...>;
+    using const_reference = Tuple<Ts const&...>;
+    using allocator_type = Polymorphic_Allocator;
+    using size_type = i64;
+    using difference_type = i64;
+    using iterator = Zip_Iterator<Ts*...>;
+    using const_iterator = Zip_Iterator<Ts const*...>;
+
+    template<u64 Index>
+    using column_type = tuple_element<Index, Tuple<Ts...>>;
+
+    SoA_Array();
+    explicit SoA_Array(allocator_type const& allocator);
+    // Construct an array with n rows of default constructed fields.
+    explicit SoA_Array(size_type n);
+    // Construct an array with n rows of default constructed fields.
+    explicit SoA_Array(allocator_type const& allocator, size_type n);
+    // Construct an array with capacity to fit at least n rows.
+    explicit SoA_Array(Reserve_Tag, size_type n);
+    // Construct an array with capacity to fit at least n rows.
+    explicit SoA_Array(allocator_type const& allocator, Reserve_Tag,
+                       size_type n);
+    // Copies the allocator.
+    SoA_Array(SoA_Array const& other);
+    // Moves the allocator.
+    SoA_Array(SoA_Array&& other);
+    ~SoA_Array();
+
+    SoA_Array& operator=(SoA_Array const& other);
+    SoA_Array& operator=(SoA_Array&& other);
+
+    // operator[]
+    // Accesses the row at index.
+    //
+    // Returns:
+    // Tuple of references to the fields of the row.
+    //
+    [[nodiscard]] reference operator[](size_type index);
+    [[nodiscard]] const_reference operator[](size_type index) const;
+
+    // column
+    // Obtains a view of the column storing the field at Index. The view is
+    // invalidated by any operation that changes the capacity.
+    //
+    template<u64 Index>
+    [[nodiscard]] Slice<column_type<Index>> column();
+    template<u64 Index>
+    [[nodiscard]] Slice<column_type<Index> const> column() const;
+
+    [[nodiscard]] iterator begin();
+    [[nodiscard]] iterator end();
+    [[nodiscard]] const_iterator begin() const;
+    [[nodiscard]] const_iterator end() const;
+    [[nodiscard]] const_iterator cbegin() const;
+    [[nodiscard]] const_iterator cend() const;
+
+    // size
+    // The number of rows contained in the array.
+    //
+    [[nodiscard]] size_type size() const;
+
+    [[nodiscard]] size_type capacity() const;
+
+    [[nodiscard]] allocator_type& get_allocator();
+    [[nodiscard]] allocator_type const& get_allocator() const;
+
+    // resize
+    // Resizes the array allocating additional memory if n is greater than
+    // capacity.
+    // If n is greater than size, the fields of the new rows are default
+    // constructed.
+    // If n is less than size, the excess rows are destroyed.
+    //
+    void resize(size_type n);
+
+    // ensure_capacity
+    // Allocates enough memory to fit requested_capacity rows.
+    // Does nothing if requested_capacity is less than capacity().
+    //
+    void ensure_capacity(size_type requested_capacity);
+
+    // push_back
+    // Appends a row to the end of the array.
+    //
+    // Returns:
+    // Tuple of references to the fields of the appended row.
+    //
+    reference push_back(Ts const&... values);
+    reference push_back(Ts&&... values);
+
+    void pop_back();
+
+    // erase_unsorted
+    // Removes the row at index by moving the last row into its place.
+    //
+    void erase_unsorted(size_type index);
+
+    // clear
+    // Destruct all rows contained in the array.
+    //
+    void clear();
+
+    // reset
+    // Destruct all rows contained in the array and free the memory,
+    // essentially resetting the state to initial empty state.
+    //
+    void reset();
+
+    friend void swap(SoA_Array& lhs, SoA_Array& rhs)
+    {
+      using anton::swap;
+      swap(lhs._allocator, rhs._allocator);
+      swap(lhs._capacity, rhs._capacity);
+      swap(lhs._size, rhs._size);
+      swap(lhs._columns, rhs._columns);
+    }
+
+  private:
+    using columns_type = Tuple<Ts*...>;
+    using indices_type = make_integer_sequence<u64, sizeof...(Ts)>;
+
+    static constexpr i64 block_alignment = detail::soa_block_alignment<Ts...>();
+
+    allocator_type _allocator;
+    size_type _capacity = 0;
+    size_type _size = 0;
+    columns_type _columns{static_cast<Ts*>(nullptr)...};
+
+    // compute_layout
+    // Computes the offsets of the columns within a block fitting capacity
+    // rows.
+    //
+    // Returns:
+    // The size of the block in bytes.
+    //
+    static i64 compute_layout(size_type capacity, i64* offsets);
+    template<u64... Indices>
+    columns_type allocate(size_type capacity, integer_sequence<u64, Indices...>);
+    void deallocate(columns_type const& columns, size_type capacity);
+    template<typename... Args, u64... Indices>
+    void construct_row(size_type index, integer_sequence<u64, Indices...>,
+                       Args&&... args);
+    template<u64... Indices>
+    reference get_row(size_type index, integer_sequence<u64, Indices...>);
+    template<u64... Indices>
+    const_reference get_row(size_type index,
+                            integer_sequence<u64, Indices...>) const;
+  };
+} // namespace anton
+
+namespace anton {
+  template<typename... Ts>
+  SoA_Array<Ts...>::SoA_Array(): _allocator()
+  {
+  }
+
+  template<typename... Ts>
+  SoA_Array<Ts...>::SoA_Array(allocator_type const& allocator)
+    : _allocator(allocator)
+  {
+  }
+
+  template<typename... Ts>
+  SoA_Array<Ts...>::SoA_Array(size_type const n)
+    : SoA_Array(allocator_type(), n)
+  {
+  }
+
+  template<typename... Ts>
+  SoA_Array<Ts...>::SoA_Array(allocator_type const& allocator,
+                              size_type const n)
+    : _allocator(allocator)
+  {
+    resize(n);
+  }
+
+  template<typename... Ts>
+  SoA_Array<Ts...>::SoA_Array(Reserve_Tag, size_type const n)
+    : SoA_Array(allocator_type(), reserve, n)
+  {
+  }
+
+  template<typename... Ts>
+  SoA_Array<Ts...>::SoA_Array(allocator_type const& allocator, Reserve_Tag,
+                              size_type const n)
+    : _allocator(allocator)
+  {
+    ensure_capacity(n);
+  }
+
+  template<typename... Ts>
+  SoA_Array<Ts...>::SoA_Array(SoA_Array const& other): _allocator()
+  {
+    ensure_capacity(other._size);
+    detail::soa_for_each_index(
+      [this, &other](auto index) {
+        constexpr u64 I = decltype(index)::value;
+        anton::uninitialized_copy_n(get<I>(other._columns), other._size,
+                                    get<I>(_columns));
+      },
+      indices_type());
+    _size = other._size;
+  }
+
+  template<typename... Ts>
+  SoA_Array<Ts...>::SoA_Array(SoA_Array&& other)
+    : _allocator(ANTON_MOV(other._allocator)), _capacity(other._capacity),
+      _size(other._size), _columns(other._columns)
+  {
+    other._capacity = 0;
+    other._size = 0;
+    other._columns = columns_type{static_cast<Ts*>(nullptr)...};
+  }
+
+  template<typename... Ts>
+  SoA_Array<Ts...>::~SoA_Array()
+  {
+    clear();
+    deallocate(_columns, _capacity);
+  }
+
+  template<typename... Ts>
+  SoA_Array<Ts...>& SoA_Array<Ts...>::operator=(SoA_Array const& other)
+  {
+    clear();
+    ensure_capacity(other._size);
+    detail::soa_for_each_index(
+      [this, &other](auto index) {
+        constexpr u64 I = decltype(index)::value;
+        anton::uninitialized_copy_n(get<I>(other._columns), other._size,
+                                    get<I>(_columns));
+      },
+      indices_type());
+    _size = other._size;
+    return *this;
+  }
+
+  template<typename... Ts>
+  SoA_Array<Ts...>& SoA_Array<Ts...>::operator=(SoA_Array&& other)
+  {
+    swap(*this, other);
+    return *this;
+  }
+
+  template<typename... Ts>
+  auto SoA_Array<Ts...>::operator[](size_type const index) -> reference
+  {
+    if constexpr(ANTON_ITERATOR_DEBUG) {
+      ANTON_FAIL(index < _size && index >= 0, "index out of bounds");
+    }
+
+    return get_row(index, indices_type());
+  }
+
+  template<typename... Ts>
+  auto SoA_Array<Ts...>::operator[](size_type const index) const
+    -> const_reference
+  {
+    if constexpr(ANTON_ITERATOR_DEBUG) {
+      ANTON_FAIL(index < _size && index >= 0, "index out of bounds");
+    }
+
+    return get_row(index, indices_type());
+  }
+
+  template<typename... Ts>
+  template<u64 Index>
+  auto SoA_Array<Ts...>::column() -> Slice<column_type<Index>>
+  {
+    return Slice<column_type<Index>>(get<Index>(_columns), _size);
+  }
+
+  template<typename... Ts>
+  template<u64 Index>
+  auto SoA_Array<Ts...>::column() const -> Slice<column_type<Index> const>
+  {
+    return Slice<column_type<Index> const>(get<Index>(_columns), _size);
+  }
+
+  template<typename... Ts>
+  auto SoA_Array<Ts...>::begin() -> iterator
+  {
+    return apply(_columns,
+                 [](Ts*... columns) -> iterator { return iterator(columns...); });
+  }
+
+  template<typename... Ts>
+  auto SoA_Array<Ts...>::end() -> iterator
+  {
+    size_type const size = _size;
+    return apply(_columns, [size](Ts*... columns) -> iterator {
+      return iterator((columns + size)...);
+    });
+  }
+
+  template<typename... Ts>
+  auto SoA_Array<Ts...>::begin() const -> const_iterator
+  {
+    return apply(_columns, [](Ts* const... columns) -> const_iterator {
+      return const_iterator(static_cast<Ts const*>(columns)...);
+    });
+  }
+
+  template<typename... Ts>
+  auto SoA_Array<Ts...>::end() const -> const_iterator
+  {
+    size_type const size = _size;
+    return apply(_columns, [size](Ts* const... columns) -> const_iterator {
+      return const_iterator(static_cast<Ts const*>(columns + size)...);
+    });
+  }
+
+  template<typename... Ts>
+  auto SoA_Array<Ts...>::cbegin() const -> const_iterator
+  {
+    return begin();
+  }
+
+  template<typename... Ts>
+  auto SoA_Array<Ts...>::cend() const -> const_iterator
+  {
+    return end();
+  }
+
+  template<typename... Ts>
+  auto SoA_Array<Ts...>::size() const -> size_type
+  {
+    return _size;
+  }
+
+  template<typename... Ts>
+  auto SoA_Array<Ts...>::capacity() const -> size_type
+  {
+    return _capacity;
+  }
+
+  template<typename... Ts>
+  auto SoA_Array<Ts...>::get_allocator() -> allocator_type&
+  {
+    return _allocator;
+  }
+
+  template<typename... Ts>
+  auto SoA_Array<Ts...>::get_allocator() const -> allocator_type const&
+  {
+    return _allocator;
+  }
+
+  template<typename... Ts>
+  void SoA_Array<Ts...>::resize(size_type const n)
+  {
+    ensure_capacity(n);
+    size_type const size = _size;
+    detail::soa_for_each_index(
+      [this, n, size](auto index) {
+        constexpr u64 I = decltype(index)::value;
+        auto* const column = get<I>(_columns);
+        if(n > size) {
+          anton::uninitialized_default_construct(column + size, column + n);
+        } else {
+          anton::destruct(column + n, column + size);
+        }
+      },
+      indices_type());
+    _size = n;
+  }
+
+  template<typename... Ts>
+  void SoA_Array<Ts...>::ensure_capacity(size_type const requested_capacity)
+  {
+    if(requested_capacity <= _capacity) {
+      return;
+    }
+
+    size_type new_capacity =
+      (_capacity > 0 ? _capacity : ANTON_SOA_ARRAY_MIN_ALLOCATION_SIZE);
+    while(new_capacity < requested_capacity) {
+      new_capacity *= 2;
+    }
+
+    columns_type new_columns = allocate(new_capacity, indices_type());
+    detail::soa_for_each_index(
+      [this, &new_columns](auto index) {
+        constexpr u64 I = decltype(index)::value;
+        using type = column_type<I>;
+        if constexpr(is_move_constructible<type>) {
+          anton::uninitialized_move_n(get<I>(_columns), _size,
+                                      get<I>(new_columns));
+        } else {
+          anton::uninitialized_copy_n(get<I>(_columns), _size,
+                                      get<I>(new_columns));
+        }
+        anton::destruct_n(get<I>(_columns), _size);
+      },
+      indices_type());
+    deallocate(_columns, _capacity);
+    _columns = new_columns;
+    _capacity = new_capacity;
+  }
+
+  template<typename... Ts>
+  auto SoA_Array<Ts...>::push_back(Ts const&... values) -> reference
+  {
+    ensure_capacity(_size + 1);
+    construct_row(_size, indices_type(), values...);
+    _size += 1;
+    return get_row(_size - 1, indices_type());
+  }
+
+  template<typename... Ts>
+  auto SoA_Array<Ts...>::push_back(Ts&&... values) -> reference
+  {
+    ensure_capacity(_size + 1);
+    construct_row(_size, indices_type(), ANTON_MOV(values)...);
+    _size += 1;
+    return get_row(_size - 1, indices_type());
+  }
+
+  template<typename... Ts>
+  void SoA_Array<Ts...>::pop_back()
+  {
+    ANTON_VERIFY(_size > 0, "pop_back called on an empty SoA_Array");
+    _size -= 1;
+    apply(_columns, [size = _size](Ts*... columns) {
+      (anton::destruct(columns + size), ...);
+    });
+  }
+
+  template<typename... Ts>
+  void SoA_Array<Ts...>::erase_unsorted(size_type const index)
+  {
+    if constexpr(ANTON_ITERATOR_DEBUG) {
+      ANTON_FAIL(index < _size && index >= 0, "index out of bounds");
+    }
+
+    size_type const last = _size - 1;
+    apply(_columns, [index, last](Ts*... columns) {
+      // Prevent self assignment
+      if(index != last) {
+        ((columns[index] = ANTON_MOV(columns[last])), ...);
+      }
+      (anton::destruct(columns + last), ...);
+    });
+    _size -= 1;
+  }
+
+  template<typename... Ts>
+  void SoA_Array<Ts...>::clear()
+  {
+    apply(_columns, [size = _size](Ts*... columns) {
+      (anton::destruct_n(columns, size), ...);
+    });
+    _size = 0;
+  }
+
+  template<typename... Ts>
+  void SoA_Array<Ts...>::reset()
+  {
+    clear();
+    deallocate(_columns, _capacity);
+    _columns = columns_type{static_cast<Ts*>(nullptr)...};
+    _capacity = 0;
+  }
+
+  template<typename... Ts>
+  i64 SoA_Array<Ts...>::compute_layout(size_type const capacity,
+                                       i64* const offsets)
+  {
+    i64 offset = 0;
+    i64 index = 0;
+    ((offset = static_cast<i64>(align_address(offset, alignof(Ts))),
+      offsets[index++] = offset,
+      offset += capacity * static_cast<i64>(sizeof(Ts))),
+     ...);
+    return static_cast<i64>(align_address(offset, block_alignment));
+  }
+
+  template<typename... Ts>
+  template<u64... Indices>
+  auto SoA_Array<Ts...>::allocate(size_type const capacity,
+                                  integer_sequence<u64, Indices...>)
+    -> columns_type
+  {
+    i64 offsets[sizeof...(Ts)];
+    i64 const size = compute_layout(capacity, offsets);
+    char8* const block =
+      static_cast<char8*>(_allocator.allocate(size, block_alignment));
+    return columns_type{reinterpret_cast<Ts*>(block + offsets[Indices])...};
+  }
+
+  template<typename... Ts>
+  void SoA_Array<Ts...>::deallocate(columns_type const& columns,
+                                    size_type const capacity)
+  {
+    // The first column is always placed at the beginning of the block.
+    void* const block = get<0>(columns);
+    if(block != nullptr) {
+      i64 offsets[sizeof...(Ts)];
+      i64 const size = compute_layout(capacity, offsets);
+      _allocator.deallocate(block, size, block_alignment);
+    }
+  }
+
+  template<typename... Ts>
+  template<typename... Args, u64... Indices>
+  void SoA_Array<Ts...>::construct_row(size_type const index,
+                                       integer_sequence<u64, Indices...>,
+                                       Args&&... args)
+  {
+    (anton::construct(get<Indices>(_columns) + index, ANTON_FWD(args)), ...);
+  }
+
+  template<typename... Ts>
+  template<u64... Indices>
+  auto SoA_Array<Ts...>::get_row(size_type const index,
+                                 integer_sequence<u64, Indices...>)
+    -> reference
+  {
+    return reference(get<Indices>(_columns)[index]...);
+  }
+
+  template<typename... Ts>
+  template<u64... Indices>
+  auto SoA_Array<Ts...>::get_row(size_type const index,
+                                 integer_sequence<u64, Indices...>) const
+    -> const_reference
+  {
+    return const_reference(get<Indices>(_columns)[index]...);
+  }
+} // namespace anton
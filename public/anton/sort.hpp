@@ -1,10 +1,14 @@
 #pragma once
 
-#include <anton/array.hpp>
+#include <anton/algorithm.hpp>
+#include <anton/allocator.hpp>
 #include <anton/iterators.hpp>
 #include <anton/math/math.hpp>
 #include <anton/memory.hpp>
+#include <anton/pair.hpp>
+#include <anton/slice.hpp>
 #include <anton/swap.hpp>
+#include <anton/type_traits/properties.hpp>
 #include <anton/type_traits/utility.hpp>
 
 namespace anton {
@@ -97,48 +101,543 @@ namespace anton {
       [](value_type const& lhs, value_type const& rhs) { return lhs < rhs; });
   }
 
-  template<typename Random_Access_Iterator, typename Predicate>
-  void quick_sort(Random_Access_Iterator first, Random_Access_Iterator last,
-                  Predicate predicate)
-  {
-    auto const size = last - first;
-    if(size < 2) {
-      return;
+  namespace detail {
+    // Ranges smaller than this are sorted with insertion sort.
+    constexpr i64 sort_insertion_threshold = 24;
+    // Ranges larger than this select the pivot with Tukey's ninther.
+    constexpr i64 sort_ninther_threshold = 128;
+    // The maximal number of moves partial_insertion_sort may do before giving
+    // up.
+    constexpr i64 sort_partial_insertion_limit = 8;
+    // The number of elements scanned in a single block of the branchless
+    // partition. Must fit in u8.
+    constexpr i64 sort_block_size = 64;
+
+    template<typename Random_Access_Iterator, typename Predicate>
+    void heap_sort(Random_Access_Iterator const first,
+                   Random_Access_Iterator const last, Predicate& predicate)
+    {
+      anton::make_heap(first, last, predicate);
+      anton::sort_heap(first, last, predicate);
     }
 
-    if(size < 6) {
-      bubble_sort(first, last, predicate);
-      return;
+    // guarded_insertion_sort
+    // Insertion sort that moves elements through a hole instead of swapping.
+    //
+    template<typename Random_Access_Iterator, typename Predicate>
+    void guarded_insertion_sort(Random_Access_Iterator const first,
+                                Random_Access_Iterator const last,
+                                Predicate& predicate)
+    {
+      using value_type =
+        typename Iterator_Traits<Random_Access_Iterator>::value_type;
+      if(first == last) {
+        return;
+      }
+
+      for(Random_Access_Iterator i = first + 1; i != last; ++i) {
+        Random_Access_Iterator hole = i;
+        Random_Access_Iterator prev = i - 1;
+        if(predicate(*hole, *prev)) {
+          value_type value = ANTON_MOV(*hole);
+          do {
+            *hole = ANTON_MOV(*prev);
+            --hole;
+          } while(hole != first && predicate(value, *--prev));
+          *hole = ANTON_MOV(value);
+        }
+      }
     }
 
-    Random_Access_Iterator pivot = first + size / 2;
-    Random_Access_Iterator i = first;
-    Random_Access_Iterator j = last - 1;
-    while(true) {
-      while(predicate(*i, *pivot)) {
-        ++i;
+    // unguarded_insertion_sort
+    // Insertion sort that requires the element before first to be ordered
+    // before or equal to every element of the range. Omits the bounds check of
+    // the inner loop.
+    //
+    template<typename Random_Access_Iterator, typename Predicate>
+    void unguarded_insertion_sort(Random_Access_Iterator const first,
+                                  Random_Access_Iterator const last,
+                                  Predicate& predicate)
+    {
+      using value_type =
+        typename Iterator_Traits<Random_Access_Iterator>::value_type;
+      if(first == last) {
+        return;
       }
 
-      while(predicate(*pivot, *j)) {
-        --j;
+      for(Random_Access_Iterator i = first + 1; i != last; ++i) {
+        Random_Access_Iterator hole = i;
+        Random_Access_Iterator prev = i - 1;
+        if(predicate(*hole, *prev)) {
+          value_type value = ANTON_MOV(*hole);
+          do {
+            *hole = ANTON_MOV(*prev);
+            --hole;
+          } while(predicate(value, *--prev));
+          *hole = ANTON_MOV(value);
+        }
       }
+    }
+
+    // partial_insertion_sort
+    // Attempts to sort the range with insertion sort. Gives up when more than
+    // sort_partial_insertion_limit moves were made.
+    //
+    // Returns:
+    // true if the range has been sorted.
+    //
+    template<typename Random_Access_Iterator, typename Predicate>
+    bool partial_insertion_sort(Random_Access_Iterator const first,
+                                Random_Access_Iterator const last,
+                                Predicate& predicate)
+    {
+      using value_type =
+        typename Iterator_Traits<Random_Access_Iterator>::value_type;
+      if(first == last) {
+        return true;
+      }
+
+      i64 moves = 0;
+      for(Random_Access_Iterator i = first + 1; i != last; ++i) {
+        Random_Access_Iterator hole = i;
+        Random_Access_Iterator prev = i - 1;
+        if(predicate(*hole, *prev)) {
+          value_type value = ANTON_MOV(*hole);
+          do {
+            *hole = ANTON_MOV(*prev);
+            --hole;
+          } while(hole != first && predicate(value, *--prev));
+          *hole = ANTON_MOV(value);
+          moves += i - hole;
+        }
 
-      if(i < j) {
-        swap(*i, *j);
-        if(i == pivot) {
-          pivot = j;
-        } else if(j == pivot) {
-          pivot = i;
+        if(moves > sort_partial_insertion_limit) {
+          return false;
         }
-        ++i;
-        --j;
+      }
+      return true;
+    }
+
+    template<typename Random_Access_Iterator, typename Predicate>
+    void sort2(Random_Access_Iterator const a, Random_Access_Iterator const b,
+               Predicate& predicate)
+    {
+      if(predicate(*b, *a)) {
+        swap(*a, *b);
+      }
+    }
+
+    template<typename Random_Access_Iterator, typename Predicate>
+    void sort3(Random_Access_Iterator const a, Random_Access_Iterator const b,
+               Random_Access_Iterator const c, Predicate& predicate)
+    {
+      sort2(a, b, predicate);
+      sort2(b, c, predicate);
+      sort2(a, b, predicate);
+    }
+
+    // choose_pivot
+    // Moves the pivot to the first position of the range. Uses median of 3 for
+    // small ranges and Tukey's ninther for large ones. The range must have at
+    // least 3 elements.
+    //
+    template<typename Random_Access_Iterator, typename Predicate>
+    void choose_pivot(Random_Access_Iterator const first,
+                      Random_Access_Iterator const last, Predicate& predicate)
+    {
+      i64 const size = last - first;
+      i64 const half = size / 2;
+      if(size > sort_ninther_threshold) {
+        sort3(first, first + half, last - 1, predicate);
+        sort3(first + 1, first + (half - 1), last - 2, predicate);
+        sort3(first + 2, first + (half + 1), last - 3, predicate);
+        sort3(first + (half - 1), first + half, first + (half + 1), predicate);
+        swap(*first, *(first + half));
       } else {
-        break;
+        sort3(first + half, first, last - 1, predicate);
+      }
+    }
+
+    // partition_right
+    // Partitions the range around the pivot *first. Elements equal to the
+    // pivot are placed in the right partition. Requires an element ordered
+    // after or equal to the pivot to exist in the range or after it.
+    //
+    // Returns:
+    // The position of the pivot and whether the range was already partitioned.
+    //
+    template<typename Random_Access_Iterator, typename Predicate>
+    Pair<Random_Access_Iterator, bool>
+    partition_right(Random_Access_Iterator const begin,
+                    Random_Access_Iterator const end, Predicate& predicate)
+    {
+      using value_type =
+        typename Iterator_Traits<Random_Access_Iterator>::value_type;
+      value_type pivot = ANTON_MOV(*begin);
+      Random_Access_Iterator first = begin;
+      Random_Access_Iterator last = end;
+      // Find the first element ordered after or equal to the pivot. The
+      // median-of-3 guarantees its existence.
+      while(predicate(*++first, pivot)) {}
+
+      // Find the last element ordered before the pivot. If first did not move,
+      // there is no guard element and we have to check the bounds.
+      if(first - 1 == begin) {
+        while(first < last && !predicate(*--last, pivot)) {}
+      } else {
+        while(!predicate(*--last, pivot)) {}
+      }
+
+      bool const already_partitioned = first >= last;
+      while(first < last) {
+        swap(*first, *last);
+        while(predicate(*++first, pivot)) {}
+        while(!predicate(*--last, pivot)) {}
+      }
+
+      Random_Access_Iterator const pivot_position = first - 1;
+      *begin = ANTON_MOV(*pivot_position);
+      *pivot_position = ANTON_MOV(pivot);
+      return {pivot_position, already_partitioned};
+    }
+
+    template<typename Random_Access_Iterator>
+    void swap_offsets(Random_Access_Iterator const first,
+                      Random_Access_Iterator const last,
+                      u8 const* const offsets_l, u8 const* const offsets_r,
+                      i64 const count, bool const use_swaps)
+    {
+      using value_type =
+        typename Iterator_Traits<Random_Access_Iterator>::value_type;
+      if(use_swaps) {
+        // Both blocks have the same number of elements. Swapping is required
+        // to preserve the invariant of the partition.
+        for(i64 i = 0; i < count; ++i) {
+          swap(*(first + offsets_l[i]), *(last - offsets_r[i]));
+        }
+      } else if(count > 0) {
+        // Rotate the elements through a cycle which needs fewer moves than
+        // the swaps.
+        Random_Access_Iterator l = first + offsets_l[0];
+        Random_Access_Iterator r = last - offsets_r[0];
+        value_type tmp = ANTON_MOV(*l);
+        *l = ANTON_MOV(*r);
+        for(i64 i = 1; i < count; ++i) {
+          l = first + offsets_l[i];
+          *r = ANTON_MOV(*l);
+          r = last - offsets_r[i];
+          *l = ANTON_MOV(*r);
+        }
+        *r = ANTON_MOV(tmp);
       }
     }
 
-    quick_sort(first, j + 1, predicate);
-    quick_sort(j + 1, last, predicate);
+    // partition_blocks
+    // Moves the elements for which is_left returns true before the others
+    // using the block partitioning from "BlockQuicksort: How Branch
+    // Mispredictions don't affect Quicksort" by Edelkamp and Weiß. The
+    // comparisons record the offsets of misplaced elements in small buffers
+    // without branching and the elements are swapped in bulk afterwards.
+    //
+    // Returns:
+    // The partition point, i.e. the first element for which is_left returned
+    // false or last if there is no such element.
+    //
+    template<typename Random_Access_Iterator, typename Unary_Predicate>
+    Random_Access_Iterator partition_blocks(Random_Access_Iterator first,
+                                            Random_Access_Iterator last,
+                                            Unary_Predicate& is_left)
+    {
+      alignas(64) u8 offsets_l[sort_block_size];
+      alignas(64) u8 offsets_r[sort_block_size];
+      Random_Access_Iterator offsets_l_base = first;
+      Random_Access_Iterator offsets_r_base = last;
+      i64 count_l = 0;
+      i64 count_r = 0;
+      i64 start_l = 0;
+      i64 start_r = 0;
+      while(first < last) {
+        // Fill the empty offset buffers. If both are empty, split the
+        // remaining elements between them.
+        i64 const unknown = last - first;
+        i64 const split_l =
+          count_l == 0 ? (count_r == 0 ? unknown / 2 : unknown) : 0;
+        i64 const split_r = count_r == 0 ? (unknown - split_l) : 0;
+        i64 const block_l = math::min(split_l, sort_block_size);
+        i64 const block_r = math::min(split_r, sort_block_size);
+        for(i64 i = 0; i < block_l; ++i) {
+          offsets_l[count_l] = static_cast<u8>(i);
+          count_l += !is_left(*first);
+          ++first;
+        }
+
+        for(i64 i = 0; i < block_r;) {
+          ++i;
+          offsets_r[count_r] = static_cast<u8>(i);
+          count_r += is_left(*--last);
+        }
+
+        i64 const count = math::min(count_l, count_r);
+        swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l,
+                     offsets_r + start_r, count, count_l == count_r);
+        count_l -= count;
+        count_r -= count;
+        start_l += count;
+        start_r += count;
+        if(count_l == 0) {
+          start_l = 0;
+          offsets_l_base = first;
+        }
+
+        if(count_r == 0) {
+          start_r = 0;
+          offsets_r_base = last;
+        }
+      }
+
+      // All elements have been classified. Move the remaining misplaced
+      // elements to the boundary.
+      if(count_l > 0) {
+        while(count_l > 0) {
+          --count_l;
+          swap(*(offsets_l_base + offsets_l[start_l + count_l]), *--last);
+        }
+        first = last;
+      }
+
+      if(count_r > 0) {
+        while(count_r > 0) {
+          --count_r;
+          swap(*(offsets_r_base - offsets_r[start_r + count_r]), *first);
+          ++first;
+        }
+      }
+
+      return first;
+    }
+
+    // partition_right_branchless
+    // Same as partition_right, but partitions the elements with
+    // partition_blocks.
+    //
+    template<typename Random_Access_Iterator, typename Predicate>
+    Pair<Random_Access_Iterator, bool>
+    partition_right_branchless(Random_Access_Iterator const begin,
+                               Random_Access_Iterator const end,
+                               Predicate& predicate)
+    {
+      using value_type =
+        typename Iterator_Traits<Random_Access_Iterator>::value_type;
+      value_type pivot = ANTON_MOV(*begin);
+      Random_Access_Iterator first = begin;
+      Random_Access_Iterator last = end;
+      while(predicate(*++first, pivot)) {}
+
+      if(first - 1 == begin) {
+        while(first < last && !predicate(*--last, pivot)) {}
+      } else {
+        while(!predicate(*--last, pivot)) {}
+      }
+
+      bool const already_partitioned = first >= last;
+      if(!already_partitioned) {
+        // Keep the invariant that [begin, first) are ordered before the pivot
+        // and [last, end) are not.
+        swap(*first, *last);
+        ++first;
+        auto is_left = [&pivot, &predicate](value_type const& value) {
+          return predicate(value, pivot);
+        };
+        first = partition_blocks(first, last, is_left);
+      }
+
+      Random_Access_Iterator const pivot_position = first - 1;
+      *begin = ANTON_MOV(*pivot_position);
+      *pivot_position = ANTON_MOV(pivot);
+      return {pivot_position, already_partitioned};
+    }
+
+    // partition_left
+    // Partitions the range around the pivot *first. Elements equal to the
+    // pivot are placed in the left partition. Used when the pivot is equal to
+    // the element preceding the range, in which case the left partition
+    // consists only of elements equal to the pivot and needs no further
+    // sorting.
+    //
+    // Returns:
+    // The position of the pivot.
+    //
+    template<typename Random_Access_Iterator, typename Predicate>
+    Random_Access_Iterator partition_left(Random_Access_Iterator const begin,
+                                          Random_Access_Iterator const end,
+                                          Predicate& predicate)
+    {
+      using value_type =
+        typename Iterator_Traits<Random_Access_Iterator>::value_type;
+      value_type pivot = ANTON_MOV(*begin);
+      Random_Access_Iterator first = begin;
+      Random_Access_Iterator last = end;
+      while(predicate(pivot, *--last)) {}
+
+      if(last + 1 == end) {
+        while(first < last && !predicate(pivot, *++first)) {}
+      } else {
+        while(!predicate(pivot, *++first)) {}
+      }
+
+      while(first < last) {
+        swap(*first, *last);
+        while(predicate(pivot, *--last)) {}
+        while(!predicate(pivot, *++first)) {}
+      }
+
+      Random_Access_Iterator const pivot_position = last;
+      *begin = ANTON_MOV(*pivot_position);
+      *pivot_position = ANTON_MOV(pivot);
+      return pivot_position;
+    }
+
+    // break_patterns
+    // Swaps a few elements of a highly unbalanced partition to break the
+    // patterns that might have caused the imbalance.
+    //
+    template<typename Random_Access_Iterator>
+    void break_patterns(Random_Access_Iterator const first,
+                        Random_Access_Iterator const last)
+    {
+      i64 const size = last - first;
+      if(size < sort_insertion_threshold) {
+        return;
+      }
+
+      i64 const quarter = size / 4;
+      swap(*first, *(first + quarter));
+      swap(*(last - 1), *(last - quarter));
+      if(size > sort_ninther_threshold) {
+        swap(*(first + 1), *(first + (quarter + 1)));
+        swap(*(first + 2), *(first + (quarter + 2)));
+        swap(*(last - 2), *(last - (quarter + 1)));
+        swap(*(last - 3), *(last - (quarter + 2)));
+      }
+    }
+
+    // The branchless partition pays off only when the comparisons are cheap
+    // and unpredictable.
+    template<typename T>
+    constexpr bool use_branchless_partition = is_arithmetic<T> || is_pointer<T>;
+
+    template<typename Random_Access_Iterator, typename Predicate>
+    Pair<Random_Access_Iterator, bool>
+    partition_pivot(Random_Access_Iterator const first,
+                    Random_Access_Iterator const last, Predicate& predicate)
+    {
+      using value_type =
+        typename Iterator_Traits<Random_Access_Iterator>::value_type;
+      if constexpr(use_branchless_partition<value_type>) {
+        return partition_right_branchless(first, last, predicate);
+      } else {
+        return partition_right(first, last, predicate);
+      }
+    }
+
+    template<typename Random_Access_Iterator, typename Predicate>
+    void pdq_sort(Random_Access_Iterator first,
+                  Random_Access_Iterator const last, Predicate& predicate,
+                  i64 bad_allowed, bool leftmost)
+    {
+      while(true) {
+        i64 const size = last - first;
+        if(size < sort_insertion_threshold) {
+          if(leftmost) {
+            guarded_insertion_sort(first, last, predicate);
+          } else {
+            unguarded_insertion_sort(first, last, predicate);
+          }
+          return;
+        }
+
+        choose_pivot(first, last, predicate);
+        // If the pivot is equal to the element preceding the range (the pivot
+        // of the parent partition), every element of the left partition would
+        // be equal to the pivot. Put them there and skip them.
+        if(!leftmost && !predicate(*(first - 1), *first)) {
+          first = partition_left(first, last, predicate) + 1;
+          continue;
+        }
+
+        Pair<Random_Access_Iterator, bool> const partition =
+          partition_pivot(first, last, predicate);
+        Random_Access_Iterator const pivot_position = partition.first;
+        bool const already_partitioned = partition.second;
+        i64 const size_l = pivot_position - first;
+        i64 const size_r = last - (pivot_position + 1);
+        bool const highly_unbalanced = size_l < size / 8 || size_r < size / 8;
+        if(highly_unbalanced) {
+          // Too many bad partitions. Fall back to heap sort to guarantee
+          // O(n log n).
+          bad_allowed -= 1;
+          if(bad_allowed == 0) {
+            heap_sort(first, last, predicate);
+            return;
+          }
+
+          break_patterns(first, pivot_position);
+          break_patterns(pivot_position + 1, last);
+        } else if(already_partitioned &&
+                  partial_insertion_sort(first, pivot_position, predicate) &&
+                  partial_insertion_sort(pivot_position + 1, last,
+                                         predicate)) {
+          // The partition did not move anything and both parts were nearly
+          // sorted.
+          return;
+        }
+
+        // Recurse into the left partition and loop on the right one.
+        pdq_sort(first, pivot_position, predicate, bad_allowed, leftmost);
+        first = pivot_position + 1;
+        leftmost = false;
+      }
+    }
+
+    [[nodiscard]] constexpr i64 sort_log2(i64 value)
+    {
+      i64 result = 0;
+      while(value > 1) {
+        value >>= 1;
+        result += 1;
+      }
+      return result;
+    }
+  } // namespace detail
+
+  // quick_sort
+  // Unstable in-place sort. Pattern-defeating quicksort as described in
+  // "Pattern-defeating Quicksort" by Orson Peters. Selects pivots with median
+  // of 3 or Tukey's ninther, partitions the elements of arithmetic and pointer
+  // types with branchless block partitioning and sorts small ranges with
+  // insertion sort. Falls back to heap sort when too many unbalanced
+  // partitions occur.
+  //
+  // Parameters:
+  // first, last - the range to sort.
+  //   predicate - comparison function. Returns true when the first argument is
+  //               less than (i.e. ordered before) the second argument. The
+  //               function must not modify the objects passed to it.
+  //
+  // Complexity:
+  // O(n log n) comparisons in the worst case. O(n) for sorted, reverse sorted
+  // and equal ranges.
+  //
+  template<typename Random_Access_Iterator, typename Predicate>
+  void quick_sort(Random_Access_Iterator first, Random_Access_Iterator last,
+                  Predicate predicate)
+  {
+    i64 const size = last - first;
+    if(size < 2) {
+      return;
+    }
+
+    detail::pdq_sort(first, last, predicate, detail::sort_log2(size), true);
   }
 
   template<typename Random_Access_Iterator>
@@ -151,119 +650,521 @@ namespace anton {
     });
   }
 
+  namespace detail {
+    // The length of the runs sorted with insertion sort before merging.
+    constexpr i64 merge_sort_run_length = 16;
+
+    // merge_sort_put
+    // Writes value to destination. If Construct is true, destination is
+    // uninitialized memory and the object is constructed in place.
+    //
+    template<bool Construct, typename Iterator, typename T>
+    void merge_sort_put(Iterator const destination, T&& value)
+    {
+      if constexpr(Construct) {
+        construct(ANTON_ADDRESSOF(*destination), ANTON_FWD(value));
+      } else {
+        *destination = ANTON_FWD(value);
+      }
+    }
+
+    // merge_sort_runs_into
+    // Sorts the runs of source with insertion sort writing the result to
+    // destination.
+    //
+    template<bool Construct, typename Source, typename Destination,
+             typename Predicate>
+    void merge_sort_runs_into(Source const source,
+                              Destination const destination, i64 const length,
+                              Predicate& predicate)
+    {
+      for(i64 begin = 0; begin < length; begin += merge_sort_run_length) {
+        i64 const end = math::min(begin + merge_sort_run_length, length);
+        for(i64 k = begin; k < end; ++k) {
+          // [begin, k) of destination is sorted.
+          auto&& value = *(source + k);
+          i64 j = k;
+          if(j > begin && predicate(value, *(destination + (j - 1)))) {
+            merge_sort_put<Construct>(destination + j,
+                                      ANTON_MOV(*(destination + (j - 1))));
+            j -= 1;
+            while(j > begin && predicate(value, *(destination + (j - 1)))) {
+              *(destination + j) = ANTON_MOV(*(destination + (j - 1)));
+              j -= 1;
+            }
+            *(destination + j) = ANTON_MOV(value);
+          } else {
+            merge_sort_put<Construct>(destination + j, ANTON_MOV(value));
+          }
+        }
+      }
+    }
+
+    // merge_sort_pass
+    // Merges the pairs of adjacent width-long runs of source into destination.
+    //
+    template<bool Construct, typename Source, typename Destination,
+             typename Predicate>
+    void merge_sort_pass(Source const source, Destination const destination,
+                         i64 const length, i64 const width,
+                         Predicate& predicate)
+    {
+      i64 i = 0;
+      for(; i + width < length; i += 2 * width) {
+        Source left = source + i;
+        Source right = source + (i + width);
+        Source const end_l = right;
+        Source const end_r = source + math::min(i + 2 * width, length);
+        Destination out = destination + i;
+        for(; left != end_l && right != end_r; ++out) {
+          if(!predicate(*right, *left)) {
+            merge_sort_put<Construct>(out, ANTON_MOV(*left));
+            ++left;
+          } else {
+            merge_sort_put<Construct>(out, ANTON_MOV(*right));
+            ++right;
+          }
+        }
+
+        for(; left != end_l; ++left, ++out) {
+          merge_sort_put<Construct>(out, ANTON_MOV(*left));
+        }
+
+        for(; right != end_r; ++right, ++out) {
+          merge_sort_put<Construct>(out, ANTON_MOV(*right));
+        }
+      }
+
+      // There are leftover sorted elements that have no pair.
+      for(; i < length; ++i) {
+        merge_sort_put<Construct>(destination + i, ANTON_MOV(*(source + i)));
+      }
+    }
+
+    template<typename Random_Access_Iterator, typename Predicate>
+    void guarded_insertion_sort_runs(Random_Access_Iterator const first,
+                                     i64 const length, Predicate& predicate)
+    {
+      for(i64 begin = 0; begin < length; begin += merge_sort_run_length) {
+        i64 const end = math::min(begin + merge_sort_run_length, length);
+        guarded_insertion_sort(first + begin, first + end, predicate);
+      }
+    }
+
+    // merge_sort_buffered
+    // Bottom-up merge sort that ping-pongs between the range and the buffer.
+    // The parity of the number of merge passes decides whether the runs are
+    // sorted in place or into the buffer, so that the last pass always writes
+    // to the range and no copy back is needed.
+    //
+    // If Constructed is false, buffer is uninitialized memory. The first pass
+    // writing to the buffer constructs the elements and the buffer is
+    // destroyed at the end.
+    //
+    template<bool Constructed, typename Random_Access_Iterator, typename T,
+             typename Predicate>
+    void merge_sort_buffered(Random_Access_Iterator const first,
+                             i64 const length, T* const buffer,
+                             Predicate& predicate)
+    {
+      i64 pass_count = 0;
+      for(i64 width = merge_sort_run_length; width < length; width *= 2) {
+        pass_count += 1;
+      }
+
+      bool in_buffer = pass_count % 2 == 1;
+      if(in_buffer) {
+        merge_sort_runs_into<!Constructed>(first, buffer, length, predicate);
+      } else {
+        guarded_insertion_sort_runs(first, length, predicate);
+      }
+
+      // Whether the buffer holds constructed objects.
+      bool constructed = Constructed || in_buffer;
+      for(i64 width = merge_sort_run_length; width < length; width *= 2) {
+        if(in_buffer) {
+          merge_sort_pass<false>(buffer, first, length, width, predicate);
+        } else if(constructed) {
+          merge_sort_pass<false>(first, buffer, length, width, predicate);
+        } else {
+          merge_sort_pass<true>(first, buffer, length, width, predicate);
+          constructed = true;
+        }
+        in_buffer = !in_buffer;
+      }
+
+      if constexpr(!Constructed) {
+        if(constructed) {
+          destruct_n(buffer, length);
+        }
+      }
+    }
+
+    // merge_in_place
+    // Stable merge of the adjacent sorted ranges [first, middle) and
+    // [middle, last) without additional memory. Splits the longer range in
+    // halves, finds the corresponding split of the other range with a binary
+    // search and rotates the middle parts into place.
+    //
+    // Complexity:
+    // O(n log n) moves.
+    //
+    template<typename Random_Access_Iterator, typename Predicate>
+    void merge_in_place(Random_Access_Iterator first,
+                        Random_Access_Iterator middle,
+                        Random_Access_Iterator last, Predicate& predicate)
+    {
+      while(true) {
+        i64 const length_l = middle - first;
+        i64 const length_r = last - middle;
+        if(length_l == 0 || length_r == 0) {
+          return;
+        }
+
+        if(length_l + length_r == 2) {
+          if(predicate(*middle, *first)) {
+            swap(*first, *middle);
+          }
+          return;
+        }
+
+        Random_Access_Iterator cut_l;
+        Random_Access_Iterator cut_r;
+        if(length_l > length_r) {
+          cut_l = first + length_l / 2;
+          cut_r = lower_bound_n(middle, length_r, *cut_l, predicate);
+        } else {
+          cut_r = middle + length_r / 2;
+          cut_l = upper_bound_n(first, length_l, *cut_r, predicate);
+        }
+
+        // rotate_left requires both rotated parts to be non-empty.
+        Random_Access_Iterator new_middle;
+        if(cut_l == middle) {
+          new_middle = cut_r;
+        } else if(middle == cut_r) {
+          new_middle = cut_l;
+        } else {
+          new_middle = rotate_left(cut_l, middle, cut_r);
+        }
+        // Recurse into the smaller part and loop on the larger one to bound
+        // the depth of the recursion.
+        if((cut_l - first) + (new_middle - cut_l) <
+           (cut_r - new_middle) + (last - cut_r)) {
+          merge_in_place(first, cut_l, new_middle, predicate);
+          first = new_middle;
+          middle = cut_r;
+        } else {
+          merge_in_place(new_middle, cut_r, last, predicate);
+          middle = cut_l;
+          last = new_middle;
+        }
+      }
+    }
+
+    template<typename Random_Access_Iterator, typename Predicate>
+    void merge_sort_in_place(Random_Access_Iterator const first,
+                             i64 const length, Predicate& predicate)
+    {
+      guarded_insertion_sort_runs(first, length, predicate);
+      for(i64 width = merge_sort_run_length; width < length; width *= 2) {
+        for(i64 i = 0; i + width < length; i += 2 * width) {
+          merge_in_place(first + i, first + (i + width),
+                         first + math::min(i + 2 * width, length), predicate);
+        }
+      }
+    }
+  } // namespace detail
+
+  // merge_sort
+  // Stable sort using a caller-supplied scratch buffer. Does not allocate. If
+  // buffer is smaller than last - first, falls back to an in-place merge sort.
+  //
+  // Parameters:
+  // first, last - the range to sort.
+  //      buffer - scratch buffer of initialized elements. Its contents are
+  //               unspecified after the sort.
+  //   predicate - comparison function. Returns true when the first argument is
+  //               less than (i.e. ordered before) the second argument. The
+  //               function must not modify the objects passed to it.
+  //
+  // Complexity:
+  // O(n log n) if buffer holds at least last - first elements. Otherwise
+  // O(n log^2 n), since the in-place fallback merges by rotations.
+  //
+  template<typename Random_Access_Iterator, typename Predicate>
+  void merge_sort(
+    Random_Access_Iterator first, Random_Access_Iterator last,
+    Slice<typename Iterator_Traits<Random_Access_Iterator>::value_type> buffer,
+    Predicate predicate)
+  {
+    i64 const length = last - first;
+    if(length < 2) {
+      return;
+    }
+
+    if(buffer.size() >= length) {
+      detail::merge_sort_buffered<true>(first, length, buffer.data(),
+                                        predicate);
+    } else {
+      detail::merge_sort_in_place(first, length, predicate);
+    }
+  }
+
   // merge_sort
-  // Stable non-in-place sort. Allocates additional memory proportional to
-  // last - first.
+  // Stable sort allocating the scratch buffer from allocator. If allocator is
+  // nullptr or the allocation fails, falls back to an in-place merge sort.
   //
   // Parameters:
   // first, last - the range to sort.
-  // predicate   - comparison function. Returns true when the first argument is
+  //   allocator - the allocator to allocate the scratch buffer from. May be
+  //               nullptr.
+  //   predicate - comparison function. Returns true when the first argument is
   //               less than (i.e. ordered before) the second argument. The
   //               function must not modify the objects passed to it.
   //
+  // Complexity:
+  // O(n log n) if the scratch buffer is allocated. O(n log^2 n) if allocator
+  // is nullptr or the allocation fails, since the in-place fallback merges by
+  // rotations.
+  //
   template<typename Random_Access_Iterator, typename Predicate>
   void merge_sort(Random_Access_Iterator first, Random_Access_Iterator last,
-                  Predicate p)
+                  Memory_Allocator* const allocator, Predicate predicate)
   {
+    using value_type =
+      typename Iterator_Traits<Random_Access_Iterator>::value_type;
     i64 const length = last - first;
-    // Sort 4-long runs using bubble sort
-    for(i64 i = 0; i < length; i += 4) {
-      Random_Access_Iterator b = first + i;
-      Random_Access_Iterator e = first + math::min(i + 4, length);
-      bubble_sort(b, e, p);
+    if(length < 2) {
+      return;
     }
 
-    if(length <= 4) {
+    if(length <= detail::merge_sort_run_length) {
+      detail::guarded_insertion_sort(first, last, predicate);
       return;
     }
 
+    i64 const buffer_size = length * static_cast<i64>(sizeof(value_type));
+    value_type* const buffer =
+      allocator != nullptr ? static_cast<value_type*>(allocator->allocate(
+                               buffer_size, alignof(value_type)))
+                           : nullptr;
+    if(buffer != nullptr) {
+      detail::merge_sort_buffered<false>(first, length, buffer, predicate);
+      allocator->deallocate(buffer, buffer_size, alignof(value_type));
+    } else {
+      detail::merge_sort_in_place(first, length, predicate);
+    }
+  }
+
+  // merge_sort
+  // Stable non-in-place sort. Allocates additional memory proportional to
+  // last - first from the default allocator.
+  //
+  // Parameters:
+  // first, last - the range to sort.
+  // predicate   - comparison function. Returns true when the first argument is
+  //               less than (i.e. ordered before) the second argument. The
+  //               function must not modify the objects passed to it.
+  //
+  // Complexity:
+  // O(n log n). O(n log^2 n) if the allocation fails, since the in-place
+  // fallback merges by rotations.
+  //
+  template<typename Random_Access_Iterator, typename Predicate>
+  void merge_sort(Random_Access_Iterator first, Random_Access_Iterator last,
+                  Predicate p)
+  {
+    merge_sort(first, last, get_default_allocator(), p);
+  }
+
+  template<typename Random_Access_Iterator>
+  void merge_sort(Random_Access_Iterator first, Random_Access_Iterator last)
+  {
     using value_type =
       typename Iterator_Traits<Random_Access_Iterator>::value_type;
-    Array<value_type> storage{reserve, length};
-    storage.force_size(length);
-    // TODO: Is there a way to avoid the copy?
-    uninitialized_copy(first, last, storage.begin());
-    auto const storage_begin = storage.begin();
-    auto const storage_end = storage.end();
-    // Direction of elements copying. If true, copy from input range to storage.
-    bool copy_a_to_b = true;
-    // Bottom-top merge sort
-    for(i64 width = 4; width < length; width *= 2) {
-      if(copy_a_to_b) {
-        i64 i = 0;
-        for(; i + width < length; i += 2 * width) {
-          Random_Access_Iterator left = first + i;
-          Random_Access_Iterator right = first + (i + width);
-          Random_Access_Iterator end_l = right;
-          Random_Access_Iterator end_r =
-            first + math::min(i + 2 * width, length);
-          auto out = storage_begin + i;
-          for(; left != end_l && right != end_r; ++out) {
-            bool const greater = p(*right, *left);
-            if(!greater) {
-              *out = ANTON_MOV(*left);
-              ++left;
-            } else {
-              *out = ANTON_MOV(*right);
-              ++right;
-            }
-          }
+    merge_sort(first, last, [](value_type const& lhs, value_type const& rhs) {
+      return lhs < rhs;
+    });
+  }
 
-          anton::move(left, end_l, out);
-          anton::move(right, end_r, out);
-        }
+  // nth_element
+  // Rearranges the range so that the element at nth is the element that
+  // would be there if the range was sorted. All elements before nth are not
+  // ordered after it and all elements after nth are not ordered before it.
+  // Uses introselect: quickselect with the pivot selection and partitioning of
+  // quick_sort that falls back to heap sort of the remaining range when too
+  // many unbalanced partitions occur.
+  //
+  // Parameters:
+  // first, last - the range to rearrange.
+  //         nth - the position to place the element at. If nth is last, the
+  //               function does nothing.
+  //   predicate - comparison function. Returns true when the first argument is
+  //               less than (i.e. ordered before) the second argument. The
+  //               function must not modify the objects passed to it.
+  //
+  // Complexity:
+  // O(n) on average, O(n log n) in the worst case.
+  //
+  template<typename Random_Access_Iterator, typename Predicate>
+  void nth_element(Random_Access_Iterator first, Random_Access_Iterator nth,
+                   Random_Access_Iterator last, Predicate predicate)
+  {
+    if(nth == last) {
+      return;
+    }
 
-        // There are leftover sorted elements. Copy them to the storage buffer
-        if(i < length) {
-          Random_Access_Iterator b = first + i;
-          anton::move(b, last, storage_begin + i);
-        }
-      } else {
-        i64 i = 0;
-        for(; i + width < length; i += 2 * width) {
-          auto left = storage_begin + i;
-          auto right = storage_begin + (i + width);
-          auto end_l = right;
-          auto end_r = storage_begin + math::min(i + 2 * width, length);
-          Random_Access_Iterator out = first + i;
-          for(; left != end_l && right != end_r; ++out) {
-            bool const greater = p(*right, *left);
-            if(!greater) {
-              *out = ANTON_MOV(*left);
-              ++left;
-            } else {
-              *out = ANTON_MOV(*right);
-              ++right;
-            }
-          }
+    i64 bad_allowed = detail::sort_log2(last - first);
+    bool leftmost = true;
+    while(true) {
+      i64 const size = last - first;
+      if(size < detail::sort_insertion_threshold) {
+        detail::guarded_insertion_sort(first, last, predicate);
+        return;
+      }
 
-          anton::move(left, end_l, out);
-          anton::move(right, end_r, out);
+      detail::choose_pivot(first, last, predicate);
+      // Same as in pdq_sort. If the pivot is equal to the element preceding
+      // the range, the elements equal to it are gathered on the left. They
+      // are all in their final positions.
+      if(!leftmost && !predicate(*(first - 1), *first)) {
+        Random_Access_Iterator const pivot_position =
+          detail::partition_left(first, last, predicate);
+        if(nth <= pivot_position) {
+          return;
         }
 
-        // There are leftover sorted elements. Copy them to the storage buffer
-        if(i < length) {
-          Random_Access_Iterator out = first + i;
-          anton::move(storage_begin + i, storage_end, out);
+        first = pivot_position + 1;
+        continue;
+      }
+
+      Random_Access_Iterator const pivot_position =
+        detail::partition_pivot(first, last, predicate).first;
+      if(pivot_position == nth) {
+        return;
+      }
+
+      i64 const size_l = pivot_position - first;
+      i64 const size_r = last - (pivot_position + 1);
+      if(size_l < size / 8 || size_r < size / 8) {
+        bad_allowed -= 1;
+        if(bad_allowed == 0) {
+          detail::heap_sort(first, last, predicate);
+          return;
         }
+
+        detail::break_patterns(first, pivot_position);
+        detail::break_patterns(pivot_position + 1, last);
       }
 
-      copy_a_to_b = !copy_a_to_b;
+      if(nth < pivot_position) {
+        last = pivot_position;
+      } else {
+        first = pivot_position + 1;
+        leftmost = false;
+      }
     }
+  }
 
-    // Copy elements back into the input range
-    if(!copy_a_to_b) {
-      anton::move(storage_begin, storage_end, first);
+  template<typename Random_Access_Iterator>
+  void nth_element(Random_Access_Iterator first, Random_Access_Iterator nth,
+                   Random_Access_Iterator last)
+  {
+    using value_type =
+      typename Iterator_Traits<Random_Access_Iterator>::value_type;
+    anton::nth_element(
+      first, nth, last,
+      [](value_type const& lhs, value_type const& rhs) { return lhs < rhs; });
+  }
+
+  // partial_sort
+  // Rearranges the range so that [first, middle) contains the middle - first
+  // smallest elements in sorted order. The order of the remaining elements is
+  // unspecified. Selects the elements with nth_element and sorts them with
+  // quick_sort. Unstable.
+  //
+  // Parameters:
+  // first, last - the range to rearrange.
+  //      middle - the end of the sorted prefix.
+  //   predicate - comparison function. Returns true when the first argument is
+  //               less than (i.e. ordered before) the second argument. The
+  //               function must not modify the objects passed to it.
+  //
+  // Complexity:
+  // O(n + k log k) on average where k is middle - first.
+  //
+  template<typename Random_Access_Iterator, typename Predicate>
+  void partial_sort(Random_Access_Iterator first, Random_Access_Iterator middle,
+                    Random_Access_Iterator last, Predicate predicate)
+  {
+    if(first == middle) {
+      return;
     }
+
+    if(middle != last) {
+      anton::nth_element(first, middle - 1, last, predicate);
+    }
+    quick_sort(first, middle, predicate);
   }
 
   template<typename Random_Access_Iterator>
-  void merge_sort(Random_Access_Iterator first, Random_Access_Iterator last)
+  void partial_sort(Random_Access_Iterator first, Random_Access_Iterator middle,
+                    Random_Access_Iterator last)
   {
     using value_type =
       typename Iterator_Traits<Random_Access_Iterator>::value_type;
-    merge_sort(first, last, [](value_type const& lhs, value_type const& rhs) {
-      return lhs < rhs;
-    });
+    anton::partial_sort(
+      first, middle, last,
+      [](value_type const& lhs, value_type const& rhs) { return lhs < rhs; });
+  }
+
+  // top_k
+  // Selects the k smallest elements of the range in a single pass and writes
+  // them in sorted order to out. Keeps the selected elements in a max-heap in
+  // the output range so that every element of the input is compared against
+  // the largest selected element first. Suitable for streams that do not fit
+  // in memory since the input is visited only once.
+  //
+  // Parameters:
+  // first, last - the range to select from. Visited once.
+  //           k - the number of elements to select.
+  //   predicate - comparison function. Returns true when the first argument is
+  //               less than (i.e. ordered before) the second argument. The
+  //               function must not modify the objects passed to it.
+  //         out - the beginning of the output range. Must have space for at
+  //               least k initialized elements.
+  //
+  // Returns:
+  // The end of the output range, i.e. out + min(k, last - first).
+  //
+  // Complexity:
+  // O(n log k) comparisons.
+  //
+  template<typename Input_Iterator, typename Predicate,
+           typename Random_Access_Iterator>
+  Random_Access_Iterator top_k(Input_Iterator first, Input_Iterator last,
+                               i64 const k, Predicate predicate,
+                               Random_Access_Iterator out)
+  {
+    if(k <= 0) {
+      return out;
+    }
+
+    i64 size = 0;
+    for(; first != last && size < k; ++first, ++size) {
+      *(out + size) = *first;
+    }
+
+    anton::make_heap(out, out + size, predicate);
+    for(; first != last; ++first) {
+      if(predicate(*first, *out)) {
+        *out = *first;
+        detail::heap_sift_down<2>(out, 0, size, predicate);
+      }
+    }
+
+    anton::sort_heap(out, out + size, predicate);
+    return out + size;
   }
 } // namespace anton
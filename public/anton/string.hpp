@@ -3,6 +3,7 @@
 #include "anton/type_traits/base.hpp"
 #include "anton/type_traits/properties.hpp"
 #include <anton/allocator.hpp>
+#include <anton/detail/string_storage.hpp>
 #include <anton/functors.hpp>
 #include <anton/iterators.hpp>
 #include <anton/slice.hpp>
@@ -17,11 +18,12 @@ namespace anton {
   // bytes and chars. Both return proxy classes which have begin/end functions
   // that return iterators over bytes and code points respectively.
   //
+  // Strings shorter than 23 bytes are stored inline and do not allocate.
+  //
   // Notes:
   // operator[] is not implemented because UTF-8 doesn't allow us to index in
   // constant-time.
   //
-  // TODO: SSO
   // TODO: Grapheme Clusters
   //
   struct String {
@@ -129,7 +131,8 @@ namespace anton {
     // Size of the string in bytes.
     [[nodiscard]] size_type size_bytes() const;
     // Counts the number of Unicode code points.
-    // This is a linear-time operation.
+    // This is a linear-time operation vectorized on x86. Use UTF8_Index to
+    // repeatedly index long strings by code points.
     [[nodiscard]] size_type size_utf8() const;
 
     // ensure_capacity
@@ -163,9 +166,7 @@ namespace anton {
 
   private:
     allocator_type _allocator;
-    value_type* _data = nullptr;
-    size_type _capacity = 0;
-    size_type _size = 0;
+    detail::String_Storage _storage;
   };
 
   inline namespace literals {
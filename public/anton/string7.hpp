@@ -1,6 +1,7 @@
 #pragma once
 
 #include <anton/allocator.hpp>
+#include <anton/detail/string_storage.hpp>
 #include <anton/functors.hpp>
 #include <anton/iterators.hpp>
 #include <anton/string7_view.hpp>
@@ -10,6 +11,8 @@ namespace anton {
   // String7
   // UTF-8 encoded string containing only the ASCII subset.
   //
+  // Strings shorter than 23 bytes are stored inline and do not allocate.
+  //
   struct String7 {
   public:
     using value_type = char8;
@@ -114,9 +117,7 @@ namespace anton {
 
   private:
     allocator_type _allocator;
-    value_type* _data = nullptr;
-    size_type _capacity = 0;
-    size_type _size = 0;
+    detail::String_Storage _storage;
   };
 
   inline namespace literals {
@@ -2,11 +2,13 @@
 
 #include <anton/assert.hpp>
 #include <anton/detail/string_common.hpp>
+#include <anton/detail/string_search.hpp>
 #include <anton/hashing/murmurhash2.hpp>
 #include <anton/iterators.hpp>
 #include <anton/math/math.hpp>
 #include <anton/swap.hpp>
 #include <anton/types.hpp>
+#include <anton/unicode/common.hpp>
 
 namespace anton {
   struct String7_View {
@@ -30,7 +32,10 @@ namespace anton {
       }
 
       if constexpr(ANTON_STRING_VIEW_VERIFY_ENCODING) {
-        // TODO: Implement
+        if(!ANTON_IS_CONSTANT_EVALUATED()) {
+          ANTON_FAIL(unicode::validate_ascii(_begin, _end - _begin),
+                     u8"string is not valid ASCII");
+        }
       }
     }
 
@@ -38,7 +43,10 @@ namespace anton {
       : _begin(str), _end(str + size)
     {
       if constexpr(ANTON_STRING_VIEW_VERIFY_ENCODING) {
-        // TODO: Implement
+        if(!ANTON_IS_CONSTANT_EVALUATED()) {
+          ANTON_FAIL(unicode::validate_ascii(_begin, _end - _begin),
+                     u8"string is not valid ASCII");
+        }
       }
     }
 
@@ -46,7 +54,10 @@ namespace anton {
       : _begin(first), _end(last)
     {
       if constexpr(ANTON_STRING_VIEW_VERIFY_ENCODING) {
-        // TODO: Implement
+        if(!ANTON_IS_CONSTANT_EVALUATED()) {
+          ANTON_FAIL(unicode::validate_ascii(_begin, _end - _begin),
+                     u8"string is not valid ASCII");
+        }
       }
     }
 
@@ -164,10 +175,19 @@ namespace anton {
   // The start position of the substring within string or npos if the substring
   // is not present.
   //
+  // Complexity:
+  // At runtime linear in the size of string and vectorized. Use Searcher to
+  // look for the same substring in many strings.
+  //
   [[nodiscard]] constexpr i64 find_substring(String7_View const string,
                                              String7_View const substr)
   {
-    // Bruteforce
+    if(!ANTON_IS_CONSTANT_EVALUATED()) {
+      return detail::find_substring_bytes(string.data(), string.size(),
+                                          substr.data(), substr.size());
+    }
+
+    // Bruteforce in constant evaluation.
     char8 const* const string_data = string.data();
     char8 const* const substr_data = substr.data();
     for(i64 i = 0, end = string.size() - substr.size(); i <= end; ++i) {
@@ -194,10 +214,18 @@ namespace anton {
   // The start position of the substring within string or npos if the substring
   // is not present.
   //
+  // Complexity:
+  // At runtime linear in the size of string and vectorized.
+  //
   [[nodiscard]] constexpr i64 find_last_substring(String7_View const string,
                                                   String7_View const substr)
   {
-    // Bruteforce
+    if(!ANTON_IS_CONSTANT_EVALUATED()) {
+      return detail::find_last_substring_bytes(string.data(), string.size(),
+                                               substr.data(), substr.size());
+    }
+
+    // Bruteforce in constant evaluation.
     char8 const* const string_data = string.data();
     char8 const* const substr_data = substr.data();
     for(i64 i = string.size() - substr.size(); i >= 0; --i) {
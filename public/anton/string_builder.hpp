@@ -0,0 +1,147 @@
+#pragma once
+
+#include <anton/allocator.hpp>
+#include <anton/format.hpp>
+#include <anton/iterators/base.hpp>
+#include <anton/ranges.hpp>
+#include <anton/stream.hpp>
+#include <anton/string.hpp>
+#include <anton/string_view.hpp>
+#include <anton/type_traits/utility.hpp>
+#include <anton/types.hpp>
+
+namespace anton {
+  namespace detail {
+    struct String_Builder_Chunk;
+  } // namespace detail
+
+  // String_Builder_Chunk_Iterator
+  // Iterates the chunks of a String_Builder in order. The default
+  // constructed iterator is the end iterator.
+  //
+  struct String_Builder_Chunk_Iterator {
+  public:
+    using value_type = String_View;
+    using difference_type = isize;
+    using iterator_category = Forward_Iterator_Tag;
+
+    String_Builder_Chunk_Iterator() = default;
+    explicit String_Builder_Chunk_Iterator(
+      detail::String_Builder_Chunk const* chunk);
+
+    String_Builder_Chunk_Iterator& operator++();
+    String_Builder_Chunk_Iterator operator++(int);
+
+    [[nodiscard]] value_type operator*() const;
+
+    [[nodiscard]] bool
+    operator==(String_Builder_Chunk_Iterator const& other) const
+    {
+      return _chunk == other._chunk;
+    }
+
+    [[nodiscard]] bool
+    operator!=(String_Builder_Chunk_Iterator const& other) const
+    {
+      return _chunk != other._chunk;
+    }
+
+  private:
+    detail::String_Builder_Chunk const* _chunk = nullptr;
+  };
+
+  // String_Builder
+  // Builds a string from many small pieces. The pieces are appended to a list
+  // of chunks whose capacity grows geometrically up to max_chunk_size, thus
+  // the appended bytes are never moved or reallocated. The result is copied
+  // once into a String by to_string or written chunk by chunk to a stream by
+  // write_to.
+  //
+  // The chunks are allocated with the allocator of the builder. A builder
+  // constructed with an Arena_Allocator allocates its chunks from the arena.
+  //
+  struct String_Builder {
+  public:
+    using allocator_type = Polymorphic_Allocator;
+    using size_type = i64;
+
+    // The capacity of the first chunk in bytes.
+    static constexpr i64 min_chunk_size = 256;
+    // The largest capacity the chunks grow to. A single append larger than
+    // max_chunk_size is stored in a chunk of its own size.
+    static constexpr i64 max_chunk_size = 65536;
+
+    String_Builder();
+    explicit String_Builder(allocator_type const& allocator);
+    String_Builder(String_Builder const&) = delete;
+    String_Builder(String_Builder&& other);
+    ~String_Builder();
+    String_Builder& operator=(String_Builder const&) = delete;
+    String_Builder& operator=(String_Builder&& other);
+
+    [[nodiscard]] allocator_type& get_allocator();
+    [[nodiscard]] allocator_type const& get_allocator() const;
+
+    // size_bytes
+    // The number of bytes appended since construction or the last clear.
+    //
+    [[nodiscard]] size_type size_bytes() const;
+
+    // append
+    //
+    // Complexity: O(n) in the size of string.
+    //
+    void append(String_View string);
+    void append(char8 c);
+    void append(char32 c);
+
+    // append_format
+    // Formats the arguments as anton::format would and appends the result.
+    // The formatted text is written to the chunks directly.
+    //
+    template<typename... Args>
+    void append_format(String_View const format_string, Args&&... args)
+    {
+      Format_Buffer buffer(*this);
+      format_to(_allocator.get_wrapped_allocator(), buffer, format_string,
+                ANTON_FWD(args)...);
+    }
+
+    // clear
+    // Removes all text and releases the chunks.
+    //
+    void clear();
+
+    // chunks
+    // The chunks may be passed to a scatter-gather write of the platform.
+    //
+    // Returns:
+    // The appended text divided into chunks in order. The chunks are never
+    // empty.
+    //
+    [[nodiscard]] Range<String_Builder_Chunk_Iterator> chunks() const;
+
+    // to_string
+    // Copies the text into a String allocated with the allocator of the
+    // builder.
+    //
+    // Complexity: O(n) in the size of the text. Allocates once.
+    //
+    [[nodiscard]] String to_string() const;
+
+    // write_to
+    // Writes the text to stream with one write per chunk.
+    //
+    void write_to(Output_Stream& stream) const;
+
+    friend void swap(String_Builder& lhs, String_Builder& rhs);
+
+  private:
+    allocator_type _allocator;
+    detail::String_Builder_Chunk* _first = nullptr;
+    detail::String_Builder_Chunk* _last = nullptr;
+    i64 _size = 0;
+
+    [[nodiscard]] detail::String_Builder_Chunk* add_chunk(i64 min_capacity);
+  };
+} // namespace anton
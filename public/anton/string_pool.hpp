@@ -0,0 +1,226 @@
+#pragma once
+
+#include <anton/allocator.hpp>
+#include <anton/array.hpp>
+#include <anton/atomic.hpp>
+#include <anton/functors.hpp>
+#include <anton/optional.hpp>
+#include <anton/string_view.hpp>
+#include <anton/types.hpp>
+
+namespace anton {
+  namespace detail {
+    // Interned_String_Entry
+    // The header of a string stored in a String_Pool. The null-terminated
+    // bytes of the string follow the header.
+    //
+    struct Interned_String_Entry {
+      u64 hash;
+      i64 size;
+    };
+
+    // The entry of the empty string shared by all pools.
+    extern Interned_String_Entry const* const empty_interned_string;
+  } // namespace detail
+
+  // Interned_String
+  // A handle to a string stored in a String_Pool. Every distinct string is
+  // stored in a pool once, therefore two handles obtained from the same pool
+  // are equal if and only if they refer to the same entry. The hash of the
+  // string is computed when it is interned. The handle remains valid for as
+  // long as the pool exists.
+  //
+  // The default constructed handle refers to the empty string which is
+  // shared by all pools.
+  //
+  struct Interned_String {
+  public:
+    Interned_String(): _entry(detail::empty_interned_string) {}
+
+    // data
+    // The null-terminated bytes of the string.
+    //
+    [[nodiscard]] char8 const* data() const
+    {
+      return reinterpret_cast<char8 const*>(_entry) +
+             sizeof(detail::Interned_String_Entry);
+    }
+
+    [[nodiscard]] i64 size_bytes() const
+    {
+      return _entry->size;
+    }
+
+    // hash
+    // The hash of the string. Equal to anton::hash of the String_View of
+    // the string.
+    //
+    [[nodiscard]] u64 hash() const
+    {
+      return _entry->hash;
+    }
+
+    operator String_View() const
+    {
+      return String_View{data(), _entry->size};
+    }
+
+    // operator==
+    // Compares the entries. Complexity: O(1).
+    //
+    [[nodiscard]] bool operator==(Interned_String const& other) const
+    {
+      return _entry == other._entry;
+    }
+
+    [[nodiscard]] bool operator!=(Interned_String const& other) const
+    {
+      return _entry != other._entry;
+    }
+
+  private:
+    friend struct String_Pool;
+
+    detail::Interned_String_Entry const* _entry;
+
+    explicit Interned_String(detail::Interned_String_Entry const* const entry)
+      : _entry(entry)
+    {
+    }
+  };
+
+  [[nodiscard]] inline u64 hash(Interned_String const string)
+  {
+    return string.hash();
+  }
+
+  template<>
+  struct Default_Hash<Interned_String> {
+    [[nodiscard]] u64 operator()(Interned_String const string) const
+    {
+      return string.hash();
+    }
+  };
+
+  // String_Pool
+  // Deduplicates strings. The strings are copied into arena blocks owned by
+  // the pool and are never moved, hence the handles remain valid when the
+  // pool grows or is moved. Both the table and the arena blocks are
+  // allocated with the allocator of the pool. The pool is not thread-safe, see
+  // Concurrent_String_Pool.
+  //
+  struct String_Pool {
+  public:
+    using allocator_type = Polymorphic_Allocator;
+
+    String_Pool();
+    explicit String_Pool(allocator_type const& allocator);
+    String_Pool(String_Pool const&) = delete;
+    String_Pool(String_Pool&& other);
+    ~String_Pool() = default;
+    String_Pool& operator=(String_Pool const&) = delete;
+    String_Pool& operator=(String_Pool&& other);
+
+    // intern
+    // Stores string in the pool unless an equal string is already stored.
+    //
+    // Returns:
+    // The handle to the stored string.
+    //
+    // Complexity: O(n) in the size of string on average.
+    //
+    [[nodiscard]] Interned_String intern(String_View string);
+
+    // intern
+    // Overload accepting the hash of string.
+    //
+    // Parameters:
+    // string - the string to store.
+    //   hash - anton::hash(string).
+    //
+    [[nodiscard]] Interned_String intern(String_View string, u64 hash);
+
+    // find
+    //
+    // Returns:
+    // The handle to the string equal to string or null_optional if the pool
+    // does not contain such string.
+    //
+    [[nodiscard]] Optional<Interned_String> find(String_View string) const;
+    [[nodiscard]] Optional<Interned_String> find(String_View string,
+                                                 u64 hash) const;
+
+    // size
+    // The number of distinct strings stored in the pool excluding the empty
+    // string.
+    //
+    [[nodiscard]] i64 size() const;
+
+    // owned_memory
+    // The memory occupied by the stored strings and the table in bytes.
+    //
+    [[nodiscard]] i64 owned_memory() const;
+
+    [[nodiscard]] allocator_type& get_allocator();
+    [[nodiscard]] allocator_type const& get_allocator() const;
+
+    friend void swap(String_Pool& lhs, String_Pool& rhs);
+
+  private:
+    // The table of the stored strings with linear probing. The capacity of
+    // the table is a power of 2 and the table is at most half full.
+    Array<detail::Interned_String_Entry const*> _table;
+    Arena_Allocator _arena;
+    i64 _size = 0;
+
+    [[nodiscard]] i64 find_slot(String_View string, u64 hash) const;
+    void grow();
+  };
+
+  // Concurrent_String_Pool
+  // A String_Pool that may be used by multiple threads at once. The strings
+  // are distributed among independently locked shards by their hash, so
+  // threads rarely contend for the same shard.
+  //
+  struct Concurrent_String_Pool {
+  public:
+    static constexpr i64 shard_count = 64;
+
+    Concurrent_String_Pool() = default;
+    Concurrent_String_Pool(Concurrent_String_Pool const&) = delete;
+    Concurrent_String_Pool& operator=(Concurrent_String_Pool const&) = delete;
+    ~Concurrent_String_Pool() = default;
+
+    // intern
+    // Stores string in the pool unless an equal string is already stored.
+    // Thread-safe.
+    //
+    // Returns:
+    // The handle to the stored string.
+    //
+    [[nodiscard]] Interned_String intern(String_View string);
+
+    // find
+    // Thread-safe.
+    //
+    // Returns:
+    // The handle to the string equal to string or null_optional if the pool
+    // does not contain such string.
+    //
+    [[nodiscard]] Optional<Interned_String> find(String_View string);
+
+    // size
+    // The number of distinct strings stored in the pool excluding the empty
+    // string. Thread-safe, but the shards are counted one at a time.
+    //
+    [[nodiscard]] i64 size();
+
+  private:
+    struct alignas(cache_line_size) Shard {
+      Atomic<bool> locked = false;
+      String_Pool pool;
+    };
+
+    Shard _shards[shard_count];
+  };
+} // namespace anton
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <anton/iterators/base.hpp>
+#include <anton/ranges.hpp>
+#include <anton/string_view.hpp>
+#include <anton/types.hpp>
+
+namespace anton {
+  // Split_Iterator
+  // Iterates the pieces of a string separated by a delimiter. The pieces are
+  // views of the string, therefore iterating allocates nothing. The default
+  // constructed iterator is the end iterator.
+  //
+  struct Split_Iterator {
+  public:
+    using value_type = String_View;
+    using difference_type = isize;
+    using iterator_category = Forward_Iterator_Tag;
+
+    Split_Iterator() = default;
+    // Split_Iterator
+    // Points to the first piece of string.
+    //
+    Split_Iterator(String_View string, String_View delimiter);
+
+    Split_Iterator& operator++();
+    Split_Iterator operator++(int);
+
+    [[nodiscard]] value_type operator*() const;
+
+    [[nodiscard]] bool operator==(Split_Iterator const& other) const
+    {
+      return _position == other._position;
+    }
+
+    [[nodiscard]] bool operator!=(Split_Iterator const& other) const
+    {
+      return _position != other._position;
+    }
+
+  private:
+    char8 const* _data = nullptr;
+    i64 _size = 0;
+    char8 const* _delimiter = nullptr;
+    i64 _delimiter_size = 0;
+    // The position of the first byte of the current piece or -1 past the last
+    // piece.
+    i64 _position = -1;
+    // The position of the end of the current piece.
+    i64 _piece_end = 0;
+  };
+
+  // Split_Any_Iterator
+  // Iterates the pieces of a string separated by any of a set of ASCII
+  // delimiters. The default constructed iterator is the end iterator.
+  //
+  struct Split_Any_Iterator {
+  public:
+    using value_type = String_View;
+    using difference_type = isize;
+    using iterator_category = Forward_Iterator_Tag;
+
+    Split_Any_Iterator() = default;
+    // Split_Any_Iterator
+    // Points to the first piece of string.
+    //
+    Split_Any_Iterator(String_View string, String_View delimiters);
+
+    Split_Any_Iterator& operator++();
+    Split_Any_Iterator operator++(int);
+
+    [[nodiscard]] value_type operator*() const;
+
+    [[nodiscard]] bool operator==(Split_Any_Iterator const& other) const
+    {
+      return _position == other._position;
+    }
+
+    [[nodiscard]] bool operator!=(Split_Any_Iterator const& other) const
+    {
+      return _position != other._position;
+    }
+
+  private:
+    char8 const* _data = nullptr;
+    i64 _size = 0;
+    // The delimiters indexed by their low nibble. Bit n of the entry is set
+    // when the delimiter with the high nibble n is in the set.
+    u8 _table[16] = {};
+    i64 _position = -1;
+    i64 _piece_end = 0;
+  };
+
+  // Line_Iterator
+  // Iterates the lines of a string. The lines end with '\n' or "\r\n" which
+  // are not part of the lines. A '\r' that is not followed by '\n' belongs to
+  // the line. The default constructed iterator is the end iterator.
+  //
+  struct Line_Iterator {
+  public:
+    using value_type = String_View;
+    using difference_type = isize;
+    using iterator_category = Forward_Iterator_Tag;
+
+    Line_Iterator() = default;
+    // Line_Iterator
+    // Points to the first line of string.
+    //
+    explicit Line_Iterator(String_View string);
+
+    Line_Iterator& operator++();
+    Line_Iterator operator++(int);
+
+    [[nodiscard]] value_type operator*() const;
+
+    [[nodiscard]] bool operator==(Line_Iterator const& other) const
+    {
+      return _position == other._position;
+    }
+
+    [[nodiscard]] bool operator!=(Line_Iterator const& other) const
+    {
+      return _position != other._position;
+    }
+
+  private:
+    char8 const* _data = nullptr;
+    i64 _size = 0;
+    i64 _position = -1;
+    // The position of the '\n' ending the current line or _size.
+    i64 _piece_end = 0;
+  };
+
+  // split
+  // Splits string at every occurrence of delimiter. n occurrences of the
+  // delimiter produce n + 1 pieces, some of which may be empty. The
+  // occurrences are found with vectorized searches.
+  //
+  // Both string and delimiter must outlive the range.
+  //
+  // Parameters:
+  //    string - the string to split.
+  // delimiter - the delimiter. Must not be empty.
+  //
+  // Returns:
+  // A lazy range of the pieces of string.
+  //
+  [[nodiscard]] Range<Split_Iterator> split(String_View string,
+                                            String_View delimiter);
+
+  // split_any
+  // Splits string at every occurrence of any of the delimiters. Consecutive
+  // delimiters produce empty pieces.
+  //
+  // string must outlive the range.
+  //
+  // Parameters:
+  //     string - the string to split.
+  // delimiters - the set of delimiters. Must consist of ASCII characters.
+  //
+  // Returns:
+  // A lazy range of the pieces of string.
+  //
+  [[nodiscard]] Range<Split_Any_Iterator> split_any(String_View string,
+                                                    String_View delimiters);
+
+  // lines
+  // Splits string into lines. The line terminator of the last line is
+  // optional and an empty string has no lines.
+  //
+  // string must outlive the range.
+  //
+  // Returns:
+  // A lazy range of the lines of string without their line terminators.
+  //
+  [[nodiscard]] Range<Line_Iterator> lines(String_View string);
+} // namespace anton
@@ -3,12 +3,14 @@
 #include <anton/assert.hpp>
 #include <anton/detail/string8_common.hpp>
 #include <anton/detail/string_common.hpp>
+#include <anton/detail/string_search.hpp>
 #include <anton/functors.hpp>
 #include <anton/hashing/murmurhash2.hpp>
 #include <anton/iterators.hpp>
 #include <anton/math/math.hpp>
 #include <anton/swap.hpp>
 #include <anton/types.hpp>
+#include <anton/unicode/common.hpp>
 
 namespace anton {
   struct String_View {
@@ -33,7 +35,10 @@ namespace anton {
       }
 
       if constexpr(ANTON_STRING_VIEW_VERIFY_ENCODING) {
-        // TODO: Implement
+        if(!ANTON_IS_CONSTANT_EVALUATED()) {
+          ANTON_FAIL(unicode::validate_utf8(_begin, _end - _begin),
+                     u8"string is not valid UTF-8");
+        }
       }
     }
 
@@ -41,7 +46,10 @@ namespace anton {
       : _begin(str), _end(str + size)
     {
       if constexpr(ANTON_STRING_VIEW_VERIFY_ENCODING) {
-        // TODO: Implement
+        if(!ANTON_IS_CONSTANT_EVALUATED()) {
+          ANTON_FAIL(unicode::validate_utf8(_begin, _end - _begin),
+                     u8"string is not valid UTF-8");
+        }
       }
     }
 
@@ -49,7 +57,10 @@ namespace anton {
       : _begin(first), _end(last)
     {
       if constexpr(ANTON_STRING_VIEW_VERIFY_ENCODING) {
-        // TODO: Implement
+        if(!ANTON_IS_CONSTANT_EVALUATED()) {
+          ANTON_FAIL(unicode::validate_utf8(_begin, _end - _begin),
+                     u8"string is not valid UTF-8");
+        }
       }
     }
 
@@ -190,10 +201,19 @@ namespace anton {
   // The start position of the substring within string or npos if the substring
   // is not present.
   //
+  // Complexity:
+  // At runtime linear in the size of string and vectorized. Use Searcher to
+  // look for the same substring in many strings.
+  //
   [[nodiscard]] constexpr i64 find_substring(String_View const string,
                                              String_View const substr)
   {
-    // Bruteforce
+    if(!ANTON_IS_CONSTANT_EVALUATED()) {
+      return detail::find_substring_bytes(string.data(), string.size_bytes(),
+                                          substr.data(), substr.size_bytes());
+    }
+
+    // Bruteforce in constant evaluation.
     char8 const* const string_data = string.data();
     char8 const* const substr_data = substr.data();
     for(i64 i = 0, end = string.size_bytes() - substr.size_bytes(); i <= end;
@@ -221,10 +241,18 @@ namespace anton {
   // The start position of the substring within string or npos if the substring
   // is not present.
   //
+  // Complexity:
+  // At runtime linear in the size of string and vectorized.
+  //
   [[nodiscard]] constexpr i64 find_last_substring(String_View const string,
                                                   String_View const substr)
   {
-    // Bruteforce
+    if(!ANTON_IS_CONSTANT_EVALUATED()) {
+      return detail::find_last_substring_bytes(
+        string.data(), string.size_bytes(), substr.data(), substr.size_bytes());
+    }
+
+    // Bruteforce in constant evaluation.
     char8 const* const string_data = string.data();
     char8 const* const substr_data = substr.data();
     for(i64 i = string.size_bytes() - substr.size_bytes(); i >= 0; --i) {
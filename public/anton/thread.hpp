@@ -0,0 +1,57 @@
+#pragma once
+
+#include <anton/atomic.hpp>
+#include <anton/types.hpp>
+
+namespace anton {
+  using Thread_Function = void (*)(void* data);
+
+  // Thread
+  // Handle to a native thread. A thread must be joined with join_thread.
+  //
+  struct Thread {
+    u64 native_handle = 0;
+  };
+
+  // create_thread
+  // Starts a new thread of execution that invokes function with data.
+  //
+  // Returns:
+  // Handle to the created thread.
+  //
+  [[nodiscard]] Thread create_thread(Thread_Function function, void* data);
+
+  // join_thread
+  // Blocks until the thread finishes execution and releases its resources.
+  //
+  void join_thread(Thread thread);
+
+  // yield_thread
+  // Gives up the remainder of the time slice of the calling thread.
+  //
+  void yield_thread();
+
+  // get_hardware_concurrency
+  //
+  // Returns:
+  // The number of logical processors available to the process.
+  //
+  [[nodiscard]] i64 get_hardware_concurrency();
+
+  // wait_on_address
+  // Blocks the calling thread while the value of address is equal to expected.
+  // The function may return spuriously, therefore the callers should recheck
+  // the condition in a loop.
+  //
+  void wait_on_address(Atomic<i32>& address, i32 expected);
+
+  // wake_one_on_address
+  // Wakes one of the threads blocked in wait_on_address on address.
+  //
+  void wake_one_on_address(Atomic<i32>& address);
+
+  // wake_all_on_address
+  // Wakes all threads blocked in wait_on_address on address.
+  //
+  void wake_all_on_address(Atomic<i32>& address);
+} // namespace anton
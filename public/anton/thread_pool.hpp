@@ -0,0 +1,186 @@
+#pragma once
+
+#include <anton/atomic.hpp>
+#include <anton/memory.hpp>
+#include <anton/ranges.hpp>
+#include <anton/type_traits.hpp>
+#include <anton/types.hpp>
+
+namespace anton {
+  struct Task_Group;
+
+  namespace detail {
+    struct Task {
+      void (*execute)(Task* task);
+      Task_Group* group;
+    };
+
+    template<typename Callable>
+    struct Callable_Task: public Task {
+      Callable callable;
+
+      template<typename F>
+      Callable_Task(Task_Group* const group, F&& f)
+        : Task{&Callable_Task::execute_callable, group}, callable(ANTON_FWD(f))
+      {
+      }
+
+      static void execute_callable(Task* const task)
+      {
+        Callable_Task* const self = static_cast<Callable_Task*>(task);
+        self->callable();
+        delete_obj(self);
+      }
+    };
+  } // namespace detail
+
+  // Task_Group
+  // Tracks the completion of a set of tasks spawned into a Thread_Pool. A task
+  // group must outlive all of the tasks spawned into it, i.e. it must be waited
+  // on before it is destroyed.
+  //
+  struct Task_Group {
+  public:
+    Task_Group() = default;
+    Task_Group(Task_Group const&) = delete;
+    Task_Group& operator=(Task_Group const&) = delete;
+
+    // is_done
+    //
+    // Returns:
+    // true if all tasks spawned into the group have finished.
+    //
+    [[nodiscard]] bool is_done() const
+    {
+      return _pending.load(Memory_Order::acquire) == 0;
+    }
+
+  private:
+    friend struct Thread_Pool;
+
+    Atomic<i64> _pending = 0;
+  };
+
+  // Thread_Pool
+  // A fixed set of worker threads executing tasks with work stealing. Every
+  // worker owns a Chase-Lev deque. Tasks spawned by a worker are pushed to the
+  // bottom of its own deque and popped in LIFO order, which keeps the working
+  // set hot in the worker's cache. Idle workers steal the oldest tasks from the
+  // top of the deques of the other workers. Tasks spawned from threads that do
+  // not belong to the pool are placed in a shared injection queue.
+  //
+  // Workers that cannot find any work go to sleep and are woken when new tasks
+  // are spawned.
+  //
+  struct Thread_Pool {
+  public:
+    // Thread_Pool
+    // Creates a pool with worker_count worker threads. The pool may have 0
+    // workers in which case all tasks are executed by the threads calling
+    // wait.
+    //
+    explicit Thread_Pool(i64 worker_count);
+    Thread_Pool(Thread_Pool const&) = delete;
+    Thread_Pool(Thread_Pool&&) = delete;
+    // ~Thread_Pool
+    // Stops the workers. Tasks that are still pending are executed on the
+    // destroying thread before the pool is destroyed, therefore their groups
+    // must still be alive.
+    //
+    ~Thread_Pool();
+    Thread_Pool& operator=(Thread_Pool const&) = delete;
+    Thread_Pool& operator=(Thread_Pool&&) = delete;
+
+    // spawn
+    // Schedules callable to be executed by the pool as a part of group.
+    //
+    // Parameters:
+    //    group - the group the task belongs to.
+    // callable - function object invocable with no arguments.
+    //
+    template<typename Callable>
+    void spawn(Task_Group& group, Callable&& callable)
+    {
+      using task_type = detail::Callable_Task<decay<Callable>>;
+      group._pending.fetch_add(1, Memory_Order::relaxed);
+      task_type* const task = new_obj<task_type>(&group, ANTON_FWD(callable));
+      submit(task);
+    }
+
+    // wait
+    // Blocks until all tasks of group have finished. The calling thread
+    // executes pending tasks of the pool while waiting.
+    //
+    void wait(Task_Group& group);
+
+    [[nodiscard]] i64 get_worker_count() const;
+
+  private:
+    struct Implementation;
+
+    Implementation* _impl;
+
+    void submit(detail::Task* task);
+  };
+
+  // get_default_thread_pool
+  // Obtains the process-wide thread pool. The pool is created on first use
+  // with one worker less than the number of logical processors, since the
+  // thread waiting on the tasks participates in their execution.
+  //
+  [[nodiscard]] Thread_Pool& get_default_thread_pool();
+
+  namespace detail {
+    template<typename Callable>
+    void parallel_for_split(Thread_Pool& pool, Task_Group& group, i64 first,
+                            i64 last, i64 const grain, Callable& callable)
+    {
+      // Split the range in halves leaving the upper halves to be stolen by
+      // other workers and process the last chunk locally.
+      while(last - first > grain) {
+        i64 const middle = first + (last - first) / 2;
+        pool.spawn(group, [&pool, &group, middle, last, grain, &callable]() {
+          parallel_for_split(pool, group, middle, last, grain, callable);
+        });
+        last = middle;
+      }
+
+      for(; first < last; ++first) {
+        callable(first);
+      }
+    }
+  } // namespace detail
+
+  // parallel_for
+  // Invokes callable for every index in range. The range is recursively split
+  // into chunks of at most grain indices that are executed in parallel by the
+  // pool. Returns after all invocations have finished.
+  //
+  // Parameters:
+  //     pool - the pool to execute the chunks in.
+  //    range - the range of indices, e.g. irange(0, n).
+  //    grain - the maximum number of indices processed by a single task. Must
+  //            be greater than 0.
+  // callable - function object with signature void(isize).
+  //
+  template<typename Callable>
+  void parallel_for(Thread_Pool& pool, Range<Enumerate_Iterator> range,
+                    i64 const grain, Callable&& callable)
+  {
+    Task_Group group;
+    detail::parallel_for_split(pool, group, *range.begin(), *range.end(),
+                               grain > 0 ? grain : 1, callable);
+    pool.wait(group);
+  }
+
+  // parallel_for
+  // Executes parallel_for in the default thread pool.
+  //
+  template<typename Callable>
+  void parallel_for(Range<Enumerate_Iterator> range, i64 const grain,
+                    Callable&& callable)
+  {
+    parallel_for(get_default_thread_pool(), range, grain,
+                 ANTON_FWD(callable));
+  }
+} // namespace anton
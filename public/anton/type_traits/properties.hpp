@@ -211,6 +211,15 @@ namespace anton {
   template<typename T>
   constexpr bool is_trivial = __is_trivial(T);
 
+  // Is_Trivially_Copyable
+  //
+  template<typename T>
+  struct Is_Trivially_Copyable
+    : public Bool_Constant<__is_trivially_copyable(T)> {};
+
+  template<typename T>
+  constexpr bool is_trivially_copyable = __is_trivially_copyable(T);
+
   // Is_Assignable
   //
   // Note: We assume that all compilers we use support __is_assignable,
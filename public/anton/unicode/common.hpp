@@ -3,6 +3,59 @@
 #include <anton/types.hpp>
 
 namespace anton::unicode {
+  // validate_utf8
+  // Checks whether a string is well-formed UTF-8, i.e. contains no overlong
+  // encodings, surrogates, code points above U+10FFFF or truncated sequences.
+  // Vectorized on processors supporting AVX2.
+  //
+  // Parameters:
+  // data - the string to validate.
+  // size - the number of bytes in data.
+  //
+  // Returns:
+  // true if data is well-formed UTF-8.
+  //
+  [[nodiscard]] bool validate_utf8(char8 const* data, i64 size);
+
+  // validate_utf16
+  // Checks whether a string is well-formed UTF-16, i.e. every high surrogate
+  // is followed by a low surrogate and every low surrogate is preceded by a
+  // high surrogate.
+  //
+  // Parameters:
+  //   data - the string to validate.
+  // length - the number of code units in data.
+  //
+  // Returns:
+  // true if data is well-formed UTF-16.
+  //
+  [[nodiscard]] bool validate_utf16(char16 const* data, i64 length);
+
+  // validate_utf32
+  // Checks whether a string is well-formed UTF-32, i.e. contains no
+  // surrogates and no code points above U+10FFFF.
+  //
+  // Parameters:
+  //   data - the string to validate.
+  // length - the number of code units in data.
+  //
+  // Returns:
+  // true if data is well-formed UTF-32.
+  //
+  [[nodiscard]] bool validate_utf32(char32 const* data, i64 length);
+
+  // validate_ascii
+  // Checks whether a string contains only ASCII characters.
+  //
+  // Parameters:
+  // data - the string to validate.
+  // size - the number of bytes in data.
+  //
+  // Returns:
+  // true if no byte of data has the most significant bit set.
+  //
+  [[nodiscard]] bool validate_ascii(char8 const* data, i64 size);
+
   // get_byte_count_from_utf8_leading_byte
   // Calculates the number of bytes in a UTF-8 encoded codepoint from the
   // leading byte of the sequence.
@@ -12,6 +65,114 @@ namespace anton::unicode {
   //
   i64 get_byte_count_from_utf8_leading_byte(char8 leading_byte);
 
+  // get_utf16_length_from_utf8
+  // Counts the code units required to encode a UTF-8 string in UTF-16.
+  // Vectorized on x86.
+  //
+  // Parameters:
+  // data - well-formed UTF-8 string.
+  // size - the number of bytes in data.
+  //
+  // Returns:
+  // The number of UTF-16 code units.
+  //
+  [[nodiscard]] i64 get_utf16_length_from_utf8(char8 const* data, i64 size);
+
+  // get_utf32_length_from_utf8
+  // Counts the code points of a UTF-8 string, i.e. the bytes that are not
+  // continuation bytes. Vectorized on x86 with AVX2 when it is supported.
+  //
+  // Parameters:
+  // data - well-formed UTF-8 string.
+  // size - the number of bytes in data.
+  //
+  // Returns:
+  // The number of UTF-32 code units.
+  //
+  [[nodiscard]] i64 get_utf32_length_from_utf8(char8 const* data, i64 size);
+
+  // get_utf8_size_from_utf16
+  // Counts the bytes required to encode a UTF-16 string in UTF-8. Unpaired
+  // surrogates count as U+FFFD, matching transcode_utf16_to_utf8. Vectorized
+  // on x86.
+  //
+  // Parameters:
+  //   data - UTF-16 string.
+  // length - the number of code units in data.
+  //
+  // Returns:
+  // The number of UTF-8 bytes.
+  //
+  [[nodiscard]] i64 get_utf8_size_from_utf16(char16 const* data, i64 length);
+
+  // get_utf8_size_from_utf32
+  // Counts the bytes required to encode a UTF-32 string in UTF-8. Vectorized
+  // on x86.
+  //
+  // Parameters:
+  //   data - well-formed UTF-32 string.
+  // length - the number of code units in data.
+  //
+  // Returns:
+  // The number of UTF-8 bytes.
+  //
+  [[nodiscard]] i64 get_utf8_size_from_utf32(char32 const* data, i64 length);
+
+  // Transcode_Result
+  // The progress of a transcode function, both counts in the code units of
+  // the respective encodings.
+  //
+  struct Transcode_Result {
+    // The number of code units of the source that have been converted.
+    i64 read;
+    // The number of code units written to the destination.
+    i64 written;
+  };
+
+  // transcode_utf8_to_utf16, transcode_utf8_to_utf32,
+  // transcode_utf16_to_utf8, transcode_utf32_to_utf8
+  // Convert a string to another encoding in a single pass without measuring
+  // it first. Whole code points are converted until the source is exhausted
+  // or the next code point does not fit in the destination. A UTF-8 code
+  // point cut short by the end of the source is not converted, which allows
+  // converting a stream in chunks. Unpaired UTF-16 surrogates, including a
+  // high surrogate at the end of the source, are converted to U+FFFD. Runs
+  // of ASCII characters are converted 16 or 32 at a time on x86.
+  //
+  // A destination of 1 code unit per byte of UTF-8, 3 bytes per UTF-16 code
+  // unit or 4 bytes per UTF-32 code unit always fits the whole source.
+  //
+  // Parameters:
+  //      source - the string to convert.
+  //      length - the number of code units in source.
+  // destination - the buffer to write the converted code units to. Only the
+  //               first written code units are modified.
+  //    capacity - the number of code units that fit in destination.
+  //
+  // Returns:
+  // The number of code units read from source and written to destination.
+  // The whole string has been converted when read equals length.
+  //
+  // Exceptions:
+  // If source is not well-formed, the behaviour is undefined.
+  //
+  [[nodiscard]] Transcode_Result transcode_utf8_to_utf16(char8 const* source,
+                                                         i64 length,
+                                                         char16* destination,
+                                                         i64 capacity);
+  [[nodiscard]] Transcode_Result transcode_utf8_to_utf32(char8 const* source,
+                                                         i64 length,
+                                                         char32* destination,
+                                                         i64 capacity);
+  [[nodiscard]] Transcode_Result transcode_utf16_to_utf8(char16 const* source,
+                                                         i64 length,
+                                                         char8* destination,
+                                                         i64 capacity);
+  [[nodiscard]] Transcode_Result transcode_utf32_to_utf8(char32 const* source,
+                                                         i64 length,
+                                                         char8* destination,
+                                                         i64 capacity);
+
   // convert_utf32_to_utf8
   // Converts a UTF-32 encoded string contained in buffer_utf32 to a UTF-8
   // encoded string and writes it to buffer_utf8.
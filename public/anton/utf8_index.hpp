@@ -0,0 +1,112 @@
+#pragma once
+
+#include <anton/allocator.hpp>
+#include <anton/array.hpp>
+#include <anton/detail/string8_common.hpp>
+#include <anton/string_view.hpp>
+#include <anton/types.hpp>
+
+namespace anton {
+  // UTF8_Index
+  // A side index of a UTF-8 string that maps code point positions to byte
+  // offsets. The index stores the byte offset of every stride-th code point,
+  // so locating a code point decodes at most stride - 1 code points past the
+  // closest checkpoint. Accessing long strings by code point positions takes
+  // constant time for a fixed stride instead of time linear in the position.
+  //
+  // The index refers to the bytes of the string it has been built from and
+  // must be rebuilt whenever the string is modified or reallocated.
+  //
+  struct UTF8_Index {
+  public:
+    using allocator_type = Polymorphic_Allocator;
+    using size_type = i64;
+
+    // The number of code points between the checkpoints by default.
+    static constexpr i64 default_stride = 64;
+
+    UTF8_Index();
+    explicit UTF8_Index(allocator_type const& allocator);
+    // UTF8_Index
+    // Builds the index of string.
+    //
+    // Parameters:
+    // string - well-formed UTF-8 string.
+    // stride - the number of code points between the checkpoints. Must be
+    //          greater than 0.
+    //
+    // Complexity: O(n) in the number of bytes of string.
+    //
+    explicit UTF8_Index(String_View string, i64 stride = default_stride);
+    UTF8_Index(allocator_type const& allocator, String_View string,
+               i64 stride = default_stride);
+
+    // size_utf8
+    // The number of code points in the string.
+    //
+    [[nodiscard]] size_type size_utf8() const;
+
+    // get_string
+    // The string the index has been built from.
+    //
+    [[nodiscard]] String_View get_string() const;
+
+    // get_byte_offset
+    // Locates a code point by its position.
+    //
+    // Parameters:
+    // index - the position of the code point in [0, size_utf8()]. The
+    //         position size_utf8() corresponds to the end of the string.
+    //
+    // Returns:
+    // The offset of the first byte of the code point from the beginning of
+    // the string.
+    //
+    // Complexity: O(stride).
+    //
+    [[nodiscard]] i64 get_byte_offset(i64 index) const;
+
+    // get_char_iterator
+    //
+    // Returns:
+    // An iterator pointing to the code point at position index in
+    // [0, size_utf8()].
+    //
+    // Complexity: O(stride).
+    //
+    [[nodiscard]] UTF8_Char_Iterator get_char_iterator(i64 index) const;
+
+    // char_at
+    //
+    // Returns:
+    // The code point at position index in [0, size_utf8()[.
+    //
+    // Complexity: O(stride).
+    //
+    [[nodiscard]] char32 char_at(i64 index) const;
+
+    // substring
+    //
+    // Returns:
+    // The code points at the positions [first, last[ of the string.
+    //
+    // Complexity: O(stride).
+    //
+    [[nodiscard]] String_View substring(i64 first, i64 last) const;
+
+    [[nodiscard]] allocator_type& get_allocator();
+    [[nodiscard]] allocator_type const& get_allocator() const;
+
+    friend void swap(UTF8_Index& lhs, UTF8_Index& rhs);
+
+  private:
+    String_View _string;
+    // The byte offsets of the code points at the positions 0, stride,
+    // 2 * stride, ... up to size_utf8.
+    Array<i64> _checkpoints;
+    i64 _size_utf8 = 0;
+    i64 _stride = default_stride;
+
+    void build();
+  };
+} // namespace anton